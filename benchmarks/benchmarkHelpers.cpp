@@ -0,0 +1,91 @@
+#include "benchmarkHelpers.hpp"
+
+#include "builtinFunctions.hpp"
+#include "includeExecution.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "streamReader.hpp"
+
+#include <format>
+#include <sstream>
+#include <stdexcept>
+
+const std::vector<unsigned> GENERATED_PROGRAM_SIZES = {10, 100, 1000};
+
+namespace {
+std::wstring generateFunction(unsigned index)
+{
+    std::wstring function = std::format(
+        L"struct Record{0} {{\n"
+        L"    int count;\n"
+        L"    float ratio;\n"
+        L"    str label;\n"
+        L"}}\n"
+        L"\n"
+        L"variant Value{0} {{\n"
+        L"    int number;\n"
+        L"    str text;\n"
+        L"}}\n"
+        L"\n"
+        L"# function number {0}\n"
+        L"func compute{0}(int n, str label) -> int {{\n"
+        L"    int$ sum = 0;\n"
+        L"    int$ step = 0;\n"
+        L"    Record{0} record = {{n, 1.5, label}};\n"
+        L"    Value{0}$ value = n;\n"
+        L"    while(step < n) {{\n"
+        L"        if(step % 3 == 0 and record.count > 2) {{\n"
+        L"            sum = sum + record.count * 2;\n"
+        L"        }}\n"
+        L"        elif(int number = value) {{\n"
+        L"            sum = sum + number;\n"
+        L"        }}\n"
+        L"        else {{\n"
+        L"            sum = sum - 1;\n"
+        L"        }}\n"
+        L"        step = step + 1;\n"
+        L"    }}\n"
+        L"    value = label ! \" \" ! sum;\n",
+        index
+    );
+    if(index > 0)
+        function += std::format(L"    sum = sum + compute{}(n // 2, record.label);\n", index - 1);
+    return function + L"    return sum;\n}\n\n";
+}
+}
+
+std::wstring generateProgram(unsigned functions)
+{
+    std::wstring program;
+    for(unsigned i = 0; i < functions; i++)
+        program += generateFunction(i);
+    return program + std::format(L"func main() {{\n    println(compute{}(10, \"label\"));\n}}\n", functions - 1);
+}
+
+Program parseSource(const std::wstring &source, Parser::BodyMode bodyMode)
+{
+    std::wstringstream sourceStream(source);
+    StreamReader reader(sourceStream, L"<benchmark>");
+    Lexer lexer(reader, Lexer::CommentMode::SKIP);
+    Parser parser(lexer, bodyMode);
+    return parser.parseProgram();
+}
+
+std::vector<Program> parseSources(const std::wstring &source, unsigned count)
+{
+    std::vector<Program> programs;
+    for(unsigned i = 0; i < count; i++)
+        programs.push_back(parseSource(source));
+    return programs;
+}
+
+void addBuiltinFunctions(Program &program)
+{
+    Program builtins = prepareBuiltinFunctions(program.getPosition());
+    mergePrograms(program, builtins);
+}
+
+Program parseFromFile(const std::wstring &)
+{
+    throw std::runtime_error("No files should be included in benchmarks");
+}
@@ -0,0 +1,23 @@
+#ifndef BENCHMARKHELPERS_HPP
+#define BENCHMARKHELPERS_HPP
+
+#include "documentTree.hpp"
+#include "parser.hpp"
+
+#include <string>
+#include <vector>
+
+// Sizes, in numbers of functions, of the generated programs used in frontend benchmarks.
+extern const std::vector<unsigned> GENERATED_PROGRAM_SIZES;
+
+// Generates a valid program with the given number of functions, using most of the language's constructs.
+std::wstring generateProgram(unsigned functions);
+Program parseSource(const std::wstring &source, Parser::BodyMode bodyMode = Parser::BodyMode::PARSE);
+// Parses the source the given number of times, so that every benchmark run gets its own document tree.
+std::vector<Program> parseSources(const std::wstring &source, unsigned count);
+// Merges builtin functions into the program, like the Interpreter does before semantic analysis.
+void addBuiltinFunctions(Program &program);
+// Passed to the Interpreter; benchmarked programs do not include any files.
+Program parseFromFile(const std::wstring &fileName);
+
+#endif
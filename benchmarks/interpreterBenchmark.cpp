@@ -0,0 +1,209 @@
+#include "benchmarkHelpers.hpp"
+#include "compiledProgram.hpp"
+#include "execution.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+
+namespace {
+const std::wstring ARITHMETIC_LOOP = L"func main() {\n"
+                                     L"    int$ i = 0;\n"
+                                     L"    int$ sum = 0;\n"
+                                     L"    while(i < 10000) {\n"
+                                     L"        sum = (sum + i * 3 - 1) % 1000;\n"
+                                     L"        i = i + 1;\n"
+                                     L"    }\n"
+                                     L"    println(sum);\n"
+                                     L"}\n";
+
+const std::wstring FIBONACCI = L"func fib(int n) -> int {\n"
+                               L"    if(n < 2) {\n"
+                               L"        return n;\n"
+                               L"    }\n"
+                               L"    return fib(n - 1) + fib(n - 2);\n"
+                               L"}\n";
+
+void benchmarkProgram(const std::string &name, const std::wstring &source, ExecutionLimits limits = {})
+{
+    // the program is compiled once, so that only its execution is measured
+    CompiledProgram program(parseSource(source), {L"<benchmark>"}, parseFromFile);
+    BENCHMARK(name)
+    {
+        std::wstringstream input, output;
+        Execution execution(
+            program, {}, input, output, Interpreter::DEFAULT_MAX_STACK_SIZE, nullptr, nullptr, nullptr, limits
+        );
+        execution.run();
+    };
+}
+}
+
+TEST_CASE("Interpreter workloads", "[Interpreter][!benchmark]")
+{
+    benchmarkProgram("arithmetic loop", ARITHMETIC_LOOP);
+    // the budgets are set high enough not to be exceeded, to measure the cost of counting and checking them
+    benchmarkProgram(
+        "arithmetic loop with execution limits", ARITHMETIC_LOOP,
+        {1'000'000'000, std::chrono::seconds(60), size_t(1) << 30}
+    );
+    benchmarkProgram(
+        "recursive factorial",
+        L"func factorial(int n) -> int {\n"
+        L"    if(n == 0 or n == 1) {\n"
+        L"        return 1;\n"
+        L"    }\n"
+        L"    return n * factorial(n - 1);\n"
+        L"}\n"
+        L"func main() {\n"
+        L"    int$ i = 0;\n"
+        L"    while(i < 100) {\n"
+        L"        int result = factorial(12);\n"
+        L"        i = i + 1;\n"
+        L"    }\n"
+        L"}\n"
+    );
+    benchmarkProgram(
+        "string building",
+        L"func main() {\n"
+        L"    str$ text = \"\";\n"
+        L"    int$ i = 0;\n"
+        L"    while(i < 1000) {\n"
+        L"        text = text ! i ! \",\";\n"
+        L"        i = i + 1;\n"
+        L"    }\n"
+        L"    println(len(text));\n"
+        L"}\n"
+    );
+    benchmarkProgram(
+        "struct and variant traffic",
+        L"struct Point {\n"
+        L"    int x;\n"
+        L"    int y;\n"
+        L"}\n"
+        L"variant Shape {\n"
+        L"    Point point;\n"
+        L"    int radius;\n"
+        L"}\n"
+        L"func area(Point point) -> int {\n"
+        L"    return point.x * point.y;\n"
+        L"}\n"
+        L"func area(int radius) -> int {\n"
+        L"    return 3 * radius * radius;\n"
+        L"}\n"
+        L"func main() {\n"
+        L"    int$ i = 0;\n"
+        L"    int$ total = 0;\n"
+        L"    Shape$ shape = 1;\n"
+        L"    while(i < 1000) {\n"
+        L"        if(i % 2 == 0) {\n"
+        L"            Point point = {i, 2};\n"
+        L"            shape = point;\n"
+        L"        }\n"
+        L"        else {\n"
+        L"            shape = i % 100;\n"
+        L"        }\n"
+        L"        total = total + area(shape);\n"
+        L"        i = i + 1;\n"
+        L"    }\n"
+        L"    println(total);\n"
+        L"}\n"
+    );
+    benchmarkProgram(
+        "array sieve",
+        L"func main() {\n"
+        L"    [bool]$ composite = {};\n"
+        L"    int$ i = 0;\n"
+        L"    while(i < 5000) {\n"
+        L"        append(composite, false);\n"
+        L"        i = i + 1;\n"
+        L"    }\n"
+        L"    int$ primes = 0;\n"
+        L"    i = 2;\n"
+        L"    while(i < 5000) {\n"
+        L"        if(not composite[i]) {\n"
+        L"            primes = primes + 1;\n"
+        L"            int$ multiple = i * i;\n"
+        L"            while(multiple < 5000) {\n"
+        L"                composite[multiple] = true;\n"
+        L"                multiple = multiple + i;\n"
+        L"            }\n"
+        L"        }\n"
+        L"        i = i + 1;\n"
+        L"    }\n"
+        L"    println(primes);\n"
+        L"}\n"
+    );
+    benchmarkProgram(
+        "string tokenizing",
+        L"func main() {\n"
+        L"    str line = \"alpha, beta , gamma,delta , epsilon\" @ 200;\n"
+        L"    int$ letters = 0;\n"
+        L"    int$ i = 0;\n"
+        L"    while(i < len(line)) {\n"
+        L"        if(line[i] != \" \" and line[i] != \",\") {\n"
+        L"            letters = letters + 1;\n"
+        L"        }\n"
+        L"        i = i + 1;\n"
+        L"    }\n"
+        L"    [str] fields = split(line, \",\");\n"
+        L"    int$ total = 0;\n"
+        L"    i = 0;\n"
+        L"    while(i < len(fields)) {\n"
+        L"        total = total + len(trim(fields[i]));\n"
+        L"        i = i + 1;\n"
+        L"    }\n"
+        L"    println(letters ! \" \" ! total);\n"
+        L"}\n"
+    );
+    benchmarkProgram(
+        "dictionary join",
+        L"func main() {\n"
+        L"    [int -> str]$ names = {};\n"
+        L"    int$ i = 0;\n"
+        L"    while(i < 3000) {\n"
+        L"        names[i * 7] = \"n\" ! i;\n"
+        L"        i = i + 1;\n"
+        L"    }\n"
+        L"    int$ matched = 0;\n"
+        L"    i = 0;\n"
+        L"    while(i < 6000) {\n"
+        L"        if(contains(names, i * 3)) {\n"
+        L"            matched = matched + len(names[i * 3]);\n"
+        L"        }\n"
+        L"        i = i + 1;\n"
+        L"    }\n"
+        L"    println(matched);\n"
+        L"}\n"
+    );
+    // the same calls run sequentially and as tasks, which scale with the number of hardware threads
+    benchmarkProgram(
+        "fibonacci calls", FIBONACCI + L"func main() {\n"
+                                       L"    int$ sum = 0;\n"
+                                       L"    int$ i = 0;\n"
+                                       L"    while(i < 8) {\n"
+                                       L"        sum = sum + fib(16);\n"
+                                       L"        i = i + 1;\n"
+                                       L"    }\n"
+                                       L"    println(sum);\n"
+                                       L"}\n"
+    );
+    benchmarkProgram(
+        "spawned fibonacci calls", FIBONACCI + L"func main() {\n"
+                                               L"    [task<int>]$ tasks = {};\n"
+                                               L"    int$ i = 0;\n"
+                                               L"    while(i < 8) {\n"
+                                               L"        append(tasks, spawn fib(16));\n"
+                                               L"        i = i + 1;\n"
+                                               L"    }\n"
+                                               L"    int$ sum = 0;\n"
+                                               L"    i = 0;\n"
+                                               L"    while(i < 8) {\n"
+                                               L"        sum = sum + join(tasks[i]);\n"
+                                               L"        i = i + 1;\n"
+                                               L"    }\n"
+                                               L"    println(sum);\n"
+                                               L"}\n"
+    );
+}
@@ -0,0 +1,97 @@
+#include "benchmarkHelpers.hpp"
+#include "commentDiscarder.hpp"
+#include "lexer.hpp"
+#include "streamReader.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <format>
+#include <sstream>
+
+namespace {
+unsigned lexAll(const std::wstring &source)
+{
+    std::wstringstream sourceStream(source);
+    StreamReader reader(sourceStream, L"<benchmark>");
+    Lexer lexer(reader);
+    unsigned tokens = 1;
+    while(lexer.getNextToken().getType() != TokenType::EOT)
+        tokens++;
+    return tokens;
+}
+
+unsigned readAllInBatches(ILexer &lexer)
+{
+    TokenBatch batch;
+    unsigned tokens = 0;
+    do
+    {
+        batch.clear();
+        lexer.readTokens(batch);
+        tokens += batch.size();
+    }
+    while(batch.back().getType() != TokenType::EOT);
+    return tokens;
+}
+
+unsigned lexAllInBatches(const std::wstring &source, Lexer::CommentMode commentMode = Lexer::CommentMode::EMIT)
+{
+    std::wstringstream sourceStream(source);
+    StreamReader reader(sourceStream, L"<benchmark>");
+    Lexer lexer(reader, commentMode);
+    return readAllInBatches(lexer);
+}
+
+unsigned lexAllDiscardingComments(const std::wstring &source)
+{
+    std::wstringstream sourceStream(source);
+    StreamReader reader(sourceStream, L"<benchmark>");
+    Lexer lexer(reader);
+    CommentDiscarder commentDiscarder(lexer);
+    return readAllInBatches(commentDiscarder);
+}
+
+// Follows every line of the source with a comment line, like in heavily annotated generated code.
+std::wstring annotate(const std::wstring &source)
+{
+    std::wstringstream lines(source);
+    std::wstring annotated;
+    for(std::wstring line; std::getline(lines, line);)
+        annotated += line + L"\n# generated from the record schema, see the generator for the meaning of fields\n";
+    return annotated;
+}
+}
+
+TEST_CASE("Lexer token throughput", "[Lexer][!benchmark]")
+{
+    for(unsigned size: GENERATED_PROGRAM_SIZES)
+    {
+        std::wstring source = generateProgram(size);
+        // the number of tokens is given in the name, so that tokens per second can be calculated from the result
+        BENCHMARK(std::format("lex {} tokens", lexAll(source)))
+        {
+            return lexAll(source);
+        };
+        BENCHMARK(std::format("lex {} tokens in batches", lexAllInBatches(source)))
+        {
+            return lexAllInBatches(source);
+        };
+    }
+}
+
+TEST_CASE("Lexer on annotated sources", "[Lexer][!benchmark]")
+{
+    for(unsigned size: GENERATED_PROGRAM_SIZES)
+    {
+        std::wstring source = annotate(generateProgram(size));
+        BENCHMARK(std::format("lex {} functions discarding comment tokens", size))
+        {
+            return lexAllDiscardingComments(source);
+        };
+        BENCHMARK(std::format("lex {} functions skipping comments", size))
+        {
+            return lexAllInBatches(source, Lexer::CommentMode::SKIP);
+        };
+    }
+}
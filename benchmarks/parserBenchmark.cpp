@@ -0,0 +1,94 @@
+#include "benchmarkHelpers.hpp"
+#include "commentDiscarder.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "streamReader.hpp"
+#include "tokenBuffer.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <format>
+#include <sstream>
+
+namespace {
+void benchmarkParsing(
+    const std::string &name, const std::wstring &source, Parser::BodyMode bodyMode = Parser::BodyMode::PARSE
+)
+{
+    std::wstringstream sourceStream(source);
+    StreamReader reader(sourceStream, L"<benchmark>");
+    Lexer lexer(reader);
+    CommentDiscarder commentDiscarder(lexer);
+    TokenBuffer tokens(commentDiscarder);
+    // tokens are read ahead, so that only parsing is measured
+    BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<TokenBuffer> buffers(meter.runs(), tokens);
+        meter.measure([&](int run) { return Parser(buffers[run], bodyMode).parseProgram(); });
+    };
+}
+
+// Generates functions made of declarations initialized with long expressions, using every operator.
+std::wstring generateExpressions(unsigned functions)
+{
+    std::wstring program;
+    for(unsigned i = 0; i < functions; i++)
+    {
+        program += std::format(L"func expressions{}(int a, int b, str s, [int] values) {{\n", i);
+        for(unsigned j = 0; j < 10; j++)
+        {
+            program += std::format(
+                L"    bool condition{0} = (a + b * {0} - values[{0}] // 2) % 7 ** 2 == -{0} or not (a < b) and "
+                L"s ! \"x\" @ 3 != \"y\" xor a / 2 >= b - {0} and values.field[a] is int;\n"
+                L"    int$ value{0} = ((a * b + {0}) * (a - b) + ({0} - a) * -b) // (1 + a % 3);\n",
+                j
+            );
+        }
+        program += L"}\n";
+    }
+    return program;
+}
+}
+
+TEST_CASE("Parser on generated programs", "[Parser][!benchmark]")
+{
+    for(unsigned size: GENERATED_PROGRAM_SIZES)
+        benchmarkParsing(std::format("parse {} functions", size), generateProgram(size));
+}
+
+TEST_CASE("Parser on expression-dense code", "[Parser][!benchmark]")
+{
+    for(unsigned size: GENERATED_PROGRAM_SIZES)
+        benchmarkParsing(std::format("parse {} expression-dense functions", size), generateExpressions(size));
+}
+
+TEST_CASE("Parser skipping function bodies", "[Parser][!benchmark]")
+{
+    for(unsigned size: GENERATED_PROGRAM_SIZES)
+    {
+        benchmarkParsing(
+            std::format("skip bodies of {} functions", size), generateProgram(size), Parser::BodyMode::SKIP
+        );
+        benchmarkParsing(
+            std::format("skip bodies of {} expression-dense functions", size), generateExpressions(size),
+            Parser::BodyMode::SKIP
+        );
+    }
+}
+
+TEST_CASE("Lexer and Parser on generated programs", "[Parser][!benchmark]")
+{
+    for(unsigned size: GENERATED_PROGRAM_SIZES)
+    {
+        std::wstring source = generateProgram(size);
+        BENCHMARK(std::format("lex and parse {} functions", size))
+        {
+            std::wstringstream sourceStream(source);
+            StreamReader reader(sourceStream, L"<benchmark>");
+            Lexer lexer(reader);
+            CommentDiscarder commentDiscarder(lexer);
+            return Parser(commentDiscarder).parseProgram();
+        };
+    }
+}
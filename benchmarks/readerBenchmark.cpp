@@ -0,0 +1,56 @@
+#include "benchmarkHelpers.hpp"
+#include "streamReader.hpp"
+#include "stringKernels.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <format>
+#include <sstream>
+
+TEST_CASE("StreamReader character throughput", "[StreamReader][!benchmark]")
+{
+    std::wstring source = generateProgram(GENERATED_PROGRAM_SIZES.back());
+    BENCHMARK_ADVANCED(std::format("read {} characters", source.size()))(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<std::wstringstream> streams;
+        for(int i = 0; i < meter.runs(); i++)
+            streams.emplace_back(source);
+        meter.measure([&](int run) {
+            StreamReader reader(streams[run], L"<benchmark>");
+            unsigned characters = 0;
+            while(reader.next().first != IReader::EOT)
+                characters++;
+            return characters;
+        });
+    };
+}
+
+TEST_CASE("StringKernels throughput", "[StringKernels][!benchmark]")
+{
+    std::wstring source = generateProgram(GENERATED_PROGRAM_SIZES.back());
+    std::string bytes(source.begin(), source.end());
+    std::string copy = bytes;
+    for(StringKernels::Level level: StringKernels::getSupportedLevels())
+    {
+        const StringKernels &kernels = StringKernels::get(level);
+        std::string levelName = level == StringKernels::Level::SCALAR ? "scalar"
+                                : level == StringKernels::Level::SSE2 ? "SSE2"
+                                                                      : "AVX2";
+        BENCHMARK(std::format("{} scan of {} characters", levelName, source.size()))
+        {
+            size_t found = 0;
+            for(size_t position = 0; position < source.size(); position++, found++)
+                position += kernels.findNonPrintableAscii(source.data() + position, source.size() - position);
+            return found;
+        };
+        BENCHMARK(std::format("{} count of {} bytes", levelName, bytes.size()))
+        {
+            return kernels.countCodePoints(bytes.data(), bytes.size());
+        };
+        BENCHMARK(std::format("{} comparison of {} bytes", levelName, bytes.size()))
+        {
+            return kernels.findMismatch(bytes.data(), copy.data(), bytes.size());
+        };
+    }
+}
@@ -0,0 +1,97 @@
+#include "benchmarkHelpers.hpp"
+#include "semanticAnalysis.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <format>
+
+namespace {
+// Generates functions made of if statements nested to the given depth, each declaring variables and reading the
+// variables of all the enclosing blocks.
+std::wstring generateNestedBlocks(unsigned functions, unsigned depth)
+{
+    std::wstring program;
+    for(unsigned i = 0; i < functions; i++)
+    {
+        program += std::format(L"func nested{}(int n) -> int {{\n    int$ sum = n;\n", i);
+        std::wstring indent = L"    ";
+        for(unsigned level = 0; level < depth; level++)
+        {
+            program += std::format(L"{}if(sum > {}) {{\n", indent, level);
+            indent += L"    ";
+            for(unsigned variable = 0; variable < 4; variable++)
+                program += std::format(L"{}int v{}_{} = sum + {};\n", indent, level, variable, variable);
+            program += std::format(L"{}sum = sum + v{}_0", indent, level);
+            for(unsigned outer = 0; outer < level; outer += 4)
+                program += std::format(L" - v{}_{}", outer, outer % 4);
+            program += L";\n";
+        }
+        for(unsigned level = depth; level > 0; level--)
+        {
+            indent.resize(indent.size() - 4);
+            program += indent + L"}\n";
+        }
+        program += L"    return sum;\n}\n";
+    }
+    return program + L"func main() {}\n";
+}
+}
+
+TEST_CASE("doSemanticAnalysis on generated programs", "[doSemanticAnalysis][!benchmark]")
+{
+    for(unsigned size: GENERATED_PROGRAM_SIZES)
+    {
+        std::wstring source = generateProgram(size);
+        BENCHMARK_ADVANCED(std::format("analyze {} functions", size))(Catch::Benchmark::Chronometer meter)
+        {
+            // analysis modifies the document tree, so every run gets a fresh one
+            std::vector<Program> programs = parseSources(source, meter.runs());
+            for(Program &program: programs)
+                addBuiltinFunctions(program);
+            meter.measure([&](int run) { doSemanticAnalysis(programs[run]); });
+        };
+    }
+}
+
+TEST_CASE("doSemanticAnalysis on deeply nested blocks", "[doSemanticAnalysis][!benchmark]")
+{
+    for(unsigned depth: {8, 32, 128})
+    {
+        std::wstring source = generateNestedBlocks(10, depth);
+        BENCHMARK_ADVANCED(std::format("analyze 10 functions nested {} blocks deep", depth))(
+            Catch::Benchmark::Chronometer meter
+        )
+        {
+            std::vector<Program> programs = parseSources(source, meter.runs());
+            for(Program &program: programs)
+                addBuiltinFunctions(program);
+            meter.measure([&](int run) { doSemanticAnalysis(programs[run]); });
+        };
+    }
+}
+
+TEST_CASE("loading a library used by few functions", "[doSemanticAnalysis][!benchmark]")
+{
+    for(unsigned size: GENERATED_PROGRAM_SIZES)
+    {
+        // main calls only the first functions of the generated library
+        std::wstring source = generateProgram(size);
+        source = source.substr(0, source.rfind(L"func main()")) +
+                 L"func main() {\n    println(compute1(10, \"a\"));\n}\n";
+        BENCHMARK(std::format("load and analyze all {} functions", size))
+        {
+            Program program = parseSource(source);
+            addBuiltinFunctions(program);
+            doSemanticAnalysis(program);
+            return program.functions.size();
+        };
+        BENCHMARK(std::format("load lazily and analyze functions reachable among {}", size))
+        {
+            Program program = parseSource(source, Parser::BodyMode::SKIP);
+            addBuiltinFunctions(program);
+            doReachableSemanticAnalysis(program);
+            return program.functions.size();
+        };
+    }
+}
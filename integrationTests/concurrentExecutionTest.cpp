@@ -0,0 +1,110 @@
+#include "commentDiscarder.hpp"
+#include "compiledProgram.hpp"
+#include "convertToString.hpp"
+#include "execution.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "runtimeExceptions.hpp"
+#include "streamReader.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+const unsigned THREADS = 16;
+const unsigned EXECUTIONS = 480;
+const std::string RUNTIME_ERROR = "The program was terminated following a runtime error:\n";
+
+Program parseFromFile(const std::wstring &fileName)
+{
+    std::wifstream fileStream(convertToString(fileName));
+    REQUIRE(fileStream.is_open());
+    StreamReader reader(fileStream, fileName);
+    Lexer lexer(reader);
+    CommentDiscarder commentDiscarder(lexer);
+    Parser parser(commentDiscarder);
+    return parser.parseProgram();
+}
+
+std::wstring readFile(const std::wstring &fileName)
+{
+    std::wifstream fileStream(convertToString(fileName));
+    std::wstringstream contents;
+    contents << fileStream.rdbuf();
+    return contents.str();
+}
+
+struct ExecutionCase
+{
+    const CompiledProgram &program;
+    std::vector<std::wstring> arguments;
+    std::wstring input;
+    std::string expected;
+};
+
+// Returns the standard output of the program, or the message of the runtime error that terminated it.
+std::string execute(const ExecutionCase &executionCase)
+{
+    std::wstringstream input(executionCase.input), output;
+    try
+    {
+        Execution(executionCase.program, executionCase.arguments, input, output).run();
+    }
+    catch(const RuntimeError &e)
+    {
+        return e.what();
+    }
+    return convertToString(output.str());
+}
+}
+
+TEST_CASE("concurrent executions of shared compiled programs", "[IntegrationTests]")
+{
+    // the compiled programs are parsed, included and analyzed once, before any thread starts
+    CompiledProgram factorial({L"factorialTest/factorialUse.txt"}, parseFromFile);
+    CompiledProgram lineNumberAdder({L"stdinTest/lineNumberAdder.txt"}, parseFromFile);
+    CompiledProgram types({L"typesTest/main.txt"}, parseFromFile);
+    std::wstring lines = readFile(L"stdinTest/input.txt");
+    std::vector<ExecutionCase> cases = {
+        {factorial, {L"3"}, L"", "6\n"},
+        {factorial, {L"10"}, L"", "3628800\n"},
+        {factorial, {}, L"", "no argument given\n"},
+        {factorial,
+         {L"-1"},
+         L"",
+         RUNTIME_ERROR + "Recursion limit exceeded\n"
+                         "while executing file factorialTest/factorial.txt\n"
+                         "at line 6, column 20."},
+        {factorial,
+         {L"abc"},
+         L"",
+         RUNTIME_ERROR + "Conversion of string abc to integer failed\n"
+                         "while executing file factorialTest/factorialUse.txt\n"
+                         "at line 8, column 23."},
+        {lineNumberAdder, {}, lines, "1 first line\n2 second line\n3 third line\n"},
+        {lineNumberAdder, {L"a"}, lines, "a1 first line\na2 second line\na3 third line\n"},
+        {types, {}, L"", "An integer: 23\nA string: 'heeello!'\nAn integer: 22\nA string: 'not hello >:('\n"},
+    };
+    for(const ExecutionCase &executionCase: cases)
+        REQUIRE(execute(executionCase) == executionCase.expected);
+
+    std::vector<std::string> results(EXECUTIONS);
+    std::atomic<unsigned> nextExecution = 0;
+    {
+        std::vector<std::jthread> threads;
+        for(unsigned i = 0; i < THREADS; i++)
+        {
+            threads.emplace_back([&] {
+                for(unsigned execution = nextExecution++; execution < EXECUTIONS; execution = nextExecution++)
+                    results[execution] = execute(cases[execution % cases.size()]);
+            });
+        }
+    }
+    for(unsigned execution = 0; execution < EXECUTIONS; execution++)
+        REQUIRE(results[execution] == cases[execution % cases.size()].expected);
+}
@@ -136,6 +136,29 @@ TEST_CASE("structs and variants program", "[IntegrationTests]")
     );
 }
 
+TEST_CASE("factorial program in batch mode", "[IntegrationTests]")
+{
+    checkOutputFromArgs(
+        "factorialTest/factorialUse.txt --batch batchTest/records.txt --jobs 2", "6\nno argument given\n3628800\n",
+        "Batch record 3:\n"
+        "The program was terminated following a runtime error:\n"
+        "Recursion limit exceeded\n"
+        "while executing file factorialTest/factorial.txt\n"
+        "at line 6, column 20.\n"
+        "Batch record 5:\n"
+        "The program was terminated following a runtime error:\n"
+        "Conversion of string abc to integer failed\n"
+        "while executing file factorialTest/factorialUse.txt\n"
+        "at line 8, column 23.\n"
+        "The interpreter's command line interface encountered an error:\n"
+        "2 of 5 batch records failed\n",
+        Failed
+    );
+    checkOutputFromArgs(
+        "stdinTest/lineNumberAdder.txt --batch batchTest/records.txt", "", "", Succeeded, "stdinTest/input.txt"
+    );
+}
+
 TEST_CASE("document tree dumping", "[IntegrationTests]")
 {
     std::string
@@ -0,0 +1,35 @@
+#!/bin/sh
+# Builds the optimized interpreter with profile-guided optimization.
+#
+# usage: pgo/buildOptimized.sh [BUILD_DIR] [CMAKE_OPTIONS...]
+#
+# The interpreter is first built with profiling instrumentation and trained on the scripts in pgo/training and on the
+# integration test programs. Then it is rebuilt in the same build directory, so that the collected profiles match the
+# object files, using the profiles to guide optimization. The result is BUILD_DIR/src/app/inter.
+set -e
+
+SOURCE_DIR=$(cd "$(dirname "$0")/.." && pwd)
+BUILD_DIR=${1:-"$SOURCE_DIR/buildOptimized"}
+[ $# -gt 0 ] && shift
+PROFILE_DIR="$BUILD_DIR/pgoProfile"
+INTERPRETER="$BUILD_DIR/src/app/inter"
+
+rm -rf "$PROFILE_DIR"
+cmake -S "$SOURCE_DIR" -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DPGO=GENERATE -DPGO_PROFILE_DIR="$PROFILE_DIR" "$@"
+cmake --build "$BUILD_DIR" --target App
+
+for script in "$SOURCE_DIR"/pgo/training/*.txt; do
+    echo "Training on $script"
+    "$INTERPRETER" "$script" < /dev/null > /dev/null
+done
+# included files are found relative to the working directory
+cd "$SOURCE_DIR/integrationTests"
+echo "Training on integration test programs"
+"$INTERPRETER" factorialTest/factorialUse.txt --args 12 > /dev/null
+"$INTERPRETER" typesTest/main.txt > /dev/null
+"$INTERPRETER" stdinTest/lineNumberAdder.txt --args line < stdinTest/input.txt > /dev/null
+cd - > /dev/null
+
+cmake -S "$SOURCE_DIR" -B "$BUILD_DIR" -DPGO=USE
+cmake --build "$BUILD_DIR" --target App
+echo "Optimized interpreter built: $INTERPRETER"
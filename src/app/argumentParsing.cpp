@@ -15,16 +15,88 @@ std::vector<std::string> getArguments(int argc, const char * const argv[])
     return arguments;
 }
 
+std::wstring getOptionValue(const std::vector<std::string> &args, std::vector<std::string>::const_iterator &option)
+{
+    if(option + 1 == args.end())
+        throw MissingOptionValueError(std::format("No value given for option {}", *option));
+    return convertToWstring(*++option);
+}
+
+unsigned long long parseNumber(const std::string &option, const std::wstring &value, unsigned long long maximum)
+{
+    // checking the length first guarantees that std::stoull does not overflow
+    bool isNumber = !value.empty() && value.size() <= std::to_wstring(maximum).size() &&
+                    value.find_first_not_of(L"0123456789") == std::wstring::npos;
+    unsigned long long number = isNumber ? std::stoull(value) : 0;
+    if(number == 0 || number > maximum)
+        throw InvalidOptionValueError(
+            std::format("Value of option {} must be an integer from 1 to {}", option, maximum)
+        );
+    return number;
+}
+
 Arguments parseArguments(int argc, const char * const argv[])
 {
     std::vector<std::string> args = getArguments(argc, argv);
-    Arguments arguments = {{}, false, {}};
+    Arguments arguments = {
+        {}, false, {}, false, std::nullopt, std::nullopt, DEFAULT_SAMPLE_FREQUENCY, std::nullopt, std::nullopt, 0,
+        false, std::nullopt, false, false, {}
+    };
     bool files = true;
-    for(const std::string &arg: args)
+    for(auto current = args.cbegin(); current != args.cend(); current++)
     {
+        const std::string &arg = *current;
         std::wstring argument = convertToWstring(arg);
         if(argument == L"--dump-dt")
             arguments.dumpDocumentTree = true;
+        else if(argument == L"--profile")
+            arguments.profile = true;
+        else if(argument == L"--profile-json")
+        {
+            arguments.profile = true;
+            arguments.profileJsonFile = getOptionValue(args, current);
+        }
+        else if(argument == L"--sample")
+            arguments.sampleFile = getOptionValue(args, current);
+        else if(argument == L"--sample-frequency")
+        {
+            const std::string &option = *current;
+            arguments.sampleFrequency = parseNumber(option, getOptionValue(args, current), MAX_SAMPLE_FREQUENCY);
+        }
+        else if(argument == L"--trace")
+            arguments.traceFile = getOptionValue(args, current);
+        else if(argument == L"--batch")
+            arguments.batchFile = getOptionValue(args, current);
+        else if(argument == L"--jobs")
+        {
+            const std::string &option = *current;
+            arguments.jobs = parseNumber(option, getOptionValue(args, current), MAX_JOBS);
+        }
+        else if(argument == L"--cooperative")
+            arguments.cooperative = true;
+        else if(argument == L"--max-instructions")
+        {
+            const std::string &option = *current;
+            arguments.limits.maxInstructions =
+                parseNumber(option, getOptionValue(args, current), MAX_INSTRUCTIONS_LIMIT);
+        }
+        else if(argument == L"--max-time")
+        {
+            const std::string &option = *current;
+            arguments.limits.maxTime =
+                std::chrono::milliseconds(parseNumber(option, getOptionValue(args, current), MAX_TIME_LIMIT));
+        }
+        else if(argument == L"--max-heap")
+        {
+            const std::string &option = *current;
+            arguments.limits.maxHeapBytes = parseNumber(option, getOptionValue(args, current), MAX_HEAP_LIMIT) << 20;
+        }
+        else if(argument == L"--repl")
+            arguments.repl = true;
+        else if(argument == L"--report-pruned")
+            arguments.reportPruned = true;
+        else if(argument == L"--serve")
+            arguments.serveSocket = getOptionValue(args, current);
         else if(argument == L"--args")
             files = false;
         else if(files)
@@ -36,7 +108,28 @@ Arguments parseArguments(int argc, const char * const argv[])
         else
             arguments.programArguments.push_back(argument);
     }
-    if(arguments.files.empty())
+    // the programs executed by the server are given by its clients
+    if(arguments.serveSocket && (!arguments.files.empty() || !files))
+        throw IncompatibleOptionsError("Source code files and program arguments cannot be given in server mode");
+    if(arguments.serveSocket && (arguments.dumpDocumentTree || arguments.batchFile || arguments.reportPruned))
+        throw IncompatibleOptionsError("Server mode supports only the execution of programs");
+    if(arguments.serveSocket && (arguments.profile || arguments.sampleFile || arguments.traceFile))
+        throw IncompatibleOptionsError("Profiling is not supported in server mode");
+    if(arguments.repl && (arguments.serveSocket || arguments.batchFile || arguments.dumpDocumentTree))
+        throw IncompatibleOptionsError("The REPL cannot be run in server, batch or document tree dump mode");
+    // the REPL keeps all declarations, as later entries may call any of them
+    if(arguments.repl && arguments.reportPruned)
+        throw IncompatibleOptionsError("Nothing is pruned in the REPL");
+    if(arguments.repl && (arguments.profile || arguments.sampleFile || arguments.traceFile))
+        throw IncompatibleOptionsError("Profiling is not supported in the REPL");
+    if(arguments.files.empty() && !arguments.serveSocket && !arguments.repl)
         throw NoFilesError("No source code files given to interpreter");
+    if(arguments.batchFile && !files)
+        throw IncompatibleOptionsError("Program arguments cannot be given with --args in batch mode");
+    if(arguments.cooperative && !arguments.batchFile)
+        throw IncompatibleOptionsError("Option --cooperative can be used only in batch mode");
+    // the profilers record a single execution, while the batch mode runs many of them at once
+    if(arguments.batchFile && (arguments.profile || arguments.sampleFile))
+        throw IncompatibleOptionsError("Profiling is not supported in batch mode");
     return arguments;
 }
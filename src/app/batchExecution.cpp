@@ -0,0 +1,144 @@
+#include "batchExecution.hpp"
+
+#include "cooperativeScheduler.hpp"
+#include "execution.hpp"
+#include "runtimeExceptions.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <format>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+std::vector<std::vector<std::wstring>> readBatchRecords(std::wistream &input)
+{
+    std::vector<std::vector<std::wstring>> records;
+    std::wstring line;
+    while(std::getline(input, line))
+    {
+        std::wstringstream lineStream(line);
+        std::vector<std::wstring> &record = records.emplace_back();
+        std::wstring argument;
+        while(lineStream >> argument)
+            record.push_back(argument);
+    }
+    return records;
+}
+
+namespace {
+struct BatchResult
+{
+    bool finished = false;
+    std::wstring output;
+    std::optional<std::string> error;
+    // Set when the execution failed with an exception that is not a runtime error of the program.
+    std::exception_ptr exception;
+};
+
+// Returns true if the execution of the record was terminated by a runtime error.
+bool writeResult(const BatchResult &result, size_t record, std::wostream &output, std::ostream &errors)
+{
+    output << result.output << std::flush;
+    if(!result.error)
+        return false;
+    errors << std::format("Batch record {}:\n{}\n", record + 1, *result.error) << std::flush;
+    return true;
+}
+}
+
+unsigned runBatch(
+    const CompiledProgram &program, const std::vector<std::vector<std::wstring>> &records, unsigned threads,
+    std::wostream &output, std::ostream &errors, const ExecutionLimits &limits
+)
+{
+    std::vector<BatchResult> results(records.size());
+    std::mutex resultsMutex;
+    std::condition_variable resultFinished;
+    std::atomic<size_t> nextRecord = 0;
+    auto executeRecords = [&] {
+        for(size_t record = nextRecord++; record < records.size(); record = nextRecord++)
+        {
+            BatchResult result;
+            std::wstringstream recordInput, recordOutput;
+            try
+            {
+                Execution execution(
+                    program, records[record], recordInput, recordOutput, Interpreter::DEFAULT_MAX_STACK_SIZE, nullptr,
+                    nullptr, nullptr, limits
+                );
+                execution.run();
+            }
+            catch(const RuntimeError &e)
+            {
+                result.error = e.what();
+            }
+            catch(...)
+            {
+                result.exception = std::current_exception();
+            }
+            result.output = recordOutput.str();
+            result.finished = true;
+            std::lock_guard lock(resultsMutex);
+            results[record] = std::move(result);
+            resultFinished.notify_one();
+        }
+    };
+
+    std::vector<std::jthread> workers;
+    for(unsigned i = 0; i < threads; i++)
+        workers.emplace_back(executeRecords);
+    unsigned failed = 0;
+    for(size_t record = 0; record < records.size(); record++)
+    {
+        BatchResult result;
+        {
+            std::unique_lock lock(resultsMutex);
+            resultFinished.wait(lock, [&] { return results[record].finished; });
+            result = std::move(results[record]);
+        }
+        if(result.exception)
+        {
+            // no more records are started, the workers finish their current ones before the exception is rethrown
+            nextRecord = records.size();
+            workers.clear();
+            std::rethrow_exception(result.exception);
+        }
+        failed += writeResult(result, record, output, errors);
+    }
+    return failed;
+}
+
+unsigned runCooperativeBatch(
+    const CompiledProgram &program, const std::vector<std::vector<std::wstring>> &records, unsigned threads,
+    std::wostream &output, std::ostream &errors, const ExecutionLimits &limits
+)
+{
+    CooperativeScheduler scheduler(threads);
+    std::vector<CooperativeScheduler::Instance *> instances;
+    for(const std::vector<std::wstring> &record: records)
+    {
+        CooperativeScheduler::Instance &instance = scheduler.start(program, record, limits);
+        instance.closeInput();
+        instances.push_back(&instance);
+    }
+    unsigned failed = 0;
+    for(size_t record = 0; record < records.size(); record++)
+    {
+        // other errors are rethrown, the scheduler waits for the remaining instances before it is destroyed
+        BatchResult result;
+        try
+        {
+            instances[record]->wait();
+        }
+        catch(const RuntimeError &e)
+        {
+            result.error = e.what();
+        }
+        result.output = instances[record]->takeOutput();
+        failed += writeResult(result, record, output, errors);
+    }
+    return failed;
+}
@@ -0,0 +1,43 @@
+#include "appExceptions.hpp"
+#include "argumentParsing.hpp"
+#include "convertToString.hpp"
+#include "errorReporting.hpp"
+#include "programServer.hpp"
+
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+// Usage: inter-client SOCKET FILES [--args ARGUMENTS]
+// Executes the program on the interpreter server listening on the socket, passing it the standard input.
+int doMain(int argc, const char * const argv[])
+{
+    if(argc < 2)
+        throw MissingOptionValueError("No socket path given to client");
+    // the socket path is skipped, the rest is parsed like the arguments of the interpreter
+    Arguments arguments = parseArguments(argc - 1, argv + 1);
+    if(arguments.dumpDocumentTree || arguments.profile || arguments.sampleFile || arguments.traceFile ||
+       arguments.batchFile || arguments.serveSocket || arguments.repl || arguments.reportPruned)
+        throw IncompatibleOptionsError("The client supports only source code files and program arguments");
+    if(arguments.limits.maxInstructions || arguments.limits.maxTime || arguments.limits.maxHeapBytes)
+        throw IncompatibleOptionsError("Execution limits are set by the server");
+    std::stringstream input;
+    input << std::cin.rdbuf();
+    return runOnServer(
+        argv[1], std::filesystem::current_path(), arguments.files, arguments.programArguments, input.str(), std::cout,
+        std::cerr
+    );
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {
+        return doMain(argc, argv);
+    }
+    catch(const std::exception &e)
+    {
+        std::cerr << getErrorReport(e);
+        return 1;
+    }
+}
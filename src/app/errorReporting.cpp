@@ -0,0 +1,15 @@
+#include "errorReporting.hpp"
+
+#include "appExceptions.hpp"
+#include "readerExceptions.hpp"
+
+#include <format>
+
+std::string getErrorReport(const std::exception &error)
+{
+    if(dynamic_cast<const AppError *>(&error))
+        return std::format("The interpreter's command line interface encountered an error:\n{}\n", error.what());
+    if(dynamic_cast<const InterpreterPipelineError *>(&error))
+        return std::format("{}\n", error.what());
+    return std::format("An unexpected error occured:\n{}\n", error.what());
+}
@@ -23,4 +23,29 @@ class NoFilesError: public AppError
     using AppError::AppError;
 };
 
+class MissingOptionValueError: public AppError
+{
+    using AppError::AppError;
+};
+
+class InvalidOptionValueError: public AppError
+{
+    using AppError::AppError;
+};
+
+class IncompatibleOptionsError: public AppError
+{
+    using AppError::AppError;
+};
+
+class BatchExecutionError: public AppError
+{
+    using AppError::AppError;
+};
+
+class SocketError: public AppError
+{
+    using AppError::AppError;
+};
+
 #endif
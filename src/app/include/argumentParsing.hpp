@@ -1,14 +1,50 @@
 #ifndef ARGUMENTPARSING_HPP
 #define ARGUMENTPARSING_HPP
 
+#include "executionLimits.hpp"
+
+#include <optional>
 #include <string>
 #include <vector>
 
+static const unsigned DEFAULT_SAMPLE_FREQUENCY = 1000;
+static const unsigned MAX_SAMPLE_FREQUENCY = 1000000;
+static const unsigned MAX_JOBS = 1024;
+static const unsigned long long MAX_INSTRUCTIONS_LIMIT = 1'000'000'000'000'000;
+// in milliseconds
+static const unsigned long long MAX_TIME_LIMIT = 1'000'000'000;
+// in megabytes
+static const unsigned long long MAX_HEAP_LIMIT = 1'000'000'000;
+
 struct Arguments
 {
     std::vector<std::wstring> files;
     bool dumpDocumentTree;
     std::vector<std::wstring> programArguments;
+    bool profile;
+    // When set, the profile is written as JSON to this file instead of being printed as a report.
+    std::optional<std::wstring> profileJsonFile;
+    // When set, the call stack is sampled and written to this file as folded stacks.
+    std::optional<std::wstring> sampleFile;
+    // Number of call stack samples per second.
+    unsigned sampleFrequency;
+    // When set, durations of the interpreter's phases are written to this file in the Chrome trace event format.
+    std::optional<std::wstring> traceFile;
+    // When set, main is executed once for each record of this file, with the record as the program arguments.
+    std::optional<std::wstring> batchFile;
+    // Number of threads executing the batch records. 0 means the number of hardware threads.
+    unsigned jobs;
+    // When set, the batch records are executed as fibers of a cooperative scheduler running on the batch threads.
+    bool cooperative;
+    // When set, the interpreter serves requests to execute programs on the Unix domain socket at this path.
+    std::optional<std::wstring> serveSocket;
+    // When set, declarations and instructions are read from standard input and executed in a REPL, with the files
+    // loaded beforehand.
+    bool repl;
+    // When set, the functions and types removed from the program as unreachable from main are listed on standard error.
+    bool reportPruned;
+    // Budgets of every execution of the program.
+    ExecutionLimits limits;
 };
 
 Arguments parseArguments(int argc, const char * const argv[]);
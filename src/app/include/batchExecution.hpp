@@ -0,0 +1,33 @@
+#ifndef BATCHEXECUTION_HPP
+#define BATCHEXECUTION_HPP
+
+#include "compiledProgram.hpp"
+#include "executionLimits.hpp"
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Reads the records of a batch arguments file. Each line is one record, containing program arguments separated by
+// whitespace.
+std::vector<std::vector<std::wstring>> readBatchRecords(std::wistream &input);
+
+// Executes the main function of the program once for each record, with the record as its program arguments and with
+// empty standard input, on the given number of threads. The output of every execution is collected and written to
+// output in the order of the records, as soon as the execution and all the earlier ones finish. Runtime errors
+// terminating executions are written to errors after the output of the execution. Returns the number of executions
+// terminated by runtime errors. The execution limits apply to each execution separately.
+unsigned runBatch(
+    const CompiledProgram &program, const std::vector<std::vector<std::wstring>> &records, unsigned threads,
+    std::wostream &output, std::ostream &errors, const ExecutionLimits &limits = {}
+);
+
+// Executes the records like runBatch, but all of them are started at once as instances of a CooperativeScheduler
+// running on the given number of threads. Every execution has its own fiber stack instead of a thread.
+unsigned runCooperativeBatch(
+    const CompiledProgram &program, const std::vector<std::vector<std::wstring>> &records, unsigned threads,
+    std::wostream &output, std::ostream &errors, const ExecutionLimits &limits = {}
+);
+
+#endif
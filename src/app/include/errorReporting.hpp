@@ -0,0 +1,10 @@
+#ifndef ERRORREPORTING_HPP
+#define ERRORREPORTING_HPP
+
+#include <exception>
+#include <string>
+
+// Returns the message reported to the user when the error terminates the interpreter.
+std::string getErrorReport(const std::exception &error);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef PROGRAMLOADING_HPP
+#define PROGRAMLOADING_HPP
+
+#include "documentTree.hpp"
+
+#include <istream>
+#include <string>
+
+Program parseFromStream(std::wistream &input, const std::wstring &inputName);
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef PROGRAMSERVER_HPP
+#define PROGRAMSERVER_HPP
+
+#include "compiledProgram.hpp"
+#include "executionLimits.hpp"
+#include "socketProtocol.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Compiled programs kept between requests to the server. A program is compiled again when any of its source files,
+// including the included ones, has changed since its compilation: its modification time has changed and so has its
+// contents.
+class ProgramCache
+{
+public:
+    // Returns the program compiled from the files, whose relative paths are resolved against the working directory.
+    std::shared_ptr<const CompiledProgram> get(
+        const std::filesystem::path &workingDirectory, const std::vector<std::wstring> &files
+    );
+    unsigned getCompilations() const;
+private:
+    struct FileState
+    {
+        std::filesystem::path path;
+        std::filesystem::file_time_type modificationTime;
+        size_t contentsHash;
+    };
+
+    struct Entry
+    {
+        std::shared_ptr<const CompiledProgram> program;
+        std::vector<FileState> files;
+    };
+
+    std::mutex mutex;
+    std::map<std::pair<std::filesystem::path, std::vector<std::wstring>>, Entry> entries;
+    std::atomic<unsigned> compilations = 0;
+
+    // Updates the modification times of files whose contents have not changed.
+    static bool isUpToDate(std::vector<FileState> &files);
+    static std::optional<FileState> getFileState(const std::filesystem::path &path);
+};
+
+// Executes programs on requests received through a Unix domain socket, keeping the compiled programs in a cache. Every
+// connection is handled in its own thread. The execution limits apply to the execution of every request.
+class ProgramServer
+{
+public:
+    explicit ProgramServer(const std::string &socketPath, ExecutionLimits limits = {});
+    // Stops the server and waits for run to return and for the connections being handled.
+    ~ProgramServer();
+    // Accepts connections until the server is stopped.
+    void run();
+    // Can be called from any thread. Shuts down the connections being handled, so that the clients which have not sent
+    // their requests do not keep the server running.
+    void stop();
+    const ProgramCache &getCache() const;
+private:
+    struct Connection
+    {
+        explicit Connection(int descriptor);
+
+        // Closed after the thread is joined, so it can be shut down while the connection is in the list.
+        Socket socket;
+        std::atomic<bool> finished = false;
+        std::jthread thread;
+    };
+
+    Socket listening;
+    std::atomic<bool> stopping = false;
+    ProgramCache cache;
+    ExecutionLimits limits;
+    // Held by run until it returns.
+    std::mutex running;
+    std::mutex connectionsMutex;
+    std::list<std::unique_ptr<Connection>> connections;
+
+    void handleConnection(const Socket &connection);
+};
+
+// Sends the request to execute the program from the files to the server and writes the response to the output and
+// error streams. Returns the exit code of the execution.
+int runOnServer(
+    const std::string &socketPath, const std::filesystem::path &workingDirectory,
+    const std::vector<std::wstring> &files, const std::vector<std::wstring> &arguments, const std::string &input,
+    std::ostream &output, std::ostream &errors
+);
+
+#endif
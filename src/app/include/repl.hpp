@@ -0,0 +1,18 @@
+#ifndef REPL_HPP
+#define REPL_HPP
+
+#include "replSession.hpp"
+
+#include <istream>
+#include <ostream>
+#include <string>
+
+// Returns whether the entered text forms a whole entry: its braces and parentheses are closed and it ends with ';' or
+// '}'. Text that cannot be split into tokens is treated as whole, so that the error is reported at once.
+bool isEntryComplete(const std::wstring &text);
+
+// Reads entries from the input until its end, prompting for each of their lines on the output, and enters them into
+// the session. Errors are written to the error stream and do not end the REPL.
+void runRepl(ReplSession &session, std::wistream &input, std::wostream &output, std::ostream &errors);
+
+#endif
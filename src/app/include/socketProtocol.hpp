@@ -0,0 +1,55 @@
+#ifndef SOCKETPROTOCOL_HPP
+#define SOCKETPROTOCOL_HPP
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Messages exchanged between the interpreter server and its clients over a Unix domain socket are sequences of frames.
+// A frame consists of a one-byte type, the length of the payload as a 4-byte little-endian number and the payload,
+// which is UTF-8 text.
+//
+// A request consists of a WORKING_DIRECTORY frame, a SOURCE_FILE frame for every source file, an ARGUMENT frame for
+// every program argument, an INPUT frame with the whole standard input of the program and an END frame. The response
+// consists of OUTPUT frames with parts of the standard output of the program, an ERROR frame if the program failed and
+// an EXIT_CODE frame.
+enum class FrameType: char
+{
+    WORKING_DIRECTORY = 'D',
+    SOURCE_FILE = 'F',
+    ARGUMENT = 'A',
+    INPUT = 'I',
+    END = 'E',
+    OUTPUT = 'O',
+    ERROR = 'R',
+    EXIT_CODE = 'X',
+};
+
+struct Frame
+{
+    FrameType type;
+    std::string payload;
+};
+
+// Owns the file descriptor of a socket and closes it on destruction.
+class Socket
+{
+public:
+    explicit Socket(int descriptor);
+    Socket(Socket &&other);
+    Socket(const Socket &) = delete;
+    ~Socket();
+    int get() const;
+
+    static Socket connectTo(const std::string &path);
+    // Removes a stale socket file left at the path, if any. Throws SocketError if another kind of file exists there.
+    static Socket listenOn(const std::string &path);
+private:
+    int descriptor;
+};
+
+void sendFrame(const Socket &socket, FrameType type, std::string_view payload);
+// Returns std::nullopt if the connection was closed before the start of a frame.
+std::optional<Frame> receiveFrame(const Socket &socket);
+
+#endif
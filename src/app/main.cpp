@@ -1,79 +1,213 @@
 #include "appExceptions.hpp"
 #include "argumentParsing.hpp"
-#include "commentDiscarder.hpp"
+#include "batchExecution.hpp"
+#include "compiledProgram.hpp"
 #include "convertToString.hpp"
+#include "errorReporting.hpp"
+#include "execution.hpp"
 #include "includeExecution.hpp"
-#include "interpreter.hpp"
 #include "lexer.hpp"
 #include "parser.hpp"
 #include "printingVisitor.hpp"
+#include "profiler.hpp"
+#include "programLoading.hpp"
+#include "programServer.hpp"
+#include "repl.hpp"
+#include "samplingProfiler.hpp"
 #include "streamReader.hpp"
+#include "tokenBuffer.hpp"
+#include "tracer.hpp"
 
 #include <fstream>
 #include <iostream>
+#include <optional>
+#include <sstream>
+#include <thread>
 
-Program parseFromStream(std::wistream &input, const std::wstring &inputName)
+Program parseTraced(std::wistream &input, const std::wstring &inputName, Tracer &tracer)
 {
-    StreamReader reader(input, inputName);
-    Lexer lexer(reader);
-    CommentDiscarder commentDiscarder(lexer);
-    Parser parser(commentDiscarder);
+    // reading, lexing and parsing are normally interleaved, so they are done one after another to be timed separately
+    std::wstringstream source;
+    {
+        Tracer::Span span(&tracer, L"read", inputName);
+        source << input.rdbuf();
+    }
+    StreamReader reader(source, inputName);
+    Lexer lexer(reader, Lexer::CommentMode::SKIP);
+    std::optional<TokenBuffer> tokens;
+    {
+        Tracer::Span span(&tracer, L"lex", inputName);
+        tokens.emplace(lexer);
+    }
+    Tracer::Span span(&tracer, L"parse", inputName);
+    Parser parser(*tokens, Parser::BodyMode::SKIP);
     return parser.parseProgram();
 }
 
-Program parseFromFile(const std::wstring &fileName)
+Program parseFromFile(const std::wstring &fileName, Tracer *tracer)
 {
     std::string fileNameString = convertToString(fileName);
     std::wifstream fileStream(fileNameString);
     if(!fileStream.is_open())
         throw FileError(std::format("Failed to open file {}", fileNameString));
+    if(tracer)
+        return parseTraced(fileStream, fileName, *tracer);
     return parseFromStream(fileStream, fileName);
 }
 
-Program loadProgram(const std::vector<std::wstring> &files)
+Program loadProgram(const std::vector<std::wstring> &files, Tracer *tracer)
 {
-    Program program = parseFromFile(files[0]);
+    Tracer::Span span(tracer, L"load program");
+    Program program = parseFromFile(files[0], tracer);
     std::for_each(files.begin() + 1, files.end(), [&](const std::wstring &fileName) {
-        Program next = parseFromFile(fileName);
+        Program next = parseFromFile(fileName, tracer);
         mergePrograms(program, next);
     });
     return program;
 }
 
-void doMain(int argc, const char * const argv[])
+void writeToFile(const std::wstring &fileName, const std::wstring &contents)
 {
-    Arguments arguments = parseArguments(argc, argv);
-    Program program = loadProgram(arguments.files);
+    std::string fileNameString = convertToString(fileName);
+    std::ofstream fileStream(fileNameString);
+    if(!fileStream.is_open())
+        throw FileError(std::format("Failed to open file {}", fileNameString));
+    fileStream << convertToString(contents);
+}
+
+void writeProfile(const Arguments &arguments, const Profiler &profiler)
+{
+    // the report is converted to narrow characters, as standard error is also written to with std::cerr
+    std::wstringstream profile;
+    if(!arguments.profileJsonFile)
+    {
+        profiler.printReport(profile);
+        std::cerr << convertToString(profile.str());
+        return;
+    }
+    profiler.writeJson(profile);
+    writeToFile(*arguments.profileJsonFile, profile.str());
+}
+
+void writeProfiles(
+    const Arguments &arguments, const std::optional<Profiler> &profiler, const std::optional<SamplingProfiler> &sampler,
+    const std::optional<Tracer> &tracer
+)
+{
+    if(profiler)
+        writeProfile(arguments, *profiler);
+    if(sampler)
+    {
+        std::wstringstream samples;
+        sampler->writeFoldedStacks(samples);
+        writeToFile(*arguments.sampleFile, samples.str());
+    }
+    if(tracer)
+    {
+        std::wstringstream trace;
+        tracer->writeJson(trace);
+        writeToFile(*arguments.traceFile, trace.str());
+    }
+}
+
+void runBatchFile(const CompiledProgram &program, const Arguments &arguments, Tracer *tracer)
+{
+    std::string fileNameString = convertToString(*arguments.batchFile);
+    std::wifstream fileStream(fileNameString);
+    if(!fileStream.is_open())
+        throw FileError(std::format("Failed to open file {}", fileNameString));
+    std::vector<std::vector<std::wstring>> records = readBatchRecords(fileStream);
+    unsigned jobs = arguments.jobs != 0 ? arguments.jobs : std::max(std::thread::hardware_concurrency(), 1u);
+    Tracer::Span span(tracer, L"batch execution", *arguments.batchFile);
+    auto run = arguments.cooperative ? runCooperativeBatch : runBatch;
+    unsigned failed = run(program, records, jobs, std::wcout, std::cerr, arguments.limits);
+    if(failed != 0)
+        throw BatchExecutionError(std::format("{} of {} batch records failed", failed, records.size()));
+}
+
+void runProgram(Arguments &arguments, Profiler *profiler, SamplingProfiler *sampler, Tracer *tracer)
+{
+    Program program = loadProgram(arguments.files, tracer);
     if(arguments.dumpDocumentTree)
     {
         PrintingVisitor printer(std::wcout);
         printer.visit(program);
         return;
     }
-    Interpreter interpreter(arguments.files, arguments.programArguments, std::wcin, std::wcout, parseFromFile);
-    interpreter.visit(program);
+    CompiledProgram compiled(
+        std::move(program), arguments.files,
+        [&](const std::wstring &fileName) { return parseFromFile(fileName, tracer); }, tracer
+    );
+    if(arguments.reportPruned)
+    {
+        std::wstringstream report;
+        compiled.getPruned().printReport(report);
+        std::cerr << convertToString(report.str());
+    }
+    if(arguments.batchFile)
+        return runBatchFile(compiled, arguments, tracer);
+    Execution execution(
+        compiled, arguments.programArguments, std::wcin, std::wcout, Interpreter::DEFAULT_MAX_STACK_SIZE, profiler,
+        sampler, tracer, arguments.limits
+    );
+    execution.run();
 }
 
-int main(int argc, char *argv[])
+void runRepl(const Arguments &arguments)
 {
+    Program program = arguments.files.empty() ? Program({1, 1}) : loadProgram(arguments.files, nullptr);
+    ReplSession session(
+        std::move(program), arguments.files,
+        [](const std::wstring &fileName) { return parseFromFile(fileName, nullptr); }, arguments.programArguments,
+        std::wcin, std::wcout, arguments.limits
+    );
+    runRepl(session, std::wcin, std::wcout, std::cerr);
+}
+
+void doMain(int argc, const char * const argv[])
+{
+    Arguments arguments = parseArguments(argc, argv);
+    if(arguments.serveSocket)
+    {
+        ProgramServer server(convertToString(*arguments.serveSocket), arguments.limits);
+        server.run();
+        return;
+    }
+    if(arguments.repl)
+        return runRepl(arguments);
+    std::optional<Profiler> profiler;
+    if(arguments.profile)
+        profiler.emplace();
+    std::optional<SamplingProfiler> sampler;
+    if(arguments.sampleFile)
+        sampler.emplace(arguments.sampleFrequency);
+    std::optional<Tracer> tracer;
+    if(arguments.traceFile)
+        tracer.emplace();
     try
     {
-        doMain(argc, argv);
-        return 0;
+        runProgram(
+            arguments, profiler ? &*profiler : nullptr, sampler ? &*sampler : nullptr, tracer ? &*tracer : nullptr
+        );
     }
-    catch(const AppError &e)
+    catch(...)
     {
-        std::cerr << "The interpreter's command line interface encountered an error:\n" << e.what() << "\n";
-        return 1;
+        writeProfiles(arguments, profiler, sampler, tracer);
+        throw;
     }
-    catch(const InterpreterPipelineError &e)
+    writeProfiles(arguments, profiler, sampler, tracer);
+}
+
+int main(int argc, char *argv[])
+{
+    try
     {
-        std::cerr << e.what() << "\n";
-        return 1;
+        doMain(argc, argv);
+        return 0;
     }
     catch(const std::exception &e)
     {
-        std::cerr << "An unexpected error occured:\n" << e.what() << "\n";
+        std::cerr << getErrorReport(e);
         return 1;
     }
 }
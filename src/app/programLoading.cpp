@@ -0,0 +1,13 @@
+#include "programLoading.hpp"
+
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "streamReader.hpp"
+
+Program parseFromStream(std::wistream &input, const std::wstring &inputName)
+{
+    StreamReader reader(input, inputName);
+    Lexer lexer(reader, Lexer::CommentMode::SKIP);
+    Parser parser(lexer, Parser::BodyMode::SKIP);
+    return parser.parseProgram();
+}
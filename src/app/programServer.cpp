@@ -0,0 +1,280 @@
+#include "programServer.hpp"
+
+#include "appExceptions.hpp"
+#include "convertToString.hpp"
+#include "errorReporting.hpp"
+#include "execution.hpp"
+#include "programLoading.hpp"
+
+#include <array>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <streambuf>
+
+#include <sys/socket.h>
+
+std::shared_ptr<const CompiledProgram> ProgramCache::get(
+    const std::filesystem::path &workingDirectory, const std::vector<std::wstring> &files
+)
+{
+    auto key = std::make_pair(workingDirectory, files);
+    {
+        std::lock_guard lock(mutex);
+        auto found = entries.find(key);
+        if(found != entries.end() && isUpToDate(found->second.files))
+            return found->second.program;
+    }
+    // the program is compiled without holding the lock, so that other programs can be served in the meantime
+    Entry entry;
+    auto parseFromFile = [&](const std::wstring &fileName) {
+        // the state is recorded before parsing, so that a file changed while the program is compiled is detected as
+        // changed at the next request
+        std::optional<FileState> state = getFileState(workingDirectory / fileName);
+        // a file removed in the meantime makes the entry invalid at the next request
+        entry.files.push_back(state ? *state : FileState{workingDirectory / fileName, {}, 0});
+        std::wifstream fileStream(workingDirectory / fileName);
+        if(!fileStream.is_open())
+            throw FileError(std::format("Failed to open file {}", convertToString(fileName)));
+        return parseFromStream(fileStream, fileName);
+    };
+    auto program = std::make_shared<const CompiledProgram>(files, parseFromFile);
+    compilations++;
+    entry.program = program;
+    std::lock_guard lock(mutex);
+    entries.insert_or_assign(key, std::move(entry));
+    return program;
+}
+
+unsigned ProgramCache::getCompilations() const
+{
+    return compilations;
+}
+
+bool ProgramCache::isUpToDate(std::vector<FileState> &files)
+{
+    for(FileState &file: files)
+    {
+        std::error_code error;
+        std::filesystem::file_time_type modificationTime = std::filesystem::last_write_time(file.path, error);
+        if(error)
+            return false;
+        if(modificationTime == file.modificationTime)
+            continue;
+        std::optional<FileState> current = getFileState(file.path);
+        if(!current || current->contentsHash != file.contentsHash)
+            return false;
+        file.modificationTime = current->modificationTime;
+    }
+    return true;
+}
+
+std::optional<ProgramCache::FileState> ProgramCache::getFileState(const std::filesystem::path &path)
+{
+    std::error_code error;
+    std::filesystem::file_time_type modificationTime = std::filesystem::last_write_time(path, error);
+    std::ifstream fileStream(path, std::ios::binary);
+    if(error || !fileStream.is_open())
+        return std::nullopt;
+    std::stringstream contents;
+    contents << fileStream.rdbuf();
+    return FileState{path, modificationTime, std::hash<std::string>{}(contents.str())};
+}
+
+namespace {
+// Sends the written output to the client in OUTPUT frames.
+class SocketOutputBuffer: public std::wstreambuf
+{
+public:
+    explicit SocketOutputBuffer(const Socket &connection): connection(connection)
+    {
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+protected:
+    int_type overflow(int_type character) override
+    {
+        sync();
+        if(!traits_type::eq_int_type(character, traits_type::eof()))
+            sputc(traits_type::to_char_type(character));
+        return traits_type::not_eof(character);
+    }
+
+    int sync() override
+    {
+        if(pptr() != pbase())
+            sendFrame(connection, FrameType::OUTPUT, convertToString(std::wstring(pbase(), pptr())));
+        setp(buffer.data(), buffer.data() + buffer.size());
+        return 0;
+    }
+private:
+    const Socket &connection;
+    std::array<wchar_t, 4096> buffer;
+};
+
+struct Request
+{
+    std::filesystem::path workingDirectory;
+    std::vector<std::wstring> files;
+    std::vector<std::wstring> arguments;
+    std::wstring input;
+};
+
+Request receiveRequest(const Socket &connection)
+{
+    Request request;
+    while(true)
+    {
+        std::optional<Frame> frame = receiveFrame(connection);
+        if(!frame)
+            throw SocketError("Connection closed before the end of the request");
+        switch(frame->type)
+        {
+        case FrameType::WORKING_DIRECTORY:
+            request.workingDirectory = convertToWstring(frame->payload);
+            break;
+        case FrameType::SOURCE_FILE:
+            request.files.push_back(convertToWstring(frame->payload));
+            break;
+        case FrameType::ARGUMENT:
+            request.arguments.push_back(convertToWstring(frame->payload));
+            break;
+        case FrameType::INPUT:
+            request.input = convertToWstring(frame->payload);
+            break;
+        case FrameType::END:
+            return request;
+        default:
+            throw SocketError("Unexpected message in the request");
+        }
+    }
+}
+}
+
+ProgramServer::ProgramServer(const std::string &socketPath, ExecutionLimits limits):
+    listening(Socket::listenOn(socketPath)), limits(limits)
+{}
+
+ProgramServer::Connection::Connection(int descriptor):
+    socket(descriptor)
+{}
+
+ProgramServer::~ProgramServer()
+{
+    stop();
+    // run may still be changing the connections
+    std::lock_guard runLock(running);
+    std::lock_guard lock(connectionsMutex);
+    connections.clear();
+}
+
+void ProgramServer::run()
+{
+    std::lock_guard runLock(running);
+    while(!stopping)
+    {
+        int accepted = accept(listening.get(), nullptr, nullptr);
+        if(accepted < 0)
+        {
+            if(stopping)
+                return;
+            if(errno == EINTR || errno == ECONNABORTED)
+                continue;
+            throw SocketError("Failed to accept a connection");
+        }
+        std::lock_guard lock(connectionsMutex);
+        connections.remove_if([](const std::unique_ptr<Connection> &connection) {
+            return connection->finished.load();
+        });
+        Connection &connection = *connections.emplace_back(std::make_unique<Connection>(accepted));
+        // the connection was accepted after stop shut down the others
+        if(stopping)
+            shutdown(accepted, SHUT_RDWR);
+        connection.thread = std::jthread([this, &connection] {
+            try
+            {
+                handleConnection(connection.socket);
+            }
+            catch(const SocketError &)
+            {
+                // the client has disconnected, so the error cannot be reported to it
+            }
+            connection.finished = true;
+        });
+    }
+}
+
+void ProgramServer::stop()
+{
+    stopping = true;
+    // makes the blocked accept return
+    shutdown(listening.get(), SHUT_RDWR);
+    // makes the threads blocked on receiving requests or sending responses return
+    std::lock_guard lock(connectionsMutex);
+    for(const std::unique_ptr<Connection> &connection: connections)
+        shutdown(connection->socket.get(), SHUT_RDWR);
+}
+
+const ProgramCache &ProgramServer::getCache() const
+{
+    return cache;
+}
+
+void ProgramServer::handleConnection(const Socket &connection)
+{
+    Request request = receiveRequest(connection);
+    SocketOutputBuffer outputBuffer(connection);
+    std::wostream output(&outputBuffer);
+    std::wstringstream input(request.input);
+    std::optional<std::string> error;
+    try
+    {
+        if(request.files.empty())
+            throw NoFilesError("No source code files given to interpreter");
+        std::shared_ptr<const CompiledProgram> program = cache.get(request.workingDirectory, request.files);
+        Execution execution(
+            *program, request.arguments, input, output, Interpreter::DEFAULT_MAX_STACK_SIZE, nullptr, nullptr, nullptr,
+            limits
+        );
+        execution.run();
+    }
+    catch(const SocketError &)
+    {
+        throw;
+    }
+    catch(const std::exception &e)
+    {
+        error = getErrorReport(e);
+    }
+    output.flush();
+    if(error)
+        sendFrame(connection, FrameType::ERROR, *error);
+    sendFrame(connection, FrameType::EXIT_CODE, error ? "1" : "0");
+}
+
+int runOnServer(
+    const std::string &socketPath, const std::filesystem::path &workingDirectory,
+    const std::vector<std::wstring> &files, const std::vector<std::wstring> &arguments, const std::string &input,
+    std::ostream &output, std::ostream &errors
+)
+{
+    Socket connection = Socket::connectTo(socketPath);
+    sendFrame(connection, FrameType::WORKING_DIRECTORY, workingDirectory.string());
+    for(const std::wstring &file: files)
+        sendFrame(connection, FrameType::SOURCE_FILE, convertToString(file));
+    for(const std::wstring &argument: arguments)
+        sendFrame(connection, FrameType::ARGUMENT, convertToString(argument));
+    sendFrame(connection, FrameType::INPUT, input);
+    sendFrame(connection, FrameType::END, "");
+    while(std::optional<Frame> frame = receiveFrame(connection))
+    {
+        if(frame->type == FrameType::OUTPUT)
+            output << frame->payload << std::flush;
+        else if(frame->type == FrameType::ERROR)
+            errors << frame->payload << std::flush;
+        else if(frame->type == FrameType::EXIT_CODE)
+            return std::stoi(frame->payload);
+        else
+            throw SocketError("Unexpected message in the response");
+    }
+    throw SocketError("Connection closed before the end of the response");
+}
@@ -0,0 +1,72 @@
+#include "repl.hpp"
+
+#include "errorReporting.hpp"
+#include "lexer.hpp"
+#include "streamReader.hpp"
+
+#include <sstream>
+
+namespace {
+const std::wstring REPL_SOURCE_NAME = L"<repl>";
+
+ReplEntry parseEntry(const std::wstring &text)
+{
+    std::wstringstream source(text);
+    StreamReader reader(source, REPL_SOURCE_NAME);
+    Lexer lexer(reader, Lexer::CommentMode::SKIP);
+    Parser parser(lexer);
+    return parser.parseReplEntry();
+}
+}
+
+bool isEntryComplete(const std::wstring &text)
+{
+    std::wstringstream source(text);
+    StreamReader reader(source, REPL_SOURCE_NAME);
+    Lexer lexer(reader, Lexer::CommentMode::SKIP);
+    int depth = 0;
+    std::optional<TokenType> last;
+    try
+    {
+        for(Token token = lexer.getNextToken(); token.getType() != TokenType::EOT; token = lexer.getNextToken())
+        {
+            if(token.getType() == TokenType::LBRACE || token.getType() == TokenType::LPAREN)
+                depth += 1;
+            else if(token.getType() == TokenType::RBRACE || token.getType() == TokenType::RPAREN)
+                depth -= 1;
+            last = token.getType();
+        }
+    }
+    catch(const InterpreterPipelineError &)
+    {
+        return true;
+    }
+    return !last || (depth <= 0 && (last == TokenType::SEMICOLON || last == TokenType::RBRACE));
+}
+
+void runRepl(ReplSession &session, std::wistream &input, std::wostream &output, std::ostream &errors)
+{
+    std::wstring text, line;
+    output << L">>> " << std::flush;
+    while(std::getline(input, line))
+    {
+        text += line + L'\n';
+        if(!isEntryComplete(text))
+        {
+            output << L"... " << std::flush;
+            continue;
+        }
+        try
+        {
+            session.enter(parseEntry(text), REPL_SOURCE_NAME);
+        }
+        catch(const std::exception &e)
+        {
+            output << std::flush;
+            errors << getErrorReport(e) << std::flush;
+        }
+        text.clear();
+        output << L">>> " << std::flush;
+    }
+    output << L'\n';
+}
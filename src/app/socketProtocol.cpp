@@ -0,0 +1,148 @@
+#include "socketProtocol.hpp"
+
+#include "appExceptions.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <format>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+const uint32_t MAX_PAYLOAD_SIZE = 1 << 30;
+
+std::string getSystemError(const std::string &message)
+{
+    return std::format("{}: {}", message, std::strerror(errno));
+}
+
+sockaddr_un getAddress(const std::string &path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if(path.size() >= sizeof(address.sun_path))
+        throw SocketError(std::format("Socket path is too long: {}", path));
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+
+void sendAll(const Socket &socket, const char *data, size_t size)
+{
+    while(size > 0)
+    {
+        // the connection may be closed by the other side, which should not terminate the process with SIGPIPE
+        ssize_t sent = send(socket.get(), data, size, MSG_NOSIGNAL);
+        if(sent < 0 && errno == EINTR)
+            continue;
+        if(sent < 0)
+            throw SocketError(getSystemError("Failed to send data through socket"));
+        data += sent;
+        size -= sent;
+    }
+}
+
+// Returns false if the connection was closed before any data was received.
+bool receiveAll(const Socket &socket, char *data, size_t size)
+{
+    size_t received = 0;
+    while(received < size)
+    {
+        ssize_t count = recv(socket.get(), data + received, size - received, 0);
+        if(count < 0 && errno == EINTR)
+            continue;
+        if(count < 0)
+            throw SocketError(getSystemError("Failed to receive data through socket"));
+        if(count == 0)
+        {
+            if(received == 0)
+                return false;
+            throw SocketError("Connection closed in the middle of a message");
+        }
+        received += count;
+    }
+    return true;
+}
+}
+
+Socket::Socket(int descriptor): descriptor(descriptor) {}
+
+Socket::Socket(Socket &&other): descriptor(other.descriptor)
+{
+    other.descriptor = -1;
+}
+
+Socket::~Socket()
+{
+    if(descriptor >= 0)
+        close(descriptor);
+}
+
+int Socket::get() const
+{
+    return descriptor;
+}
+
+Socket Socket::connectTo(const std::string &path)
+{
+    sockaddr_un address = getAddress(path);
+    Socket connection(socket(AF_UNIX, SOCK_STREAM, 0));
+    if(connection.get() < 0)
+        throw SocketError(getSystemError("Failed to create socket"));
+    if(connect(connection.get(), reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+        throw SocketError(getSystemError(std::format("Failed to connect to server at {}", path)));
+    return connection;
+}
+
+Socket Socket::listenOn(const std::string &path)
+{
+    sockaddr_un address = getAddress(path);
+    Socket listening(socket(AF_UNIX, SOCK_STREAM, 0));
+    if(listening.get() < 0)
+        throw SocketError(getSystemError("Failed to create socket"));
+    // a socket left by a previous server is replaced, but no other file is removed
+    struct stat existing;
+    if(lstat(path.c_str(), &existing) == 0)
+    {
+        if(!S_ISSOCK(existing.st_mode))
+            throw SocketError(std::format("Cannot listen on {}, as it is an existing file other than a socket", path));
+        unlink(path.c_str());
+    }
+    if(bind(listening.get(), reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+        throw SocketError(getSystemError(std::format("Failed to bind socket to {}", path)));
+    if(listen(listening.get(), SOMAXCONN) < 0)
+        throw SocketError(getSystemError(std::format("Failed to listen on socket {}", path)));
+    return listening;
+}
+
+void sendFrame(const Socket &socket, FrameType type, std::string_view payload)
+{
+    if(payload.size() > MAX_PAYLOAD_SIZE)
+        throw SocketError("Message is too long to be sent");
+    std::array<char, 5> header;
+    header[0] = static_cast<char>(type);
+    for(unsigned i = 0; i < 4; i++)
+        header[i + 1] = static_cast<char>((payload.size() >> (8 * i)) & 0xff);
+    sendAll(socket, header.data(), header.size());
+    sendAll(socket, payload.data(), payload.size());
+}
+
+std::optional<Frame> receiveFrame(const Socket &socket)
+{
+    std::array<char, 5> header;
+    if(!receiveAll(socket, header.data(), header.size()))
+        return std::nullopt;
+    uint32_t size = 0;
+    for(unsigned i = 0; i < 4; i++)
+        size |= static_cast<uint32_t>(static_cast<unsigned char>(header[i + 1])) << (8 * i);
+    if(size > MAX_PAYLOAD_SIZE)
+        throw SocketError("Received message is too long");
+    Frame frame{static_cast<FrameType>(header[0]), std::string(size, '\0')};
+    if(size > 0 && !receiveAll(socket, frame.payload.data(), size))
+        throw SocketError("Connection closed in the middle of a message");
+    return frame;
+}
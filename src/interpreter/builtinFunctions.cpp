@@ -1,29 +1,28 @@
 #include "builtinFunctions.hpp"
 
 #include "runtimeExceptions.hpp"
+#include "spawnedTask.hpp"
 
 #include <limits>
 
 using enum Type::Builtin;
 
-BuiltinFunction builtinNoArguments(const std::vector<std::wstring> &arguments)
-{
-    return {
-        FunctionIdentification(L"no_arguments", {}),
-        BuiltinFunctionDeclaration(
-            {0, 0}, L"<builtins>", {}, {{INT}},
-            [&](Position callPosition, const std::wstring &callSource,
-                std::vector<std::variant<Object, std::reference_wrapper<Object>>>) -> std::optional<Object> {
-                size_t noArguments = arguments.size();
-                if(noArguments > std::numeric_limits<int32_t>::max())
-                    throw RuntimeError(
-                        L"Program arguments number exceeds int type maximum value", callSource, callPosition
-                    ); // *should* not be reachable
-                return Object{{INT}, static_cast<int32_t>(arguments.size())};
-            }
-        )
-    };
-}
+const BuiltinFunction builtinNoArguments = {
+    FunctionIdentification(L"no_arguments", {}),
+    BuiltinFunctionDeclaration(
+        {0, 0}, L"<builtins>", {}, {{INT}},
+        [](Position callPosition, const std::wstring &callSource,
+           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &,
+           ExecutionEnvironment &environment) -> std::optional<Object> {
+            size_t noArguments = environment.arguments.size();
+            if(noArguments > std::numeric_limits<int32_t>::max())
+                throw RuntimeError(
+                    L"Program arguments number exceeds int type maximum value", callSource, callPosition
+                ); // *should* not be reachable
+            return Object{{INT}, static_cast<int32_t>(environment.arguments.size())};
+        }
+    )
+};
 
 template <typename T>
 T getArg(std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args)
@@ -31,112 +30,193 @@ T getArg(std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args
     return std::get<T>(getObject(args[0]).value);
 }
 
-BuiltinFunction builtinArgument(const std::vector<std::wstring> &arguments)
+// Strings are read in place, as the arguments passed from variables are references to them.
+const Utf8String &getStringArg(std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args, unsigned index)
 {
-    return {
-        FunctionIdentification(L"argument", {{INT}}),
-        BuiltinFunctionDeclaration(
-            {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, {INT}, L"index", false)}, {{STR}},
-            [&](Position callPosition, const std::wstring &callSource,
-                std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args) -> std::optional<Object> {
-                auto index = getArg<int32_t>(args);
-                if(index < 0 || static_cast<size_t>(index) >= arguments.size())
-                    throw BuiltinFunctionArgumentError(
-                        std::format(L"There is no program argument with index {}", index), callSource, callPosition
-                    );
-                return Object{{STR}, arguments[index]};
-            }
-        )
-    };
+    return std::get<Utf8String>(getObject(args[index]).value);
 }
 
-BuiltinFunction builtinPrint(std::wostream &output)
-{
-    return {
-        FunctionIdentification(L"print", {{STR}}),
-        BuiltinFunctionDeclaration(
-            {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, {STR}, L"message", false)}, std::nullopt,
-            [&](Position callPosition, const std::wstring &callSource,
-                std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args) -> std::optional<Object> {
-                auto message = getArg<std::wstring>(args);
-                output << message;
-                if(output.bad())
-                    throw StandardOutputError(L"Standard output stream returned error", callSource, callPosition);
-                return std::nullopt;
-            }
-        )
-    };
-}
+const BuiltinFunction builtinArgument = {
+    FunctionIdentification(L"argument", {{INT}}),
+    BuiltinFunctionDeclaration(
+        {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, {INT}, L"index", false)}, {{STR}},
+        [](Position callPosition, const std::wstring &callSource,
+           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &environment) -> std::optional<Object> {
+            auto index = getArg<int32_t>(args);
+            if(index < 0 || static_cast<size_t>(index) >= environment.arguments.size())
+                throw BuiltinFunctionArgumentError(
+                    std::format(L"There is no program argument with index {}", index), callSource, callPosition
+                );
+            return Object{{STR}, environment.arguments[index]};
+        }
+    )
+};
 
-BuiltinFunction builtinPrintln(std::wostream &output)
-{
-    return {
-        FunctionIdentification(L"println", {{STR}}),
-        BuiltinFunctionDeclaration(
-            {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, {STR}, L"message", false)}, std::nullopt,
-            [&](Position callPosition, const std::wstring &callSource,
-                std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args) -> std::optional<Object> {
-                auto message = getArg<std::wstring>(args);
-                output << message << L'\n';
-                if(output.bad())
-                    throw StandardOutputError(L"Standard output stream returned error", callSource, callPosition);
-                return std::nullopt;
-            }
-        )
-    };
-}
+const BuiltinFunction builtinPrint = {
+    FunctionIdentification(L"print", {{STR}}),
+    BuiltinFunctionDeclaration(
+        {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, {STR}, L"message", false)}, std::nullopt,
+        [](Position callPosition, const std::wstring &callSource,
+           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &environment) -> std::optional<Object> {
+            environment.output << getStringArg(args, 0);
+            if(environment.output.bad())
+                throw StandardOutputError(L"Standard output stream returned error", callSource, callPosition);
+            return std::nullopt;
+        }
+    )
+};
 
-BuiltinFunction builtinInputLine(std::wistream &input)
-{
-    return {
-        FunctionIdentification(L"input", {}),
-        BuiltinFunctionDeclaration(
-            {0, 0}, L"<builtins>", {}, {{STR}},
-            [&](Position callPosition, const std::wstring &callSource,
-                std::vector<std::variant<Object, std::reference_wrapper<Object>>>) -> std::optional<Object> {
-                std::wstring line;
-                std::getline(input, line);
-                if(input.bad())
-                    throw StandardInputError(L"Standard input stream returned error", callSource, callPosition);
-                return Object{{STR}, line};
-            }
-        )
-    };
-}
+const BuiltinFunction builtinPrintln = {
+    FunctionIdentification(L"println", {{STR}}),
+    BuiltinFunctionDeclaration(
+        {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, {STR}, L"message", false)}, std::nullopt,
+        [](Position callPosition, const std::wstring &callSource,
+           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &environment) -> std::optional<Object> {
+            environment.output << getStringArg(args, 0) << L'\n';
+            if(environment.output.bad())
+                throw StandardOutputError(L"Standard output stream returned error", callSource, callPosition);
+            return std::nullopt;
+        }
+    )
+};
 
-BuiltinFunction builtinInput(std::wistream &input)
-{
-    return {
-        FunctionIdentification(L"input", {{INT}}),
-        BuiltinFunctionDeclaration(
-            {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, {INT}, L"no_chars", false)}, {{STR}},
-            [&](Position callPosition, const std::wstring &callSource,
-                std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args) -> std::optional<Object> {
-                auto numberOfCharacters = getArg<int32_t>(args);
-                if(numberOfCharacters < 0)
-                    throw BuiltinFunctionArgumentError(
-                        L"input function argument must be positive", callSource, callPosition
-                    );
-                std::wstring read;
-                read.resize(static_cast<size_t>(numberOfCharacters));
-                input.read(&read[0], numberOfCharacters);
-                if(input.bad())
-                    throw StandardInputError(L"Standard input stream returned error", callSource, callPosition);
-                read.resize(input.gcount());
-                return Object{{STR}, read};
-            }
-        )
-    };
-}
+const BuiltinFunction builtinInputLine = {
+    FunctionIdentification(L"input", {}),
+    BuiltinFunctionDeclaration(
+        {0, 0}, L"<builtins>", {}, {{STR}},
+        [](Position callPosition, const std::wstring &callSource,
+           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &,
+           ExecutionEnvironment &environment) -> std::optional<Object> {
+            std::wstring line;
+            std::getline(environment.input, line);
+            if(environment.input.bad())
+                throw StandardInputError(L"Standard input stream returned error", callSource, callPosition);
+            return Object{{STR}, line};
+        }
+    )
+};
+
+const BuiltinFunction builtinInput = {
+    FunctionIdentification(L"input", {{INT}}),
+    BuiltinFunctionDeclaration(
+        {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, {INT}, L"no_chars", false)}, {{STR}},
+        [](Position callPosition, const std::wstring &callSource,
+           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &environment) -> std::optional<Object> {
+            auto numberOfCharacters = getArg<int32_t>(args);
+            if(numberOfCharacters < 0)
+                throw BuiltinFunctionArgumentError(
+                    L"input function argument must be positive", callSource, callPosition
+                );
+            std::wstring read;
+            read.resize(static_cast<size_t>(numberOfCharacters));
+            environment.input.read(&read[0], numberOfCharacters);
+            if(environment.input.bad())
+                throw StandardInputError(L"Standard input stream returned error", callSource, callPosition);
+            read.resize(environment.input.gcount());
+            return Object{{STR}, read};
+        }
+    )
+};
 
 const BuiltinFunction builtinLen = {
     FunctionIdentification(L"len", {{STR}}),
     BuiltinFunctionDeclaration(
         {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, {STR}, L"string", false)}, {{INT}},
         [](Position, const std::wstring &,
-           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args) -> std::optional<Object> {
-            std::wstring string = std::get<std::wstring>(getObject(args[0]).value);
-            return Object{{INT}, static_cast<int32_t>(string.size())};
+           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &) -> std::optional<Object> {
+            return Object{{INT}, static_cast<int32_t>(getStringArg(args, 0).size())};
+        }
+    )
+};
+
+const BuiltinFunction builtinSubstr = {
+    FunctionIdentification(L"substr", {{STR}, {INT}, {INT}}),
+    BuiltinFunctionDeclaration(
+        {0, 0}, L"<builtins>",
+        {VariableDeclaration({0, 0}, {STR}, L"string", false), VariableDeclaration({0, 0}, {INT}, L"start", false),
+         VariableDeclaration({0, 0}, {INT}, L"length", false)},
+        {{STR}},
+        [](Position callPosition, const std::wstring &callSource,
+           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &) -> std::optional<Object> {
+            const Utf8String &string = getStringArg(args, 0);
+            int32_t start = std::get<int32_t>(getObject(args[1]).value);
+            int32_t length = std::get<int32_t>(getObject(args[2]).value);
+            if(start < 0 || static_cast<size_t>(start) > string.size())
+                throw BuiltinFunctionArgumentError(
+                    std::format(L"Substring start {} is out of range of string of length {}", start, string.size()),
+                    callSource, callPosition
+                );
+            if(length < 0)
+                throw BuiltinFunctionArgumentError(
+                    std::format(L"Substring length {} is negative", length), callSource, callPosition
+                );
+            // the substring is cut short at the end of the string
+            return Object{{STR}, string.substr(static_cast<size_t>(start), static_cast<size_t>(length))};
+        }
+    )
+};
+
+const BuiltinFunction builtinFind = {
+    FunctionIdentification(L"find", {{STR}, {STR}}),
+    BuiltinFunctionDeclaration(
+        {0, 0}, L"<builtins>",
+        {VariableDeclaration({0, 0}, {STR}, L"string", false), VariableDeclaration({0, 0}, {STR}, L"fragment", false)},
+        {{INT}},
+        [](Position, const std::wstring &, std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &) -> std::optional<Object> {
+            size_t found = getStringArg(args, 0).find(getStringArg(args, 1));
+            return Object{{INT}, found == Utf8String::npos ? -1 : static_cast<int32_t>(found)};
+        }
+    )
+};
+
+const BuiltinFunction builtinStartsWith = {
+    FunctionIdentification(L"starts_with", {{STR}, {STR}}),
+    BuiltinFunctionDeclaration(
+        {0, 0}, L"<builtins>",
+        {VariableDeclaration({0, 0}, {STR}, L"string", false), VariableDeclaration({0, 0}, {STR}, L"prefix", false)},
+        {{BOOL}},
+        [](Position, const std::wstring &, std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &) -> std::optional<Object> {
+            return Object{{BOOL}, getStringArg(args, 0).startsWith(getStringArg(args, 1))};
+        }
+    )
+};
+
+const BuiltinFunction builtinSplit = {
+    FunctionIdentification(L"split", {{STR}, {STR}}),
+    BuiltinFunctionDeclaration(
+        {0, 0}, L"<builtins>",
+        {VariableDeclaration({0, 0}, {STR}, L"string", false),
+         VariableDeclaration({0, 0}, {STR}, L"separator", false)},
+        {{Type::Array({STR})}},
+        [](Position callPosition, const std::wstring &callSource,
+           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &) -> std::optional<Object> {
+            const Utf8String &separator = getStringArg(args, 1);
+            if(separator.size() == 0)
+                throw BuiltinFunctionArgumentError(L"split separator cannot be empty", callSource, callPosition);
+            std::vector<Object> parts;
+            for(Utf8String &part: getStringArg(args, 0).split(separator))
+                parts.push_back(Object{{STR}, std::move(part)});
+            return Object{{Type::Array({STR})}, std::move(parts)};
+        }
+    )
+};
+
+const BuiltinFunction builtinTrim = {
+    FunctionIdentification(L"trim", {{STR}}),
+    BuiltinFunctionDeclaration(
+        {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, {STR}, L"string", false)}, {{STR}},
+        [](Position, const std::wstring &, std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &) -> std::optional<Object> {
+            return Object{{STR}, getStringArg(args, 0).trim()};
         }
     )
 };
@@ -146,7 +226,8 @@ const BuiltinFunction builtinAbsFloat = {
     BuiltinFunctionDeclaration(
         {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, {FLOAT}, L"value", false)}, {{FLOAT}},
         [](Position, const std::wstring &,
-           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args) -> std::optional<Object> {
+           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &) -> std::optional<Object> {
             auto value = getArg<double>(args);
             return Object{{FLOAT}, std::abs(value)};
         }
@@ -158,7 +239,8 @@ const BuiltinFunction builtinAbsInt = {
     BuiltinFunctionDeclaration(
         {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, {INT}, L"value", false)}, {{INT}},
         [](Position callPosition, const std::wstring &callSource,
-           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args) -> std::optional<Object> {
+           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &) -> std::optional<Object> {
             auto value = getArg<int32_t>(args);
             if(value < -std::numeric_limits<int32_t>::max())
                 throw IntegerRangeError(
@@ -185,7 +267,8 @@ const BuiltinFunction builtinMaxFloat = {
         {VariableDeclaration({0, 0}, {FLOAT}, L"first", false), VariableDeclaration({0, 0}, {FLOAT}, L"second", false)},
         {{FLOAT}},
         [](Position, const std::wstring &,
-           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args) -> std::optional<Object> {
+           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &) -> std::optional<Object> {
             auto [first, second] = getTwoArgs<double>(args);
             return Object{{FLOAT}, std::max(first, second)};
         }
@@ -199,7 +282,8 @@ const BuiltinFunction builtinMaxInt = {
         {VariableDeclaration({0, 0}, {INT}, L"first", false), VariableDeclaration({0, 0}, {INT}, L"second", false)},
         {{INT}},
         [](Position, const std::wstring &,
-           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args) -> std::optional<Object> {
+           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &) -> std::optional<Object> {
             auto [first, second] = getTwoArgs<int32_t>(args);
             return Object{{INT}, std::max(first, second)};
         }
@@ -213,7 +297,8 @@ const BuiltinFunction builtinMinFloat = {
         {VariableDeclaration({0, 0}, {FLOAT}, L"first", false), VariableDeclaration({0, 0}, {FLOAT}, L"second", false)},
         {{FLOAT}},
         [](Position, const std::wstring &,
-           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args) -> std::optional<Object> {
+           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &) -> std::optional<Object> {
             auto [first, second] = getTwoArgs<double>(args);
             return Object{{FLOAT}, std::min(first, second)};
         }
@@ -227,25 +312,29 @@ const BuiltinFunction builtinMinInt = {
         {VariableDeclaration({0, 0}, {INT}, L"first", false), VariableDeclaration({0, 0}, {INT}, L"second", false)},
         {{INT}},
         [](Position, const std::wstring &,
-           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args) -> std::optional<Object> {
+           std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+           ExecutionEnvironment &) -> std::optional<Object> {
             auto [first, second] = getTwoArgs<int32_t>(args);
             return Object{{INT}, std::min(first, second)};
         }
     )
 };
 
-Program prepareBuiltinFunctions(
-    Position programPosition, const std::vector<std::wstring> &arguments, std::wistream &input, std::wostream &output
-)
+Program prepareBuiltinFunctions(Position programPosition)
 {
     Program program(programPosition);
-    program.add(builtinNoArguments(arguments));
-    program.add(builtinArgument(arguments));
-    program.add(builtinPrint(output));
-    program.add(builtinPrintln(output));
-    program.add(builtinInputLine(input));
-    program.add(builtinInput(input));
+    program.add(builtinNoArguments);
+    program.add(builtinArgument);
+    program.add(builtinPrint);
+    program.add(builtinPrintln);
+    program.add(builtinInputLine);
+    program.add(builtinInput);
     program.add(builtinLen);
+    program.add(builtinSubstr);
+    program.add(builtinFind);
+    program.add(builtinStartsWith);
+    program.add(builtinSplit);
+    program.add(builtinTrim);
     program.add(builtinAbsFloat);
     program.add(builtinAbsInt);
     program.add(builtinMaxFloat);
@@ -254,3 +343,139 @@ Program prepareBuiltinFunctions(
     program.add(builtinMinInt);
     return program;
 }
+
+std::vector<BuiltinFunction> prepareArrayBuiltinFunctions(const Type &arrayType)
+{
+    const Type &elementType = arrayType.getElementType();
+    BuiltinFunction arrayLen = {
+        FunctionIdentification(L"len", {arrayType}),
+        BuiltinFunctionDeclaration(
+            {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, arrayType, L"array", false)}, {{INT}},
+            [](Position callPosition, const std::wstring &callSource,
+               std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+               ExecutionEnvironment &) -> std::optional<Object> {
+                size_t size = std::get<std::vector<Object>>(getObject(args[0]).value).size();
+                if(size > std::numeric_limits<int32_t>::max())
+                    throw IntegerRangeError(
+                        std::format(L"Array length {} exceeds int type maximum value", size), callSource, callPosition
+                    );
+                return Object{{INT}, static_cast<int32_t>(size)};
+            }
+        )
+    };
+    BuiltinFunction arrayAppend = {
+        FunctionIdentification(L"append", {arrayType, elementType}),
+        BuiltinFunctionDeclaration(
+            {0, 0}, L"<builtins>",
+            {VariableDeclaration({0, 0}, arrayType, L"array", true),
+             VariableDeclaration({0, 0}, elementType, L"element", false)},
+            std::nullopt,
+            [](Position callPosition, const std::wstring &callSource,
+               std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+               ExecutionEnvironment &) -> std::optional<Object> {
+                std::vector<Object> &elements = std::get<std::vector<Object>>(getObject(args[0]).value);
+                if(elements.size() >= static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+                    throw BuiltinFunctionArgumentError(
+                        L"Array length cannot exceed int type maximum value", callSource, callPosition
+                    );
+                // the element may belong to the array itself, so it is copied before the array is resized
+                if(std::holds_alternative<Object>(args[1]))
+                    elements.push_back(std::move(std::get<Object>(args[1])));
+                else
+                    elements.push_back(Object(getObject(args[1])));
+                return std::nullopt;
+            }
+        )
+    };
+    return {std::move(arrayLen), std::move(arrayAppend)};
+}
+
+std::vector<BuiltinFunction> prepareDictionaryBuiltinFunctions(const Type &dictionaryType)
+{
+    const Type &keyType = dictionaryType.getKeyType();
+    BuiltinFunction dictionaryLen = {
+        FunctionIdentification(L"len", {dictionaryType}),
+        BuiltinFunctionDeclaration(
+            {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, dictionaryType, L"dictionary", false)}, {{INT}},
+            [](Position callPosition, const std::wstring &callSource,
+               std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+               ExecutionEnvironment &) -> std::optional<Object> {
+                size_t size = std::get<HashMap>(getObject(args[0]).value).size();
+                if(size > std::numeric_limits<int32_t>::max())
+                    throw IntegerRangeError(
+                        std::format(L"Dictionary size {} exceeds int type maximum value", size), callSource,
+                        callPosition
+                    );
+                return Object{{INT}, static_cast<int32_t>(size)};
+            }
+        )
+    };
+    BuiltinFunction dictionaryContains = {
+        FunctionIdentification(L"contains", {dictionaryType, keyType}),
+        BuiltinFunctionDeclaration(
+            {0, 0}, L"<builtins>",
+            {VariableDeclaration({0, 0}, dictionaryType, L"dictionary", false),
+             VariableDeclaration({0, 0}, keyType, L"key", false)},
+            {{BOOL}},
+            [](Position, const std::wstring &, std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+               ExecutionEnvironment &) -> std::optional<Object> {
+                const HashMap &entries = std::get<HashMap>(getObject(args[0]).value);
+                return Object{{BOOL}, entries.find(toHashMapKey(getObject(args[1]))) != nullptr};
+            }
+        )
+    };
+    BuiltinFunction dictionaryRemove = {
+        FunctionIdentification(L"remove", {dictionaryType, keyType}),
+        BuiltinFunctionDeclaration(
+            {0, 0}, L"<builtins>",
+            {VariableDeclaration({0, 0}, dictionaryType, L"dictionary", true),
+             VariableDeclaration({0, 0}, keyType, L"key", false)},
+            {{BOOL}},
+            [](Position, const std::wstring &, std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+               ExecutionEnvironment &) -> std::optional<Object> {
+                // the key may be a value of the dictionary itself, so it is converted before any entry is moved
+                HashMap::Key key = toHashMapKey(getObject(args[1]));
+                return Object{{BOOL}, std::get<HashMap>(getObject(args[0]).value).remove(key)};
+            }
+        )
+    };
+    BuiltinFunction dictionaryKeys = {
+        FunctionIdentification(L"keys", {dictionaryType}),
+        BuiltinFunctionDeclaration(
+            {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, dictionaryType, L"dictionary", false)},
+            {{Type::Array(keyType)}},
+            [keyType](Position, const std::wstring &,
+                      std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+                      ExecutionEnvironment &) -> std::optional<Object> {
+                std::vector<Object> keys;
+                std::get<HashMap>(getObject(args[0]).value).forEach([&](const HashMap::Key &key, const Object &) {
+                    keys.push_back(fromHashMapKey(key));
+                });
+                return Object{{Type::Array(keyType)}, std::move(keys)};
+            }
+        )
+    };
+    return {
+        std::move(dictionaryLen), std::move(dictionaryContains), std::move(dictionaryRemove), std::move(dictionaryKeys)
+    };
+}
+
+std::vector<BuiltinFunction> prepareTaskBuiltinFunctions(const Type &taskType)
+{
+    BuiltinFunction taskJoin = {
+        FunctionIdentification(L"join", {taskType}),
+        BuiltinFunctionDeclaration(
+            {0, 0}, L"<builtins>", {VariableDeclaration({0, 0}, taskType, L"task", false)}, taskType.getResultType(),
+            [](Position callPosition, const std::wstring &callSource,
+               std::vector<std::variant<Object, std::reference_wrapper<Object>>> &args,
+               ExecutionEnvironment &environment) -> std::optional<Object> {
+                SpawnedTask &task = *std::get<std::shared_ptr<SpawnedTask>>(getObject(args[0]).value);
+                Object result = task.join(environment.output);
+                if(environment.output.bad())
+                    throw StandardOutputError(L"Standard output stream returned error", callSource, callPosition);
+                return result;
+            }
+        )
+    };
+    return {std::move(taskJoin)};
+}
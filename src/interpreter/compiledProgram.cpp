@@ -0,0 +1,74 @@
+#include "compiledProgram.hpp"
+
+#include "builtinFunctions.hpp"
+#include "includeExecution.hpp"
+#include "runtimeExceptions.hpp"
+#include "semanticAnalysis.hpp"
+
+namespace {
+Program parseSourceFiles(
+    const std::vector<std::wstring> &sourceFiles, const std::function<Program(const std::wstring &)> &parseFromFile
+)
+{
+    Program program = parseFromFile(sourceFiles.at(0));
+    std::for_each(sourceFiles.begin() + 1, sourceFiles.end(), [&](const std::wstring &fileName) {
+        Program next = parseFromFile(fileName);
+        mergePrograms(program, next);
+    });
+    return program;
+}
+}
+
+CompiledProgram::CompiledProgram(
+    std::vector<std::wstring> sourceFiles, std::function<Program(const std::wstring &)> parseFromFile, Tracer *tracer
+):
+    CompiledProgram(parseSourceFiles(sourceFiles, parseFromFile), sourceFiles, parseFromFile, tracer)
+{}
+
+CompiledProgram::CompiledProgram(
+    Program parsed, std::vector<std::wstring> sourceFiles, std::function<Program(const std::wstring &)> parseFromFile,
+    Tracer *tracer
+):
+    sourceFiles(std::move(sourceFiles)), program(prepareBuiltinFunctions(parsed.getPosition()))
+{
+    mergePrograms(program, parsed);
+    {
+        Tracer::Span span(tracer, L"includes");
+        executeIncludes(program, this->sourceFiles, parseFromFile, tracer);
+    }
+    {
+        Tracer::Span span(tracer, L"semantic analysis");
+        pruned = doReachableSemanticAnalysis(program);
+    }
+    auto main = program.functions.find({L"main", {}});
+    if(main == program.functions.end())
+        throw MainNotFoundError(
+            L"main function has not been found in the program", this->sourceFiles.at(0), program.getPosition()
+        );
+    if(main->second->returnType)
+        throw MainReturnTypeError(
+            std::format(L"main function should not return a type, returns {}", *main->second->returnType),
+            main->second->getSource(), main->second->getPosition()
+        );
+}
+
+const Program &CompiledProgram::getProgram() const
+{
+    return program;
+}
+
+const std::vector<std::wstring> &CompiledProgram::getSourceFiles() const
+{
+    return sourceFiles;
+}
+
+const std::pair<const FunctionIdentification, std::unique_ptr<BaseFunctionDeclaration>> &CompiledProgram::getMain(
+) const
+{
+    return *program.functions.find({L"main", {}});
+}
+
+const PrunedDeclarations &CompiledProgram::getPruned() const
+{
+    return pruned;
+}
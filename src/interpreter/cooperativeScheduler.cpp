@@ -0,0 +1,248 @@
+#include "cooperativeScheduler.hpp"
+
+#include "execution.hpp"
+
+#include <cerrno>
+#include <system_error>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+// Instance whose fiber is being started by the worker running on this thread.
+thread_local CooperativeScheduler::Instance *startingInstance = nullptr;
+}
+
+CooperativeScheduler::FiberStack::FiberStack(size_t size): guardSize(sysconf(_SC_PAGESIZE))
+{
+    // the stack grows down, so the guard page is placed at the lowest address
+    size_t stackSize = (size + guardSize - 1) / guardSize * guardSize;
+    mappingSize = stackSize + guardSize;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK;
+    void *mapped = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if(mapped == MAP_FAILED)
+        throw std::system_error(errno, std::generic_category(), "Failed to allocate fiber stack");
+    mapping = static_cast<char *>(mapped);
+    if(mprotect(mapping, guardSize, PROT_NONE) == -1)
+    {
+        int error = errno;
+        munmap(mapping, mappingSize);
+        throw std::system_error(error, std::generic_category(), "Failed to protect fiber stack guard page");
+    }
+}
+
+CooperativeScheduler::FiberStack::~FiberStack()
+{
+    munmap(mapping, mappingSize);
+}
+
+char *CooperativeScheduler::FiberStack::getBottom() const
+{
+    return mapping + guardSize;
+}
+
+size_t CooperativeScheduler::FiberStack::getSize() const
+{
+    return mappingSize - guardSize;
+}
+
+CooperativeScheduler::Instance::InputBuffer::InputBuffer(Instance &instance): instance(instance) {}
+
+CooperativeScheduler::Instance::InputBuffer::int_type CooperativeScheduler::Instance::InputBuffer::underflow()
+{
+    if(gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+    std::unique_lock lock(instance.mutex);
+    while(instance.pendingInput.empty() && !instance.inputClosed)
+        instance.suspendForInput(lock);
+    if(instance.pendingInput.empty())
+        return traits_type::eof();
+    current = std::move(instance.pendingInput);
+    instance.pendingInput.clear();
+    setg(current.data(), current.data(), current.data() + current.size());
+    return traits_type::to_int_type(*gptr());
+}
+
+CooperativeScheduler::Instance::OutputBuffer::OutputBuffer(Instance &instance): instance(instance) {}
+
+CooperativeScheduler::Instance::OutputBuffer::int_type CooperativeScheduler::Instance::OutputBuffer::overflow(
+    int_type character
+)
+{
+    if(traits_type::eq_int_type(character, traits_type::eof()))
+        return traits_type::not_eof(character);
+    std::lock_guard lock(instance.mutex);
+    instance.output.push_back(traits_type::to_char_type(character));
+    return character;
+}
+
+std::streamsize CooperativeScheduler::Instance::OutputBuffer::xsputn(const wchar_t *characters, std::streamsize count)
+{
+    std::lock_guard lock(instance.mutex);
+    instance.output.append(characters, count);
+    return count;
+}
+
+CooperativeScheduler::Instance::Instance(
+    const CompiledProgram &program, std::vector<std::wstring> arguments, ExecutionLimits limits, Worker &worker,
+    size_t stackSize
+):
+    program(program), arguments(std::move(arguments)), limits(limits), worker(worker), stack(stackSize),
+    inputClosed(false), waitingForInput(false), finished(false), inputBuffer(*this), outputBuffer(*this)
+{
+    if(getcontext(&context) == -1)
+        throw std::system_error(errno, std::generic_category(), "Failed to create execution context");
+    context.uc_stack.ss_sp = stack.getBottom();
+    context.uc_stack.ss_size = stack.getSize();
+    // the fiber returns to the worker when the execution finishes
+    context.uc_link = &worker.context;
+    makecontext(&context, runFiber, 0);
+}
+
+void CooperativeScheduler::Instance::runFiber()
+{
+    Instance &instance = *startingInstance;
+    std::exception_ptr error;
+    {
+        std::wistream input(&instance.inputBuffer);
+        std::wostream output(&instance.outputBuffer);
+        // exceptions must not leave the fiber, as it has no caller to unwind to
+        try
+        {
+            Execution execution(
+                instance.program, instance.arguments, input, output, Interpreter::DEFAULT_MAX_STACK_SIZE, nullptr,
+                nullptr, nullptr, instance.limits
+            );
+            execution.run();
+        }
+        catch(...)
+        {
+            error = std::current_exception();
+        }
+    }
+    std::lock_guard lock(instance.mutex);
+    instance.error = error;
+    instance.finished = true;
+    instance.finishedChanged.notify_all();
+}
+
+void CooperativeScheduler::Instance::suspendForInput(std::unique_lock<std::mutex> &lock)
+{
+    // the instance is only made ready again by its own worker, which is busy until the switch below completes
+    waitingForInput = true;
+    lock.unlock();
+    swapcontext(&context, &worker.context);
+    lock.lock();
+}
+
+void CooperativeScheduler::Instance::provideInput(const std::wstring &input)
+{
+    std::unique_lock lock(mutex);
+    pendingInput += input;
+    bool resume = waitingForInput;
+    waitingForInput = false;
+    lock.unlock();
+    if(resume)
+        worker.makeReady(*this);
+}
+
+void CooperativeScheduler::Instance::closeInput()
+{
+    std::unique_lock lock(mutex);
+    inputClosed = true;
+    bool resume = waitingForInput;
+    waitingForInput = false;
+    lock.unlock();
+    if(resume)
+        worker.makeReady(*this);
+}
+
+std::wstring CooperativeScheduler::Instance::takeOutput()
+{
+    std::lock_guard lock(mutex);
+    std::wstring taken = std::move(output);
+    output.clear();
+    return taken;
+}
+
+bool CooperativeScheduler::Instance::isFinished()
+{
+    std::lock_guard lock(mutex);
+    return finished;
+}
+
+void CooperativeScheduler::Instance::wait()
+{
+    std::unique_lock lock(mutex);
+    finishedChanged.wait(lock, [&] { return finished; });
+    if(error)
+        std::rethrow_exception(error);
+}
+
+void CooperativeScheduler::Worker::run()
+{
+    while(true)
+    {
+        Instance *instance;
+        {
+            std::unique_lock lock(mutex);
+            readyChanged.wait(lock, [&] { return !ready.empty() || stopping; });
+            if(ready.empty())
+                return;
+            instance = ready.front();
+            ready.pop_front();
+        }
+        startingInstance = instance;
+        // returns when the instance is suspended or finishes
+        swapcontext(&context, &instance->context);
+    }
+}
+
+void CooperativeScheduler::Worker::makeReady(Instance &instance)
+{
+    std::lock_guard lock(mutex);
+    ready.push_back(&instance);
+    readyChanged.notify_one();
+}
+
+CooperativeScheduler::CooperativeScheduler(unsigned threads, size_t stackSize): stackSize(stackSize)
+{
+    for(unsigned i = 0; i < threads; i++)
+    {
+        Worker &worker = *workers.emplace_back(std::make_unique<Worker>());
+        worker.thread = std::jthread([&worker] { worker.run(); });
+    }
+}
+
+CooperativeScheduler::~CooperativeScheduler()
+{
+    std::lock_guard lock(instancesMutex);
+    for(auto &instance: instances)
+        instance->closeInput();
+    for(auto &instance: instances)
+    {
+        std::unique_lock instanceLock(instance->mutex);
+        instance->finishedChanged.wait(instanceLock, [&] { return instance->finished; });
+    }
+    for(auto &worker: workers)
+    {
+        std::lock_guard workerLock(worker->mutex);
+        worker->stopping = true;
+        worker->readyChanged.notify_one();
+    }
+    // joins the worker threads before the instances, whose stacks they may still be leaving
+    workers.clear();
+}
+
+CooperativeScheduler::Instance &CooperativeScheduler::start(
+    const CompiledProgram &program, std::vector<std::wstring> arguments, ExecutionLimits limits
+)
+{
+    std::lock_guard lock(instancesMutex);
+    Worker &worker = *workers[instances.size() % workers.size()];
+    // the constructor is private, so std::make_unique cannot be used
+    std::unique_ptr<Instance> created(new Instance(program, std::move(arguments), limits, worker, stackSize));
+    Instance &instance = *instances.emplace_back(std::move(created));
+    worker.makeReady(instance);
+    return instance;
+}
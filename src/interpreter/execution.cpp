@@ -0,0 +1,16 @@
+#include "execution.hpp"
+
+Execution::Execution(
+    const CompiledProgram &program, std::vector<std::wstring> arguments, std::wistream &input, std::wostream &output,
+    unsigned maxStackSize, Profiler *profiler, SamplingProfiler *sampler, Tracer *tracer,
+    ExecutionLimits limits
+):
+    program(program), arguments(std::move(arguments)), input(input), output(output), maxStackSize(maxStackSize),
+    profiler(profiler), sampler(sampler), tracer(tracer), limits(limits)
+{}
+
+void Execution::run()
+{
+    Interpreter interpreter(arguments, input, output, maxStackSize, profiler, sampler, tracer, limits);
+    interpreter.execute(program);
+}
@@ -1,16 +1,34 @@
+#ifndef BUILTINFUNCTIONS_HPP
+#define BUILTINFUNCTIONS_HPP
+
 #include "documentTree.hpp"
 
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+struct ExecutionEnvironment
+{
+    const std::vector<std::wstring> &arguments;
+    std::wistream &input;
+    std::wostream &output;
+};
+
 typedef std::pair<FunctionIdentification, BuiltinFunctionDeclaration> BuiltinFunction;
 
-BuiltinFunction builtinNoArguments(const std::vector<std::wstring> &arguments);
-BuiltinFunction builtinArgument(const std::vector<std::wstring> &arguments);
-BuiltinFunction builtinPrint(std::wostream &output);
-BuiltinFunction builtinPrintln(std::wostream &output);
-BuiltinFunction builtinInputLine(std::wistream &input);
-BuiltinFunction builtinInput(std::wistream &input);
-extern const BuiltinFunction builtinLen, builtinAbsFloat, builtinAbsInt, builtinMaxFloat, builtinMaxInt,
-    builtinMinFloat, builtinMinInt;
+extern const BuiltinFunction builtinNoArguments, builtinArgument, builtinPrint, builtinPrintln, builtinInputLine,
+    builtinInput, builtinLen, builtinSubstr, builtinFind, builtinStartsWith, builtinSplit, builtinTrim, builtinAbsFloat,
+    builtinAbsInt, builtinMaxFloat, builtinMaxInt, builtinMinFloat, builtinMinInt;
+
+Program prepareBuiltinFunctions(Position programPosition);
+// Returns the builtin functions taking an array of the given type as the first argument - len and append. They are
+// added to the program by semantic analysis when they are called.
+std::vector<BuiltinFunction> prepareArrayBuiltinFunctions(const Type &arrayType);
+// Returns the builtin functions taking a dictionary of the given type as the first argument - len, contains, remove and
+// keys, added to the program in the same way.
+std::vector<BuiltinFunction> prepareDictionaryBuiltinFunctions(const Type &dictionaryType);
+// Returns the builtin function join taking a task of the given type, added to the program in the same way.
+std::vector<BuiltinFunction> prepareTaskBuiltinFunctions(const Type &taskType);
 
-Program prepareBuiltinFunctions(
-    Position programPosition, const std::vector<std::wstring> &arguments, std::wistream &input, std::wostream &output
-);
+#endif
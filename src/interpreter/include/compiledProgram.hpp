@@ -0,0 +1,42 @@
+#ifndef COMPILEDPROGRAM_HPP
+#define COMPILEDPROGRAM_HPP
+
+#include "documentTree.hpp"
+#include "reachability.hpp"
+#include "tracer.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// Program with the builtin functions and the included files merged in and with semantic analysis done, ready to be
+// executed any number of times. Executions do not modify it, so it can be analyzed once and shared between them. The
+// functions and types unreachable from main are removed before the analysis.
+class CompiledProgram
+{
+public:
+    // Parses the source files with parseFromFile and compiles them into one program.
+    CompiledProgram(
+        std::vector<std::wstring> sourceFiles, std::function<Program(const std::wstring &)> parseFromFile,
+        Tracer *tracer = nullptr
+    );
+    // Compiles the program parsed from the source files. The files included by it are parsed with parseFromFile.
+    CompiledProgram(
+        Program program, std::vector<std::wstring> sourceFiles,
+        std::function<Program(const std::wstring &)> parseFromFile, Tracer *tracer = nullptr
+    );
+    CompiledProgram(const CompiledProgram &) = delete;
+    CompiledProgram(CompiledProgram &&) = default;
+
+    const Program &getProgram() const;
+    // Returns the source files together with all the files they include.
+    const std::vector<std::wstring> &getSourceFiles() const;
+    const std::pair<const FunctionIdentification, std::unique_ptr<BaseFunctionDeclaration>> &getMain() const;
+    const PrunedDeclarations &getPruned() const;
+private:
+    std::vector<std::wstring> sourceFiles;
+    Program program;
+    PrunedDeclarations pruned;
+};
+
+#endif
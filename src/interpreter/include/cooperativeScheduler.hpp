@@ -0,0 +1,135 @@
+#ifndef COOPERATIVESCHEDULER_HPP
+#define COOPERATIVESCHEDULER_HPP
+
+#include "compiledProgram.hpp"
+#include "executionLimits.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ucontext.h>
+
+// Runs many executions of compiled programs on a small number of threads. An execution reading standard input that has
+// not been provided yet is suspended, and its thread runs other executions in the meantime. As the interpreter keeps
+// the state of the executed program on the native stack, every execution runs on its own stack (a fiber), which is
+// only committed by the operating system as it is used. A guard page below every stack makes its overflow fault
+// instead of overwriting other memory.
+class CooperativeScheduler
+{
+    struct Worker;
+public:
+    static const size_t DEFAULT_STACK_SIZE = 4 * 1024 * 1024;
+
+    // Memory mapped stack of a fiber, with an inaccessible guard page below it.
+    class FiberStack
+    {
+    public:
+        explicit FiberStack(size_t size);
+        FiberStack(const FiberStack &) = delete;
+        ~FiberStack();
+        // Returns the lowest address of the usable stack, above the guard page.
+        char *getBottom() const;
+        size_t getSize() const;
+    private:
+        char *mapping;
+        size_t mappingSize, guardSize;
+    };
+
+    // Execution started by the scheduler. It has its own standard input, fed with provideInput, and its own buffered
+    // standard output.
+    class Instance
+    {
+    public:
+        Instance(const Instance &) = delete;
+        void provideInput(const std::wstring &input);
+        // Makes the input end after the data provided so far.
+        void closeInput();
+        // Returns the output written since the last call.
+        std::wstring takeOutput();
+        bool isFinished();
+        // Waits for the execution to finish and rethrows the error that terminated it, if any.
+        void wait();
+    private:
+        friend class CooperativeScheduler;
+
+        class InputBuffer: public std::wstreambuf
+        {
+        public:
+            explicit InputBuffer(Instance &instance);
+        protected:
+            int_type underflow() override;
+        private:
+            Instance &instance;
+            std::wstring current;
+        };
+
+        class OutputBuffer: public std::wstreambuf
+        {
+        public:
+            explicit OutputBuffer(Instance &instance);
+        protected:
+            int_type overflow(int_type character) override;
+            std::streamsize xsputn(const wchar_t *characters, std::streamsize count) override;
+        private:
+            Instance &instance;
+        };
+
+        Instance(
+            const CompiledProgram &program, std::vector<std::wstring> arguments, ExecutionLimits limits, Worker &worker,
+            size_t stackSize
+        );
+        static void runFiber();
+        // Switches back to the worker until more input is provided. Called with the lock held.
+        void suspendForInput(std::unique_lock<std::mutex> &lock);
+
+        const CompiledProgram &program;
+        std::vector<std::wstring> arguments;
+        ExecutionLimits limits;
+        Worker &worker;
+        FiberStack stack;
+        ucontext_t context;
+        std::mutex mutex;
+        std::condition_variable finishedChanged;
+        std::wstring pendingInput, output;
+        bool inputClosed, waitingForInput, finished;
+        std::exception_ptr error;
+        InputBuffer inputBuffer;
+        OutputBuffer outputBuffer;
+    };
+
+    CooperativeScheduler(unsigned threads, size_t stackSize = DEFAULT_STACK_SIZE);
+    CooperativeScheduler(const CooperativeScheduler &) = delete;
+    // Closes the input of all the instances and waits for them to finish.
+    ~CooperativeScheduler();
+    // Starts the execution of the main function of the program, which has to outlive the instance. The instance is
+    // owned by the scheduler.
+    Instance &start(const CompiledProgram &program, std::vector<std::wstring> arguments, ExecutionLimits limits = {});
+private:
+    // Every instance is resumed by the same worker thread, so that no fiber migrates between threads.
+    struct Worker
+    {
+        std::mutex mutex;
+        std::condition_variable readyChanged;
+        std::deque<Instance *> ready;
+        bool stopping = false;
+        ucontext_t context;
+        std::jthread thread;
+
+        void run();
+        void makeReady(Instance &instance);
+    };
+
+    size_t stackSize;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::mutex instancesMutex;
+    std::vector<std::unique_ptr<Instance>> instances;
+};
+
+#endif
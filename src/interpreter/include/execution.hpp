@@ -0,0 +1,38 @@
+#ifndef EXECUTION_HPP
+#define EXECUTION_HPP
+
+#include "compiledProgram.hpp"
+#include "interpreter.hpp"
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Run of the main function of a compiled program with its own program arguments and standard streams. The compiled
+// program is not copied and has to outlive the execution. Executions of one compiled program may run concurrently in
+// different threads, as long as they do not share the streams, profilers or tracer.
+class Execution
+{
+public:
+    Execution(
+        const CompiledProgram &program, std::vector<std::wstring> arguments, std::wistream &input,
+        std::wostream &output, unsigned maxStackSize = Interpreter::DEFAULT_MAX_STACK_SIZE,
+        Profiler *profiler = nullptr, SamplingProfiler *sampler = nullptr, Tracer *tracer = nullptr,
+        ExecutionLimits limits = {}
+    );
+    // Runs the main function, using a new interpreter state each time.
+    void run();
+private:
+    const CompiledProgram &program;
+    std::vector<std::wstring> arguments;
+    std::wistream &input;
+    std::wostream &output;
+    unsigned maxStackSize;
+    Profiler *profiler;
+    SamplingProfiler *sampler;
+    Tracer *tracer;
+    ExecutionLimits limits;
+};
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef EXECUTIONLIMITS_HPP
+#define EXECUTIONLIMITS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+// Budgets of a single execution of a program. An execution exceeding any of them is terminated with an
+// ExecutionLimitError. Unset budgets are not enforced.
+struct ExecutionLimits
+{
+    // Number of executed instructions. Every iteration of a loop also counts as an instruction.
+    std::optional<unsigned long long> maxInstructions;
+    // Wall-clock time of the execution.
+    std::optional<std::chrono::nanoseconds> maxTime;
+    // Bytes of heap memory held by the values of variables, function arguments and results, and by strings being
+    // created. It is measured periodically, so it may be exceeded briefly by values that are not strings.
+    std::optional<size_t> maxHeapBytes;
+};
+
+// State of the budgets of an execution, shared by the interpreters of the execution and of all the tasks it spawns, so
+// that the limits apply to all of them together.
+struct ExecutionBudget
+{
+    explicit ExecutionBudget(ExecutionLimits limits):
+        limits(limits), startTime(std::chrono::steady_clock::now()), executedInstructions(0), heapBytes(0)
+    {}
+
+    const ExecutionLimits limits;
+    const std::chrono::steady_clock::time_point startTime;
+    std::atomic<unsigned long long> executedInstructions;
+    // Sum of the heap memory last measured by each of the interpreters.
+    std::atomic<size_t> heapBytes;
+};
+
+#endif
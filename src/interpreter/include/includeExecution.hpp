@@ -1,6 +1,8 @@
 #include "documentTree.hpp"
+#include "tracer.hpp"
 
 void executeIncludes(
-    Program &program, std::vector<std::wstring> &sourceFiles, std::function<Program(const std::wstring &)> parseFromFile
+    Program &program, std::vector<std::wstring> &sourceFiles,
+    std::function<Program(const std::wstring &)> parseFromFile, Tracer *tracer = nullptr
 );
 void mergePrograms(Program &program, Program &toAdd);
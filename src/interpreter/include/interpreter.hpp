@@ -1,37 +1,118 @@
+#ifndef INTERPRETER_HPP
+#define INTERPRETER_HPP
+
+#include "builtinFunctions.hpp"
+#include "compiledProgram.hpp"
 #include "documentTree.hpp"
 #include "documentTreeVisitor.hpp"
+#include "executionLimits.hpp"
+#include "profiler.hpp"
+#include "samplingProfiler.hpp"
+#include "spawnedTask.hpp"
+#include "tracer.hpp"
 
+#include <chrono>
+#include <deque>
 #include <functional>
 #include <iostream>
-#include <stack>
+#include <limits>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
 class Interpreter: public DocumentTreeVisitor
 {
 public:
+    static const unsigned DEFAULT_MAX_STACK_SIZE = 200;
+
+    // Creates an interpreter that can only execute already compiled programs.
+    Interpreter(
+        std::vector<std::wstring> arguments, std::wistream &input, std::wostream &output,
+        unsigned maxStackSize = DEFAULT_MAX_STACK_SIZE, Profiler *profiler = nullptr,
+        SamplingProfiler *sampler = nullptr, Tracer *tracer = nullptr, ExecutionLimits limits = {}
+    );
+    // Creates an interpreter that also compiles the programs it visits, parsing included files with parseFromFile.
     Interpreter(
         std::vector<std::wstring> &sourceFiles, std::vector<std::wstring> arguments, std::wistream &input,
-        std::wostream &output, std::function<Program(const std::wstring &)> parseFromFile, unsigned maxStackSize = 200
+        std::wostream &output, std::function<Program(const std::wstring &)> parseFromFile,
+        unsigned maxStackSize = DEFAULT_MAX_STACK_SIZE, Profiler *profiler = nullptr,
+        SamplingProfiler *sampler = nullptr, Tracer *tracer = nullptr, ExecutionLimits limits = {}
     );
+    // Waits for the spawned tasks which have not finished.
+    ~Interpreter() override;
+    // Compiles and executes the program.
     void visit(Program &visited) override;
+    void execute(const CompiledProgram &compiled);
+    // Executes analyzed instructions outside of any function. The variables they declare are kept for the next executed
+    // instructions, unless a runtime error occurs. The execution limits apply to each call separately.
+    void executeInstructions(
+        const Program &program, std::vector<std::unique_ptr<Instruction>> &instructions, const std::wstring &source
+    );
+    // Executes a spawned function call with the given arguments and returns its result. The call uses the budgets of
+    // the execution which spawned it and stops when its task is cancelled.
+    Object executeSpawned(
+        const Program &program, const FunctionIdentification &id, BaseFunctionDeclaration &function,
+        std::vector<Object> arguments, std::shared_ptr<ExecutionBudget> budget, std::shared_ptr<SpawnedTask> task
+    );
 private:
+    // Number of spawned tasks above which the joined ones are forgotten. It grows with the number of tasks left.
+    static constexpr size_t MIN_TASK_PRUNE_THRESHOLD = 64;
+
     Position callPosition;
-    std::vector<std::wstring> &sourceFiles;
+    // Set to nullptr when the interpreter does not compile programs.
+    std::vector<std::wstring> *sourceFiles;
     std::wstring currentSource;
     std::vector<std::wstring> arguments;
-    std::wistream &input;
-    std::wostream &output;
+    ExecutionEnvironment environment;
     std::function<Program(const std::wstring &)> parseFromFile;
     std::variant<Object, std::reference_wrapper<Object>> lastResult;
     // Each element of stack corresponds to a called function. Each vector corresponds to a scope in the function.
-    std::stack<std::vector<std::unordered_map<std::wstring, std::variant<Object, std::reference_wrapper<Object>>>>>
+    std::deque<std::vector<std::unordered_map<std::wstring, std::variant<Object, std::reference_wrapper<Object>>>>>
         variables;
-    Program *program;
+    // Shared by all executions of the compiled program, so it must only be read.
+    const Program *program;
     std::vector<std::variant<Object, std::reference_wrapper<Object>>> functionArguments;
     // Flags that are set when the current block should be interrupted.
     bool shouldReturn, shouldContinue, shouldBreak;
     const unsigned maxStackSize;
+    // Set to nullptr when profiling is disabled.
+    Profiler *profiler;
+    SamplingProfiler *sampler;
+    Tracer *tracer;
+    ExecutionLimits limits;
+    // Tasks spawned by the executed code. The ones which have not been joined are joined when the execution ends, so
+    // that their output and errors are reported.
+    std::vector<std::shared_ptr<SpawnedTask>> spawnedTasks;
+    size_t taskPruneThreshold;
+    // Task whose call is executed by the interpreter. Set to nullptr when the interpreter does not execute a task.
+    std::shared_ptr<SpawnedTask> task;
+    // Shared with the interpreters of the spawned tasks. Set to nullptr before the first execution.
+    std::shared_ptr<ExecutionBudget> budget;
+    // The budgets are only checked when the number of instructions executed by this interpreter reaches
+    // nextBudgetCheck, which is the nearest of the next checks of the instruction count, time, heap memory and
+    // cancellation of the task. The instructions are added to the shared count in batches, at the checks.
+    unsigned long long executedInstructions, reportedInstructions, nextBudgetCheck, nextInstructionCheck,
+        nextTimeCheck, nextHeapCheck, nextCancellationCheck;
+    // Part of the shared heap memory measured by this interpreter.
+    size_t measuredHeapBytes;
+
+    // Starts the budgets of a new execution with the limits of the interpreter.
+    void startBudgets();
+    void startBudgets(std::shared_ptr<ExecutionBudget> shared);
+    void countInstruction(Position position)
+    {
+        if(++executedInstructions >= nextBudgetCheck)
+            checkBudgets(position);
+    }
+    void checkBudgets(Position position);
+    // Adds the instructions executed since the last report to the shared count and returns the total, unless it exceeds
+    // the limit.
+    unsigned long long reportInstructions(Position position);
+    // Checks whether a string of the given length can be created within the heap memory budget.
+    void checkStringAllocation(size_t length, Position position);
+    // Returns the heap memory held by the values reachable by the interpreter and the number of values visited.
+    std::pair<size_t, unsigned long long> measureHeap() const;
 
     Object &getVariable(const std::wstring &name);
     void addVariable(const std::wstring &name, Object &&object);
@@ -65,9 +146,37 @@ private:
     template <typename BinaryOperation>
     void doComparison(BinaryOperation &visited, auto compare);
 
-    std::vector<Type> prepareArguments(FunctionCall &visited);
-    void visitInstructionBlock(std::vector<std::unique_ptr<Instruction>> &block);
+    Object &getArrayElement(Object &array, int32_t index, Position position);
+    Object &getDictionaryValue(Object &dictionary, const Object &key, Position position);
+    void buildDictionary(StructExpression &visited);
+    void evaluateAssignableIndexes(Assignable &visited, std::vector<Object> &indexes);
+    // The value assigned to a missing key of a dictionary is inserted into it.
+    Object &resolveAssignable(Assignable &visited, std::vector<Object>::const_iterator &nextIndex, bool isAssigned);
+
+    // Copy of a part of a variable passed as a mutable argument, assigned back to it after the call.
+    struct WrittenBackArgument
+    {
+        unsigned argumentIndex;
+        // indexes of the subscripts leading to the part, evaluated once before the call
+        std::vector<Object> indexes;
+        Object value;
+    };
+
+    void evaluateElementIndexes(Expression &element, std::vector<Object> &indexes);
+    // Resolves a variable, or an element or field of it, like resolveAssignable.
+    Object &resolveElement(Expression &element, std::vector<Object>::const_iterator &nextIndex, bool isAssigned);
+    std::vector<Type> prepareArguments(FunctionCall &visited, std::vector<WrittenBackArgument> &writtenBack);
+    // Evaluates the arguments of the call and returns the function it resolves to. The arguments written back after
+    // the call refer to the copies in writtenBack.
+    const std::pair<const FunctionIdentification, std::unique_ptr<BaseFunctionDeclaration>> &resolveCall(
+        FunctionCall &visited, std::vector<WrittenBackArgument> &writtenBack
+    );
+    void callFunction(const FunctionIdentification &id, BaseFunctionDeclaration &function, Position callPosition);
+    void visitInstructionBlock(std::span<std::unique_ptr<Instruction>> block);
     void visitInstructionScope(std::vector<std::unique_ptr<Instruction>> &block);
+    void finishSpawnedTasks();
+    // Cancels the spawned tasks, waits for them and forgets them, discarding their results, output and errors.
+    void abandonSpawnedTasks();
 
     void visit(Literal &visited) override;
     void visit(Variable &visited) override;
@@ -104,12 +213,16 @@ private:
     void visit(AssignmentStatement &visited) override;
     void visit(FunctionCall &visited) override;
     void visit(FunctionCallInstruction &visited) override;
+    void visit(SpawnExpression &visited) override;
     void visit(ReturnStatement &visited) override;
     void visit(ContinueStatement &visited) override;
     void visit(BreakStatement &visited) override;
     void visit(SingleIfCase &visited) override;
     void visit(IfStatement &visited) override;
     void visit(WhileStatement &visited) override;
+    // Executes a counted loop keeping the counter in place. Returns false without executing anything when the
+    // increment could overflow, in which case the loop has to be executed as any other one.
+    bool executeCountedLoop(WhileStatement &visited, const CountedLoop &loop);
     void visit(DoWhileStatement &visited) override;
     void visit(Field &visited) override;
     void visit(StructDeclaration &visited) override;
@@ -118,3 +231,5 @@ private:
     void visit(BuiltinFunctionDeclaration &visited) override;
     void visit(IncludeStatement &visited) override;
 };
+
+#endif
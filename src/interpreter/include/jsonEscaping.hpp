@@ -0,0 +1,9 @@
+#ifndef JSONESCAPING_HPP
+#define JSONESCAPING_HPP
+
+#include <string>
+
+// Escapes the string so that it can be placed between quotes in a JSON document.
+std::wstring escapeJsonString(const std::wstring &string);
+
+#endif
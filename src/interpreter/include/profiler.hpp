@@ -0,0 +1,63 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include "documentTree.hpp"
+
+#include <chrono>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+// Records call counts and wall times of functions called by the Interpreter.
+class Profiler
+{
+public:
+    struct FunctionProfile
+    {
+        FunctionIdentification id;
+        unsigned long long calls;
+        // Time spent in the function, including the functions it called. Recursive calls are counted once.
+        std::chrono::nanoseconds inclusiveTime;
+        // Time spent in the function itself, excluding the functions it called.
+        std::chrono::nanoseconds exclusiveTime;
+    };
+
+    // Ends the call of the function on destruction, so that the profile stays consistent when an exception is thrown.
+    class CallGuard
+    {
+    public:
+        CallGuard(Profiler &profiler, const FunctionIdentification &id);
+        CallGuard(const CallGuard &) = delete;
+        ~CallGuard();
+    private:
+        Profiler &profiler;
+    };
+
+    // The id must stay alive at the same address until the profiled program ends; it is used as key.
+    void enterFunction(const FunctionIdentification &id);
+    void exitFunction();
+    // Returns the profiles sorted by exclusive time, longest first.
+    std::vector<FunctionProfile> getProfiles() const;
+    void printReport(std::wostream &out) const;
+    void writeJson(std::wostream &out) const;
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry
+    {
+        FunctionProfile profile;
+        unsigned activeCalls;
+    };
+
+    struct Frame
+    {
+        Entry *entry;
+        Clock::time_point start;
+        Clock::duration childrenTime;
+    };
+
+    std::unordered_map<const FunctionIdentification *, Entry> entries;
+    std::vector<Frame> callStack;
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef REACHABILITY_HPP
+#define REACHABILITY_HPP
+
+#include "documentTree.hpp"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Declarations removed from a program, as main cannot reach them. Sorted by name.
+struct PrunedDeclarations
+{
+    std::vector<FunctionIdentification> functions;
+    std::vector<std::wstring> structs;
+    std::vector<std::wstring> variants;
+    void printReport(std::wostream &out) const;
+};
+
+// Removes the functions, structs and variants whose names are not referenced from main, directly or through other
+// kept declarations. A referenced function name keeps all its overloads, as the called overload is chosen only by
+// semantic analysis, or at runtime. Nothing is removed from a program without main. The skipped bodies of the kept
+// functions are parsed.
+PrunedDeclarations pruneUnreachable(Program &program);
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef REPLSESSION_HPP
+#define REPLSESSION_HPP
+
+#include "interpreter.hpp"
+#include "parser.hpp"
+#include "semanticAnalysis.hpp"
+
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// State of the REPL: a program growing by the declarations entered, analyzed incrementally, and the variables of the
+// instructions entered, which are executed at once.
+class ReplSession
+{
+public:
+    // Compiles the program loaded from the source files, without requiring or executing its main function. The
+    // files included later are parsed with parseFromFile.
+    ReplSession(
+        Program program, std::vector<std::wstring> sourceFiles,
+        std::function<Program(const std::wstring &)> parseFromFile, std::vector<std::wstring> arguments,
+        std::wistream &input, std::wostream &output, ExecutionLimits limits = {}
+    );
+    ReplSession(const ReplSession &) = delete;
+    // Adds the declarations of the entry to the program and executes its instructions. The execution limits apply to
+    // the instructions of each entry separately. An entry with an error in its
+    // includes or semantics has no effect. A runtime error keeps the effects of the instructions executed before it,
+    // apart from the variables they declared.
+    void enter(ReplEntry entry, const std::wstring &source);
+    const IncrementalSemanticAnalysis &getAnalysis() const;
+private:
+    std::vector<std::wstring> sourceFiles;
+    std::function<Program(const std::wstring &)> parseFromFile;
+    Program program;
+    IncrementalSemanticAnalysis analysis;
+    Interpreter interpreter;
+};
+
+#endif
@@ -30,6 +30,8 @@ DECLARE_RUNTIME_ERROR(CastImpossibleError);
 DECLARE_RUNTIME_ERROR(OperatorArgumentError);
 DECLARE_RUNTIME_ERROR(ZeroDivisionError);
 DECLARE_RUNTIME_ERROR(StackOverflowError);
+DECLARE_RUNTIME_ERROR(ExecutionLimitError);
+DECLARE_RUNTIME_ERROR(TaskCancelledError);
 
 class RuntimeSemanticException: public std::runtime_error
 {
@@ -0,0 +1,72 @@
+#ifndef SAMPLINGPROFILER_HPP
+#define SAMPLINGPROFILER_HPP
+
+#include "documentTree.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+// Periodically samples the script-level call stack of the Interpreter. A sampler thread only requests samples; the
+// interpreter takes them itself at the next safe point (an instruction or a function return), so that the call stack
+// is never read while it is being modified.
+class SamplingProfiler
+{
+public:
+    // Pushes the called function on the sampled call stack and pops it on destruction.
+    class CallGuard
+    {
+    public:
+        CallGuard(
+            SamplingProfiler &profiler, const FunctionIdentification &id, const BaseFunctionDeclaration &function,
+            Position callPosition
+        );
+        CallGuard(const CallGuard &) = delete;
+        ~CallGuard();
+    private:
+        SamplingProfiler &profiler;
+    };
+
+    // Starts the sampler thread.
+    explicit SamplingProfiler(unsigned frequency);
+    SamplingProfiler(const SamplingProfiler &) = delete;
+    // The id and function must stay alive at the same addresses until the function is exited.
+    void enterFunction(
+        const FunctionIdentification &id, const BaseFunctionDeclaration &function, Position callPosition
+    );
+    void exitFunction();
+
+    // Called at safe points of execution.
+    void takePendingSamples()
+    {
+        if(pendingSamples.load(std::memory_order_relaxed) != 0)
+            recordSamples();
+    }
+
+    // Writes the samples in the folded stack format read by flame graph tools: one line per distinct call stack, with
+    // frames separated by semicolons, followed by the number of samples.
+    void writeFoldedStacks(std::wostream &out) const;
+private:
+    struct Frame
+    {
+        const FunctionIdentification *id;
+        const BaseFunctionDeclaration *function;
+        Position callPosition;
+    };
+
+    std::vector<Frame> callStack;
+    std::map<std::wstring, unsigned long long> foldedStacks;
+    std::atomic<unsigned> pendingSamples;
+    std::mutex samplerMutex;
+    std::condition_variable_any samplerWakeup;
+    std::jthread sampler;
+
+    void recordSamples();
+    std::wstring foldCallStack() const;
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef SCOPEDSYMBOLTABLE_HPP
+#define SCOPEDSYMBOLTABLE_HPP
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Maps names to the values declared in the innermost scope declaring them. All visible names are kept in a single hash
+// table, and a declaration hiding the value of an outer scope saves it in an undo log, which is replayed when the scope
+// is exited. A lookup therefore does not depend on the number of scopes, and exiting a scope takes time proportional to
+// the number of its declarations.
+template <typename Value>
+class ScopedSymbolTable
+{
+public:
+    // Sets the values of the outermost scope, discarding all scopes.
+    void reset(std::unordered_map<std::wstring, Value> outermost = {})
+    {
+        symbols = std::move(outermost);
+        undoLog.clear();
+        scopeBegins.clear();
+    }
+
+    void enterScope()
+    {
+        scopeBegins.push_back(undoLog.size());
+    }
+
+    void exitScope()
+    {
+        size_t begin = scopeBegins.back();
+        scopeBegins.pop_back();
+        while(undoLog.size() > begin)
+        {
+            auto &[name, previous] = undoLog.back();
+            if(previous)
+                symbols.insert_or_assign(std::move(name), std::move(*previous));
+            else
+                symbols.erase(name);
+            undoLog.pop_back();
+        }
+    }
+
+    void declare(const std::wstring &name, Value value)
+    {
+        // declarations in the outermost scope are never undone
+        bool isUndone = !scopeBegins.empty();
+        auto [found, inserted] = symbols.try_emplace(name, std::move(value));
+        if(inserted)
+        {
+            if(isUndone)
+                undoLog.emplace_back(name, std::nullopt);
+            return;
+        }
+        if(isUndone)
+            undoLog.emplace_back(name, std::move(found->second));
+        found->second = std::move(value);
+    }
+
+    // Returns nullptr if the name is not declared in any scope.
+    const Value *find(const std::wstring &name) const
+    {
+        auto found = symbols.find(name);
+        return found != symbols.end() ? &found->second : nullptr;
+    }
+
+    // Returns the values of all visible names, which are the values of the outermost scope when no scope is entered.
+    const std::unordered_map<std::wstring, Value> &getVisible() const
+    {
+        return symbols;
+    }
+private:
+    std::unordered_map<std::wstring, Value> symbols;
+    // name declared in a scope and its value from the enclosing scopes, if there was one
+    std::vector<std::pair<std::wstring, std::optional<Value>>> undoLog;
+    // sizes of the undo log when the entered scopes began
+    std::vector<size_t> scopeBegins;
+};
+
+#endif
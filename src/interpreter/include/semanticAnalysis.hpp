@@ -3,8 +3,48 @@
 
 #include "documentTree.hpp"
 #include "documentTreeVisitor.hpp"
+#include "reachability.hpp"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Functions calling each function name.
+using CallerIndex = std::unordered_map<std::wstring, std::unordered_set<FunctionIdentification>>;
 
 Type::Builtin getTargetTypeForEquality(Type::Builtin leftType, Type::Builtin rightType);
 void doSemanticAnalysis(Program &program);
+// Removes the declarations unreachable from main with pruneUnreachable and analyzes the rest of the program. Names of
+// all the declarations are checked for collisions first.
+PrunedDeclarations doReachableSemanticAnalysis(Program &program);
+
+// Semantic analysis of a program that grows by the declarations and instructions entered in the REPL. Only the added
+// declarations are analyzed, along with the functions calling a name that gained an overload, as the best overload for
+// their calls may have changed.
+class IncrementalSemanticAnalysis
+{
+public:
+    // Analyzes the whole program, which must outlive the analysis and must only be modified through it.
+    explicit IncrementalSemanticAnalysis(Program &program);
+    // Merges the declarations into the program and analyzes them, then analyzes the instructions, which are executed
+    // outside of any function. The variables declared by the instructions are visible to the next analyzed ones. On
+    // error, the program and the variables are left as they were.
+    void analyzeEntry(
+        Program &declarations, std::vector<std::unique_ptr<Instruction>> &instructions, const std::wstring &source
+    );
+    // Forgets the variables declared by the instructions of the last entry, when their execution has failed.
+    void revertInstructions();
+    // Number of function bodies analyzed so far, including the ones analyzed again.
+    unsigned getAnalyzedFunctions() const;
+private:
+    Program &program;
+    CallerIndex callers;
+    std::unordered_map<std::wstring, std::pair<Type, bool>> variables, previousVariables;
+    unsigned analyzedFunctions;
+
+    void analyzeFunctions(const std::vector<FunctionIdentification> &functions);
+};
 
 #endif
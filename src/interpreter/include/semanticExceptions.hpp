@@ -60,7 +60,9 @@ DECLARE_SEMANTIC_ERROR(InvalidOperatorArgsError);
 DECLARE_SEMANTIC_ERROR(InvalidInitListError);
 DECLARE_SEMANTIC_ERROR(ImmutableError);
 DECLARE_SEMANTIC_ERROR(InvalidFunctionCallError);
+DECLARE_SEMANTIC_ERROR(InvalidSpawnError);
 DECLARE_SEMANTIC_ERROR(AmbiguousFunctionCallError);
+DECLARE_SEMANTIC_ERROR(AliasedArgumentsError);
 DECLARE_SEMANTIC_ERROR(InvalidReturnError);
 DECLARE_SEMANTIC_ERROR(InvalidBreakError);
 DECLARE_SEMANTIC_ERROR(InvalidContinueError);
@@ -0,0 +1,62 @@
+#ifndef SPAWNEDTASK_HPP
+#define SPAWNEDTASK_HPP
+
+#include "object.hpp"
+#include "workStealingPool.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+
+// Function call running in a work-stealing pool. The standard output of the call is buffered and written to the output
+// of the thread which joins the task first.
+class SpawnedTask: public std::enable_shared_from_this<SpawnedTask>
+{
+public:
+    // The call writes its standard output to the given stream. It receives its own task, so that it can check whether
+    // it was cancelled and spawn nested tasks.
+    using Call = std::function<Object(std::wostream &output, const std::shared_ptr<SpawnedTask> &task)>;
+
+    // Submits the call to the pool. The task is cancelled together with its parent, which is the task whose call
+    // spawned it, if there is one.
+    static std::shared_ptr<SpawnedTask> spawn(
+        WorkStealingPool &pool, Call call, std::shared_ptr<const SpawnedTask> parent = nullptr
+    );
+    SpawnedTask(const SpawnedTask &) = delete;
+    // Waits for the call to finish and writes its output, if it has not been written yet. Returns a copy of the result
+    // or rethrows the error which ended the call.
+    Object join(std::wostream &output);
+    // Waits for the call to finish without reporting its result. The call is run by the waiting thread if no worker has
+    // started it. Otherwise the thread runs other pending jobs, unless it is already nested in too many of them.
+    void wait();
+    bool isJoined();
+    // Asks the call and the calls of the tasks below it to stop. It is up to the call to check it.
+    void cancel();
+    bool isCancelled() const;
+private:
+    // Number of jobs a thread may run nested in each other while waiting for tasks. Each of them grows its stack.
+    static const unsigned MAX_HELPING_DEPTH = 4;
+
+    WorkStealingPool &pool;
+    Call call;
+    std::shared_ptr<const SpawnedTask> parent;
+    std::atomic<bool> cancelled;
+    std::mutex mutex;
+    std::condition_variable finishedChanged;
+    bool started, finished, joined;
+    std::optional<Object> result;
+    std::exception_ptr error;
+    std::wstring output;
+
+    SpawnedTask(WorkStealingPool &pool, Call call, std::shared_ptr<const SpawnedTask> parent);
+    // Runs the call, unless it has already been started, and returns whether it was run.
+    bool run();
+};
+
+#endif
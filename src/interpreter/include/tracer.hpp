@@ -0,0 +1,52 @@
+#ifndef TRACER_HPP
+#define TRACER_HPP
+
+#include <chrono>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Records the durations of phases of the interpreter pipeline and writes them in the Chrome trace event format, which
+// can be viewed in chrome://tracing or Perfetto.
+class Tracer
+{
+public:
+    // Records a phase lasting from construction to destruction. Does nothing if the tracer is nullptr, so that tracing
+    // can be optional without additional checks in the traced code.
+    class Span
+    {
+    public:
+        Span(Tracer *tracer, std::wstring name, std::optional<std::wstring> file = std::nullopt);
+        Span(const Span &) = delete;
+        ~Span();
+    private:
+        Tracer *tracer;
+        unsigned event;
+    };
+
+    struct Event
+    {
+        std::wstring name;
+        // Name of the processed file, if the phase concerns a single file.
+        std::optional<std::wstring> file;
+        // Start of the phase relative to the construction of the tracer.
+        std::chrono::nanoseconds start;
+        std::chrono::nanoseconds duration;
+    };
+
+    Tracer();
+    // Returns the events in the order the phases started.
+    const std::vector<Event> &getEvents() const;
+    void writeJson(std::wostream &out) const;
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point start;
+    std::vector<Event> events;
+
+    unsigned beginEvent(std::wstring name, std::optional<std::wstring> file);
+    void endEvent(unsigned event);
+};
+
+#endif
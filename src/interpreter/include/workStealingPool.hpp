@@ -0,0 +1,58 @@
+#ifndef WORKSTEALINGPOOL_HPP
+#define WORKSTEALINGPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+// Thread pool in which every worker has its own deque of jobs. A worker runs the newest jobs of its own deque first and
+// steals the oldest jobs of the other workers when its deque is empty. Jobs submitted by a worker go to its own deque,
+// so nested jobs stay on the thread that submitted them, unless other workers are idle.
+class WorkStealingPool
+{
+public:
+    using Job = std::function<void()>;
+
+    explicit WorkStealingPool(unsigned threads);
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    // Runs the jobs left and stops the workers.
+    ~WorkStealingPool();
+    // The job must not throw.
+    void submit(Job job);
+    // Runs one pending job in the calling thread and returns false if there was none. Threads waiting for a job to
+    // finish run the other jobs in the meantime, so that workers waiting for nested jobs do not block the pool.
+    bool runPendingJob();
+    unsigned getThreads() const;
+    // Returns the pool shared by the whole process, with a worker for every hardware thread.
+    static WorkStealingPool &getShared();
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::mutex sleepMutex;
+    std::condition_variable jobAdded;
+    // Incremented with sleepMutex held, so that no sleeping worker misses a submitted job. It may be briefly negative,
+    // when a job is taken before the increment.
+    std::atomic<int> pendingJobs;
+    bool stopping;
+    std::atomic<unsigned> nextQueue;
+    // Destroyed first, so the workers are joined before the queues are destroyed.
+    std::vector<std::jthread> threads;
+
+    // Returns the index of the queue of the calling thread, if it is a worker of this pool.
+    std::optional<unsigned> getWorkerIndex() const;
+    std::optional<Job> takeJob(unsigned preferredQueue);
+    void work(unsigned index);
+};
+
+#endif
@@ -1,3 +1,5 @@
+#include "includeExecution.hpp"
+
 #include "commentDiscarder.hpp"
 #include "convertToString.hpp"
 #include "documentTree.hpp"
@@ -34,7 +36,8 @@ void mergePrograms(Program &program, Program &toAdd)
 #include <iostream>
 
 void executeIncludes(
-    Program &program, std::vector<std::wstring> &sourceFiles, std::function<Program(const std::wstring &)> parseFromFile
+    Program &program, std::vector<std::wstring> &sourceFiles,
+    std::function<Program(const std::wstring &)> parseFromFile, Tracer *tracer
 )
 {
     for(IncludeStatement &include: program.includes)
@@ -42,8 +45,9 @@ void executeIncludes(
         if(std::find(sourceFiles.begin(), sourceFiles.end(), include.filePath) != sourceFiles.end())
             continue;
         sourceFiles.push_back(include.filePath);
+        Tracer::Span span(tracer, L"include", include.filePath);
         Program newProgram = parseFromFile(include.filePath);
-        executeIncludes(newProgram, sourceFiles, parseFromFile);
+        executeIncludes(newProgram, sourceFiles, parseFromFile, tracer);
         mergePrograms(program, newProgram);
     }
     program.includes.clear();
@@ -1,28 +1,96 @@
 #include "interpreter.hpp"
 
-#include "builtinFunctions.hpp"
-#include "includeExecution.hpp"
 #include "runtimeExceptions.hpp"
 #include "semanticAnalysis.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <sstream>
+#include <unordered_set>
 
 using enum Type::Builtin;
 
 Interpreter::Interpreter(
-    std::vector<std::wstring> &sourceFiles, std::vector<std::wstring> arguments, std::wistream &input,
-    std::wostream &output, std::function<Program(const std::wstring &)> parseFromFile, unsigned maxStackSize
+    std::vector<std::wstring> arguments, std::wistream &input, std::wostream &output, unsigned maxStackSize,
+    Profiler *profiler, SamplingProfiler *sampler, Tracer *tracer, ExecutionLimits limits
 ):
-    sourceFiles(sourceFiles), arguments(arguments), input(input), output(output), parseFromFile(parseFromFile),
-    shouldReturn(false), shouldContinue(false), shouldBreak(false), maxStackSize(maxStackSize)
+    sourceFiles(nullptr), arguments(arguments), environment{this->arguments, input, output}, shouldReturn(false),
+    shouldContinue(false), shouldBreak(false), maxStackSize(maxStackSize), profiler(profiler), sampler(sampler),
+    tracer(tracer), limits(limits), taskPruneThreshold(MIN_TASK_PRUNE_THRESHOLD), measuredHeapBytes(0)
 {}
 
+Interpreter::Interpreter(
+    std::vector<std::wstring> &sourceFiles, std::vector<std::wstring> arguments, std::wistream &input,
+    std::wostream &output, std::function<Program(const std::wstring &)> parseFromFile, unsigned maxStackSize,
+    Profiler *profiler, SamplingProfiler *sampler, Tracer *tracer, ExecutionLimits limits
+):
+    Interpreter(arguments, input, output, maxStackSize, profiler, sampler, tracer, limits)
+{
+    this->sourceFiles = &sourceFiles;
+    this->parseFromFile = parseFromFile;
+}
+
+Interpreter::~Interpreter()
+{
+    abandonSpawnedTasks();
+    if(budget)
+        budget->heapBytes -= measuredHeapBytes;
+}
+
 #define EMPTY_VISIT(type) \
     void Interpreter::visit(type &) {}
 
 namespace {
+// Number of instructions between checks of the time and heap memory budgets.
+const unsigned long long BUDGET_CHECK_INTERVAL = 1024;
+const unsigned long long NO_CHECK = std::numeric_limits<unsigned long long>::max();
+
+size_t getHeapSize(const std::string &string)
+{
+    // short strings are stored inside the string object
+    static const size_t inlineCapacity = std::string().capacity();
+    return string.capacity() > inlineCapacity ? string.capacity() + 1 : 0;
+}
+
+// Adds the heap memory held by the object to size and counts the visited objects.
+void addHeapSize(const Object &object, size_t &size, unsigned long long &visited)
+{
+    visited += 1;
+    if(auto string = std::get_if<Utf8String>(&object.value))
+        size += string->getHeapSize();
+    else if(auto fields = std::get_if<std::vector<Object>>(&object.value))
+    {
+        size += fields->capacity() * sizeof(Object);
+        for(const Object &field: *fields)
+            addHeapSize(field, size, visited);
+    }
+    else if(auto content = std::get_if<std::unique_ptr<Object>>(&object.value); content && *content)
+    {
+        size += sizeof(Object);
+        addHeapSize(**content, size, visited);
+    }
+    else if(auto dictionary = std::get_if<HashMap>(&object.value))
+    {
+        size += dictionary->getTableSize();
+        dictionary->forEach([&](const HashMap::Key &key, const Object &value) {
+            if(auto string = std::get_if<std::string>(&key))
+                size += getHeapSize(*string);
+            addHeapSize(value, size, visited);
+        });
+    }
+}
+
+// References are skipped, as the objects they refer to are counted where they are stored.
+void addHeapSize(
+    const std::variant<Object, std::reference_wrapper<Object>> &value, size_t &size, unsigned long long &visited
+)
+{
+    if(auto object = std::get_if<Object>(&value))
+        addHeapSize(*object, size, visited);
+}
+
 Object &getField(
-    Object &structure, std::unordered_map<std::wstring, StructDeclaration>::iterator structFound,
+    Object &structure, std::unordered_map<std::wstring, StructDeclaration>::const_iterator structFound,
     const std::wstring &fieldName
 )
 {
@@ -59,7 +127,7 @@ std::variant<Object, std::reference_wrapper<Object>> getReferenceOrTemporary(
 
 Object &Interpreter::getVariable(const std::wstring &name)
 {
-    for(auto &scope: variables.top())
+    for(auto &scope: variables.back())
     {
         auto found = scope.find(name);
         if(found != scope.end())
@@ -70,12 +138,12 @@ Object &Interpreter::getVariable(const std::wstring &name)
 
 void Interpreter::addVariable(const std::wstring &name, Object &&object)
 {
-    variables.top()[variables.top().size() - 1].insert({name, std::move(object)});
+    variables.back()[variables.back().size() - 1].insert({name, std::move(object)});
 }
 
 void Interpreter::addVariable(const std::wstring &name, std::reference_wrapper<Object> object)
 {
-    variables.top()[variables.top().size() - 1].insert({name, object});
+    variables.back()[variables.back().size() - 1].insert({name, object});
 }
 
 Object Interpreter::getLastResultValue()
@@ -117,10 +185,124 @@ std::pair<Object, Object> Interpreter::getBinaryOpArgsObjects(BinaryOperation &v
     return {std::move(left), std::move(right)};
 }
 
-void Interpreter::visitInstructionBlock(std::vector<std::unique_ptr<Instruction>> &block)
+void Interpreter::startBudgets()
+{
+    startBudgets(std::make_shared<ExecutionBudget>(limits));
+}
+
+void Interpreter::startBudgets(std::shared_ptr<ExecutionBudget> shared)
+{
+    if(budget)
+        budget->heapBytes -= measuredHeapBytes;
+    budget = std::move(shared);
+    executedInstructions = reportedInstructions = 0;
+    measuredHeapBytes = 0;
+    // the first instruction is checked, as the tasks sharing the budget may have used all of it
+    nextInstructionCheck = budget->limits.maxInstructions ? 1 : NO_CHECK;
+    nextTimeCheck = budget->limits.maxTime ? BUDGET_CHECK_INTERVAL : NO_CHECK;
+    nextHeapCheck = budget->limits.maxHeapBytes ? BUDGET_CHECK_INTERVAL : NO_CHECK;
+    nextCancellationCheck = task ? BUDGET_CHECK_INTERVAL : NO_CHECK;
+    nextBudgetCheck = std::min({nextInstructionCheck, nextTimeCheck, nextHeapCheck, nextCancellationCheck});
+}
+
+void Interpreter::checkBudgets(Position position)
+{
+    const ExecutionLimits &limits = budget->limits;
+    if(executedInstructions >= nextInstructionCheck)
+    {
+        unsigned long long total = reportInstructions(position);
+        // the next check is at the instruction exceeding the limit, unless the budget is shared with other tasks,
+        // which may use it in the meantime
+        nextInstructionCheck =
+            executedInstructions + std::min(BUDGET_CHECK_INTERVAL, *limits.maxInstructions - total + 1);
+    }
+    if(executedInstructions >= nextTimeCheck)
+    {
+        if(std::chrono::steady_clock::now() - budget->startTime > *limits.maxTime)
+            throw ExecutionLimitError(
+                std::format(
+                    L"Execution exceeded the time limit of {} ms",
+                    std::chrono::duration_cast<std::chrono::milliseconds>(*limits.maxTime).count()
+                ),
+                currentSource, position
+            );
+        nextTimeCheck = executedInstructions + BUDGET_CHECK_INTERVAL;
+    }
+    if(executedInstructions >= nextHeapCheck)
+    {
+        auto [heapBytes, visited] = measureHeap();
+        size_t total = budget->heapBytes += heapBytes - measuredHeapBytes;
+        measuredHeapBytes = heapBytes;
+        if(total > *limits.maxHeapBytes)
+            throw ExecutionLimitError(
+                std::format(L"Execution exceeded the heap memory limit of {} bytes", *limits.maxHeapBytes),
+                currentSource, position
+            );
+        // the measurement takes time proportional to the number of values, so it is done less often when there are
+        // many of them, keeping its cost per instruction constant
+        nextHeapCheck = executedInstructions + std::max(BUDGET_CHECK_INTERVAL, visited);
+    }
+    if(executedInstructions >= nextCancellationCheck)
+    {
+        if(task->isCancelled())
+            throw TaskCancelledError(
+                L"Task was cancelled, as the execution which spawned it has ended", currentSource, position
+            );
+        nextCancellationCheck = executedInstructions + BUDGET_CHECK_INTERVAL;
+    }
+    nextBudgetCheck = std::min({nextInstructionCheck, nextTimeCheck, nextHeapCheck, nextCancellationCheck});
+}
+
+unsigned long long Interpreter::reportInstructions(Position position)
+{
+    unsigned long long total = budget->executedInstructions += executedInstructions - reportedInstructions;
+    reportedInstructions = executedInstructions;
+    if(budget->limits.maxInstructions && total > *budget->limits.maxInstructions)
+        throw ExecutionLimitError(
+            std::format(L"Execution exceeded the limit of {} instructions", *budget->limits.maxInstructions),
+            currentSource, position
+        );
+    return total;
+}
+
+void Interpreter::checkStringAllocation(size_t size, Position position)
+{
+    const ExecutionLimits &limits = budget->limits;
+    if(limits.maxHeapBytes && budget->heapBytes + size + 1 > *limits.maxHeapBytes)
+        throw ExecutionLimitError(
+            std::format(
+                L"Creating a string of {} bytes would exceed the heap memory limit of {} bytes", size,
+                *limits.maxHeapBytes
+            ),
+            currentSource, position
+        );
+}
+
+std::pair<size_t, unsigned long long> Interpreter::measureHeap() const
+{
+    size_t size = 0;
+    unsigned long long visited = 0;
+    for(const auto &frame: variables)
+    {
+        for(const auto &scope: frame)
+        {
+            for(const auto &[name, value]: scope)
+                addHeapSize(value, size, visited);
+        }
+    }
+    for(const auto &argument: functionArguments)
+        addHeapSize(argument, size, visited);
+    addHeapSize(lastResult, size, visited);
+    return {size, visited};
+}
+
+void Interpreter::visitInstructionBlock(std::span<std::unique_ptr<Instruction>> block)
 {
     for(auto &instruction: block)
     {
+        if(sampler)
+            sampler->takePendingSamples();
+        countInstruction(instruction->getPosition());
         instruction->accept(*this);
         if(shouldReturn || shouldBreak || shouldContinue)
             return;
@@ -129,9 +311,9 @@ void Interpreter::visitInstructionBlock(std::vector<std::unique_ptr<Instruction>
 
 void Interpreter::visitInstructionScope(std::vector<std::unique_ptr<Instruction>> &block)
 {
-    variables.top().emplace_back();
+    variables.back().emplace_back();
     visitInstructionBlock(block);
-    variables.top().pop_back();
+    variables.back().pop_back();
 }
 
 void Interpreter::visit(Literal &visited)
@@ -139,8 +321,7 @@ void Interpreter::visit(Literal &visited)
     lastResult = Object(
         visited.getType(),
         std::visit(
-            [](auto &value
-            ) -> std::variant<std::wstring, int32_t, double, bool, std::vector<Object>, std::unique_ptr<Object>> {
+            [](auto &value) -> Object::Value {
                 return value;
             },
             visited.value
@@ -157,7 +338,8 @@ void Interpreter::visit(IsExpression &visited)
 {
     visited.left->accept(*this);
     Object &value = getLastResultReference();
-    if(value.type.isBuiltin() || program->structs.count(std::get<std::wstring>(value.type.value)) == 1)
+    if(value.type.isBuiltin() || value.type.isCollection() || value.type.isTask() ||
+       program->structs.count(std::get<std::wstring>(value.type.value)) == 1)
     {
         lastResult = Object{{BOOL}, value.type == visited.right};
         return;
@@ -191,7 +373,8 @@ void Interpreter::visit(AndExpression &visited)
 
 bool Interpreter::isVariantType(const Type &type)
 {
-    return !type.isBuiltin() && program->variants.count(std::get<std::wstring>(type.value)) == 1;
+    return !type.isBuiltin() && !type.isCollection() && !type.isTask() &&
+           program->variants.count(std::get<std::wstring>(type.value)) == 1;
 }
 
 Object &Interpreter::getNonvariantValue(const Object &variant)
@@ -257,29 +440,31 @@ void Interpreter::visit(NotIdenticalExpression &visited)
 
 void Interpreter::visit(ConcatExpression &visited)
 {
-    auto [left, right] = getBinaryOpArgs<std::wstring, std::wstring>(visited);
-    if(left.size() + right.size() > left.max_size())
+    auto [left, right] = getBinaryOpArgs<Utf8String, Utf8String>(visited);
+    size_t size = left.getBytes().size() + right.getBytes().size();
+    if(size > left.getBytes().max_size())
         throw StringSizeError(
             L"Concatenation would result in a string over maximum size", currentSource, visited.getPosition()
         );
-    lastResult = Object{{STR}, left + right};
+    checkStringAllocation(size, visited.getPosition());
+    left += right;
+    lastResult = Object{{STR}, std::move(left)};
 }
 
 void Interpreter::visit(StringMultiplyExpression &visited)
 {
-    auto [left, right] = getBinaryOpArgs<std::wstring, int32_t>(visited);
+    auto [left, right] = getBinaryOpArgs<Utf8String, int32_t>(visited);
     if(right < 0)
         throw OperatorArgumentError(
             L"'@' operator's right argument must be positive", currentSource, visited.getPosition()
         );
-    if(left.size() * right > left.max_size())
+    size_t size = left.getBytes().size();
+    if(size != 0 && static_cast<size_t>(right) > left.getBytes().max_size() / size)
         throw StringSizeError(
             L"String multiplication would result in a string over maximum size", currentSource, visited.getPosition()
         );
-    std::wstring result;
-    for(int32_t i = 0; i < right; i++)
-        result += left;
-    lastResult = Object{{STR}, result};
+    checkStringAllocation(size * right, visited.getPosition());
+    lastResult = Object{{STR}, left.repeat(static_cast<size_t>(right))};
 }
 
 template <typename BinaryOperation>
@@ -480,12 +665,60 @@ void Interpreter::visit(NotExpression &visited)
     lastResult = Object{{BOOL}, !value};
 }
 
+Object &Interpreter::getArrayElement(Object &array, int32_t index, Position position)
+{
+    std::vector<Object> &elements = std::get<std::vector<Object>>(array.value);
+    if(index < 0 || static_cast<size_t>(index) >= elements.size())
+        throw OperatorArgumentError(
+            std::format(L"Index {} is out of range of array of length {}", index, elements.size()), currentSource,
+            position
+        );
+    return elements[static_cast<size_t>(index)];
+}
+
+Object &Interpreter::getDictionaryValue(Object &dictionary, const Object &key, Position position)
+{
+    Object *value = std::get<HashMap>(dictionary.value).find(toHashMapKey(key));
+    if(!value)
+    {
+        auto number = std::get_if<int32_t>(&key.value);
+        std::wstring keyText = number ? std::to_wstring(*number) : std::get<Utf8String>(key.value).toWstring();
+        throw OperatorArgumentError(
+            std::format(L"Key {} is not present in dictionary", keyText), currentSource, position
+        );
+    }
+    return *value;
+}
+
 void Interpreter::visit(SubscriptExpression &visited)
 {
-    auto [left, right] = getBinaryOpArgs<std::wstring, int32_t>(visited);
-    if(right < 0 || static_cast<size_t>(right) >= left.size())
+    visited.left->accept(*this);
+    if(getLastResultReference().type.isArray())
+    {
+        std::variant<Object, std::reference_wrapper<Object>> array = std::move(lastResult);
+        visited.right->accept(*this);
+        int32_t index = std::get<int32_t>(getLastResultReference().value);
+        // the element is looked up after evaluating the index, which may have modified the array
+        Object &element = getArrayElement(getObject(array), index, visited.getPosition());
+        lastResult = getReferenceOrTemporary(std::move(array), element);
+        return;
+    }
+    if(getLastResultReference().type.isDictionary())
+    {
+        std::variant<Object, std::reference_wrapper<Object>> dictionary = std::move(lastResult);
+        visited.right->accept(*this);
+        Object &value = getDictionaryValue(getObject(dictionary), getLastResultReference(), visited.getPosition());
+        lastResult = getReferenceOrTemporary(std::move(dictionary), value);
+        return;
+    }
+    // the string is not copied, so that walking it by indexes takes linear time
+    std::variant<Object, std::reference_wrapper<Object>> string = std::move(lastResult);
+    visited.right->accept(*this);
+    int32_t index = std::get<int32_t>(getLastResultReference().value);
+    const Utf8String &left = std::get<Utf8String>(getObject(string).value);
+    if(index < 0 || static_cast<size_t>(index) >= left.size())
         throw OperatorArgumentError(L"Invalid index for subscript operator", currentSource, visited.getPosition());
-    lastResult = Object{{STR}, std::wstring(1, left.at(static_cast<size_t>(right)))};
+    lastResult = Object{{STR}, left.at(static_cast<size_t>(index))};
 }
 
 void Interpreter::visit(DotExpression &visited)
@@ -495,18 +728,38 @@ void Interpreter::visit(DotExpression &visited)
     auto fields = program->structs.find(std::get<std::wstring>(left.type.value));
     Object &field = getField(left, fields, visited.field);
 
-    lastResult = getReferenceOrTemporary(lastResult, field);
+    lastResult = getReferenceOrTemporary(std::move(lastResult), field);
 }
 
 void Interpreter::visit(StructExpression &visited)
 {
+    if(visited.collectionType && visited.collectionType->isDictionary())
+        return buildDictionary(visited);
     std::vector<Object> fields;
     for(auto &argument: visited.arguments)
     {
         argument->accept(*this);
         fields.push_back(getLastResultValue());
     }
-    lastResult = Object{{*visited.structType}, std::move(fields)};
+    if(visited.collectionType)
+        lastResult = Object{*visited.collectionType, std::move(fields)};
+    else
+        lastResult = Object{{*visited.structType}, std::move(fields)};
+}
+
+// The elements of the initialization list are pairs of a key and a value, typed only by the semantic analysis.
+void Interpreter::buildDictionary(StructExpression &visited)
+{
+    HashMap entries;
+    for(auto &argument: visited.arguments)
+    {
+        auto &pair = static_cast<StructExpression &>(*argument);
+        pair.arguments[0]->accept(*this);
+        Object key = getLastResultValue();
+        pair.arguments[1]->accept(*this);
+        entries.findOrInsert(toHashMapKey(key)) = getLastResultValue();
+    }
+    lastResult = Object{*visited.collectionType, std::move(entries)};
 }
 
 template <typename TargetType, typename SourceType>
@@ -550,9 +803,9 @@ NumberType Interpreter::fromString(const std::wstring &value, Position position,
 }
 
 template <>
-int32_t Interpreter::cast(const std::wstring &value, Position position)
+int32_t Interpreter::cast(const Utf8String &value, Position position)
 {
-    return fromString<int32_t>(value, position, L"integer");
+    return fromString<int32_t>(value.toWstring(), position, L"integer");
 }
 
 template <>
@@ -574,9 +827,9 @@ double Interpreter::cast(const int32_t &value, Position)
 }
 
 template <>
-double Interpreter::cast(const std::wstring &value, Position position)
+double Interpreter::cast(const Utf8String &value, Position position)
 {
-    return fromString<double>(value, position, L"float");
+    return fromString<double>(value.toWstring(), position, L"float");
 }
 
 template <>
@@ -591,29 +844,30 @@ double Interpreter::cast(const double &value, Position)
     return value;
 }
 
+// numbers are formatted directly as ASCII, without encoding
 template <>
-std::wstring Interpreter::cast(const int32_t &value, Position)
+Utf8String Interpreter::cast(const int32_t &value, Position)
 {
-    return std::format(L"{}", value);
+    return Utf8String::fromUtf8(std::format("{}", value));
 }
 
 template <>
-std::wstring Interpreter::cast(const double &value, Position)
+Utf8String Interpreter::cast(const double &value, Position)
 {
-    return std::format(L"{}", value);
+    return Utf8String::fromUtf8(std::format("{}", value));
 }
 
 template <>
-std::wstring Interpreter::cast(const bool &value, Position)
+Utf8String Interpreter::cast(const bool &value, Position)
 {
     if(value)
-        return L"true";
+        return Utf8String::fromUtf8("true");
     else
-        return L"false";
+        return Utf8String::fromUtf8("false");
 }
 
 template <>
-std::wstring Interpreter::cast(const std::wstring &value, Position)
+Utf8String Interpreter::cast(const Utf8String &value, Position)
 {
     return value;
 }
@@ -631,7 +885,7 @@ bool Interpreter::cast(const double &value, Position)
 }
 
 template <>
-bool Interpreter::cast(const std::wstring &value, Position)
+bool Interpreter::cast(const Utf8String &value, Position)
 {
     return value.size() > 0;
 }
@@ -657,7 +911,7 @@ Object Interpreter::doCast(Type::Builtin targetType, Object &toCast, Position po
     case INT:
         return getCastedObject<int32_t>(targetType, toCast, position);
     case STR:
-        return getCastedObject<std::wstring>(targetType, toCast, position);
+        return getCastedObject<Utf8String>(targetType, toCast, position);
     case FLOAT:
         return getCastedObject<double>(targetType, toCast, position);
     case BOOL:
@@ -689,48 +943,134 @@ void Interpreter::visit(VariableDeclStatement &visited)
     Object &containedInVariant = *std::get<std::unique_ptr<Object>>(value.value).get();
     if(containedInVariant.type == visited.declaration.type)
     {
-        addVariable(visited.declaration.name, std::move(containedInVariant));
+        // the contents can be moved out only of a temporary variant, a variable has to stay unchanged
+        bool isTemporary = std::holds_alternative<Object>(lastResult);
+        addVariable(visited.declaration.name, isTemporary ? std::move(containedInVariant) : Object(containedInVariant));
         lastResult = Object{{BOOL}, true};
     }
     else
         lastResult = Object{{BOOL}, false};
 }
 
-void Interpreter::visit(Assignable &visited)
+void Interpreter::evaluateAssignableIndexes(Assignable &visited, std::vector<Object> &indexes)
+{
+    if(visited.left)
+        evaluateAssignableIndexes(*visited.left, indexes);
+    if(visited.index)
+    {
+        visited.index->accept(*this);
+        indexes.push_back(getLastResultValue());
+    }
+}
+
+Object &Interpreter::resolveAssignable(
+    Assignable &visited, std::vector<Object>::const_iterator &nextIndex, bool isAssigned
+)
 {
     if(!visited.left)
+        return getVariable(visited.right);
+    Object &left = resolveAssignable(*visited.left, nextIndex, false);
+    if(visited.index && left.type.isDictionary())
     {
-        lastResult = getVariable(visited.right);
-        return;
+        const Object &key = *nextIndex++;
+        // only the assigned value itself is inserted if missing, its parts must already exist
+        if(isAssigned)
+            return std::get<HashMap>(left.value).findOrInsert(toHashMapKey(key));
+        return getDictionaryValue(left, key, visited.getPosition());
     }
-    visit(*visited.left);
-    Object &left = getLastResultReference();
+    if(visited.index)
+        return getArrayElement(left, std::get<int32_t>((nextIndex++)->value), visited.getPosition());
     std::wstring typeName = std::get<std::wstring>(left.type.value);
 
     auto structFound = program->structs.find(typeName);
     if(structFound != program->structs.end())
-        lastResult = getField(left, structFound, visited.right);
+        return getField(left, structFound, visited.right);
     else // variant access case
-        lastResult = *std::get<std::unique_ptr<Object>>(left.value).get();
+        return *std::get<std::unique_ptr<Object>>(left.value).get();
+}
+
+void Interpreter::visit(Assignable &visited)
+{
+    // all indexes are evaluated before any object is looked up, as evaluating them may resize the collections
+    std::vector<Object> indexes;
+    evaluateAssignableIndexes(visited, indexes);
+    auto nextIndex = indexes.cbegin();
+    lastResult = std::ref(resolveAssignable(visited, nextIndex, true));
 }
 
 void Interpreter::visit(AssignmentStatement &visited)
 {
-    visit(visited.left);
-    Object &assignmentTarget = getLastResultReference();
+    // the value is evaluated first, so that it cannot invalidate the assignment target
     visited.right->accept(*this);
-    assignmentTarget = std::move(getLastResultValue());
+    Object value = getLastResultValue();
+    visit(visited.left);
+    getLastResultReference() = std::move(value);
+}
+
+void Interpreter::evaluateElementIndexes(Expression &element, std::vector<Object> &indexes)
+{
+    if(auto subscript = dynamic_cast<SubscriptExpression *>(&element))
+    {
+        evaluateElementIndexes(*subscript->left, indexes);
+        subscript->right->accept(*this);
+        indexes.push_back(getLastResultValue());
+    }
+    else if(auto dot = dynamic_cast<DotExpression *>(&element))
+        evaluateElementIndexes(*dot->value, indexes);
+}
+
+Object &Interpreter::resolveElement(
+    Expression &element, std::vector<Object>::const_iterator &nextIndex, bool isAssigned
+)
+{
+    if(auto subscript = dynamic_cast<SubscriptExpression *>(&element))
+    {
+        Object &left = resolveElement(*subscript->left, nextIndex, false);
+        const Object &index = *nextIndex++;
+        if(!left.type.isDictionary())
+            return getArrayElement(left, std::get<int32_t>(index.value), subscript->getPosition());
+        // a value removed from the dictionary during the call is inserted again, as if it was assigned
+        if(isAssigned)
+            return std::get<HashMap>(left.value).findOrInsert(toHashMapKey(index));
+        return getDictionaryValue(left, index, subscript->getPosition());
+    }
+    if(auto dot = dynamic_cast<DotExpression *>(&element))
+    {
+        Object &left = resolveElement(*dot->value, nextIndex, false);
+        return getField(left, program->structs.find(std::get<std::wstring>(left.type.value)), dot->field);
+    }
+    return getVariable(static_cast<Variable &>(element).name);
 }
 
-std::vector<Type> Interpreter::prepareArguments(FunctionCall &visited)
+std::vector<Type> Interpreter::prepareArguments(FunctionCall &visited, std::vector<WrittenBackArgument> &writtenBack)
 {
     if(variables.size() >= maxStackSize)
         throw StackOverflowError(L"Recursion limit exceeded", currentSource, visited.getPosition());
     std::vector<std::variant<Object, std::reference_wrapper<Object>>> arguments;
-    for(auto &argument: visited.arguments)
+    // the arguments refer to the copies, which therefore must not be reallocated
+    writtenBack.reserve(visited.writtenBackArguments.size());
+    auto nextWrittenBack = visited.writtenBackArguments.cbegin();
+    for(unsigned i = 0; i < visited.arguments.size(); i++)
     {
-        argument->accept(*this);
-        arguments.push_back(getReferenceOrTemporary(lastResult));
+        Expression &argument = *visited.arguments[i];
+        if(nextWrittenBack != visited.writtenBackArguments.cend() && *nextWrittenBack == i)
+        {
+            nextWrittenBack++;
+            std::vector<Object> indexes;
+            evaluateElementIndexes(argument, indexes);
+            auto nextIndex = indexes.cbegin();
+            Object value(resolveElement(argument, nextIndex, false));
+            writtenBack.push_back({i, std::move(indexes), std::move(value)});
+            arguments.push_back(std::ref(writtenBack.back().value));
+            continue;
+        }
+        argument.accept(*this);
+        arguments.push_back(getReferenceOrTemporary(std::move(lastResult)));
+    }
+    for(unsigned index: visited.copiedArguments)
+    {
+        if(std::holds_alternative<std::reference_wrapper<Object>>(arguments[index]))
+            arguments[index] = Object(getObject(arguments[index]));
     }
     std::vector<Type> argumentTypes;
     for(auto &argument: arguments)
@@ -739,12 +1079,29 @@ std::vector<Type> Interpreter::prepareArguments(FunctionCall &visited)
     return argumentTypes;
 }
 
-void Interpreter::visit(FunctionCall &visited)
+void Interpreter::callFunction(
+    const FunctionIdentification &id, BaseFunctionDeclaration &function, Position callPosition
+)
 {
-    std::vector<Type> argumentTypes = prepareArguments(visited);
+    if(!profiler && !sampler)
+        return function.accept(*this);
+    std::optional<Profiler::CallGuard> profiled;
+    if(profiler)
+        profiled.emplace(*profiler, id);
+    std::optional<SamplingProfiler::CallGuard> sampled;
+    if(sampler)
+        sampled.emplace(*sampler, id, function, callPosition);
+    function.accept(*this);
+}
+
+const std::pair<const FunctionIdentification, std::unique_ptr<BaseFunctionDeclaration>> &Interpreter::resolveCall(
+    FunctionCall &visited, std::vector<WrittenBackArgument> &writtenBack
+)
+{
+    std::vector<Type> argumentTypes = prepareArguments(visited, writtenBack);
     auto functionFound = program->functions.find(FunctionIdentification(visited.functionName, argumentTypes));
     if(functionFound != program->functions.end())
-        return functionFound->second->accept(*this);
+        return *functionFound;
 
     for(unsigned index: visited.runtimeResolved)
     {
@@ -752,7 +1109,22 @@ void Interpreter::visit(FunctionCall &visited)
         functionArguments[index] = getReferenceOrTemporary(functionArguments[index], variantContent);
         argumentTypes[index] = getObject(functionArguments[index]).type;
     }
-    program->functions.at(FunctionIdentification(visited.functionName, argumentTypes))->accept(*this);
+    return *program->functions.find(FunctionIdentification(visited.functionName, argumentTypes));
+}
+
+void Interpreter::visit(FunctionCall &visited)
+{
+    std::vector<WrittenBackArgument> writtenBack;
+    auto &[id, function] = resolveCall(visited, writtenBack);
+    callFunction(id, *function, visited.getPosition());
+    for(WrittenBackArgument &argument: writtenBack)
+    {
+        // an overload taking the argument as immutable has not modified it
+        if(!function->parameters[argument.argumentIndex].isMutable)
+            continue;
+        auto nextIndex = argument.indexes.cbegin();
+        resolveElement(*visited.arguments[argument.argumentIndex], nextIndex, true) = std::move(argument.value);
+    }
 }
 
 void Interpreter::visit(FunctionCallInstruction &visited)
@@ -760,10 +1132,65 @@ void Interpreter::visit(FunctionCallInstruction &visited)
     visit(visited.functionCall);
 }
 
+void Interpreter::visit(SpawnExpression &visited)
+{
+    // the arguments are copied into the task, so nothing is written back
+    std::vector<WrittenBackArgument> writtenBack;
+    auto &[id, function] = resolveCall(visited.functionCall, writtenBack);
+    std::vector<Object> arguments;
+    for(auto &argument: functionArguments)
+    {
+        if(std::holds_alternative<Object>(argument))
+            arguments.push_back(std::move(std::get<Object>(argument)));
+        else
+            arguments.push_back(Object(getObject(argument)));
+    }
+    functionArguments.clear();
+    // the task may run nested in the spawning call, so its stack is limited to what is left of the current one
+    unsigned stackLeft = maxStackSize - static_cast<unsigned>(variables.size());
+    // the task gets copies of everything it uses, except for the program, which is only read
+    SpawnedTask::Call call = [program = program, id = &id, function = function.get(), arguments = std::move(arguments),
+                              programArguments = this->arguments, maxStackSize = stackLeft, budget = budget](
+                                 std::wostream &output, const std::shared_ptr<SpawnedTask> &task
+                             ) mutable {
+        std::wistringstream input;
+        Interpreter interpreter(programArguments, input, output, maxStackSize);
+        return interpreter.executeSpawned(*program, *id, *function, std::move(arguments), std::move(budget), task);
+    };
+    if(spawnedTasks.size() >= taskPruneThreshold)
+    {
+        std::erase_if(spawnedTasks, [](const std::shared_ptr<SpawnedTask> &task) { return task->isJoined(); });
+        taskPruneThreshold = std::max(MIN_TASK_PRUNE_THRESHOLD, 2 * spawnedTasks.size());
+    }
+    spawnedTasks.push_back(SpawnedTask::spawn(WorkStealingPool::getShared(), std::move(call), task));
+    lastResult = Object{{Type::Task(*function->returnType)}, spawnedTasks.back()};
+}
+
+void Interpreter::finishSpawnedTasks()
+{
+    // when a task has failed, the list is kept, so that the tasks after it are waited for
+    for(const std::shared_ptr<SpawnedTask> &spawned: spawnedTasks)
+        spawned->join(environment.output);
+    spawnedTasks.clear();
+}
+
+void Interpreter::abandonSpawnedTasks()
+{
+    for(const std::shared_ptr<SpawnedTask> &spawned: spawnedTasks)
+        spawned->cancel();
+    for(const std::shared_ptr<SpawnedTask> &spawned: spawnedTasks)
+        spawned->wait();
+    spawnedTasks.clear();
+}
+
 void Interpreter::visit(ReturnStatement &visited)
 {
     if(visited.returnValue)
+    {
         visited.returnValue->accept(*this);
+        // the returned object may be a local variable, which is destroyed when the function returns
+        lastResult = getLastResultValue();
+    }
     shouldReturn = true;
 }
 
@@ -791,16 +1218,16 @@ void Interpreter::visit(IfStatement &visited)
     bool executeElse = true;
     for(SingleIfCase &singleCase: visited.cases)
     {
-        variables.top().emplace_back();
+        variables.back().emplace_back();
         visit(singleCase);
         if(std::get<bool>(getLastResultReference().value))
         {
             executeElse = false;
             visitInstructionBlock(singleCase.body);
-            variables.top().pop_back();
+            variables.back().pop_back();
             break;
         }
-        variables.top().pop_back();
+        variables.back().pop_back();
     }
     if(executeElse)
         visitInstructionScope(visited.elseCaseBody);
@@ -815,12 +1242,58 @@ void Interpreter::visit(IfStatement &visited)
     if(shouldContinue)              \
         shouldContinue = false;
 
+// The counter of a counted loop is kept by reference while scopes are added in the loop's body, which is valid as long
+// as the scopes are moved, not copied, when the vector holding them grows.
+static_assert(std::is_nothrow_move_constructible_v<
+              std::unordered_map<std::wstring, std::variant<Object, std::reference_wrapper<Object>>>>);
+
+bool Interpreter::executeCountedLoop(WhileStatement &visited, const CountedLoop &loop)
+{
+    int32_t bound = std::holds_alternative<int32_t>(loop.bound)
+                        ? std::get<int32_t>(loop.bound)
+                        : std::get<int32_t>(getVariable(std::get<std::wstring>(loop.bound)).value);
+    // the counter stays below end in the body, so the check of its largest value hoisted out of the loop guarantees
+    // that no increment overflows
+    int64_t end = int64_t(bound) + loop.isInclusive;
+    if(end - 1 + loop.step > std::numeric_limits<int32_t>::max())
+        return false;
+
+    int32_t &counter = std::get<int32_t>(getVariable(loop.counter).value);
+    std::span<std::unique_ptr<Instruction>> body = std::span(visited.body).first(visited.body.size() - 1);
+    Position incrementPosition = visited.body.back()->getPosition();
+    variables.back().emplace_back();
+    while(counter < end)
+    {
+        visitInstructionBlock(body);
+        if(shouldBreak || shouldReturn)
+        {
+            shouldBreak = false;
+            break;
+        }
+        if(shouldContinue)
+            shouldContinue = false;
+        else
+        {
+            countInstruction(incrementPosition);
+            counter += loop.step;
+        }
+        countInstruction(visited.getPosition());
+        // the scope of the body is reused by the next iteration
+        variables.back().back().clear();
+    }
+    variables.back().pop_back();
+    return true;
+}
+
 void Interpreter::visit(WhileStatement &visited)
 {
+    if(visited.countedLoop && executeCountedLoop(visited, *visited.countedLoop))
+        return;
     while(visited.condition->accept(*this), std::get<bool>(getLastResultReference().value))
     {
         visitInstructionScope(visited.body);
         HANDLE_LOOP_FLAGS;
+        countInstruction(visited.getPosition());
     }
 }
 
@@ -830,6 +1303,7 @@ void Interpreter::visit(DoWhileStatement &visited)
     {
         visitInstructionScope(visited.body);
         HANDLE_LOOP_FLAGS;
+        countInstruction(visited.getPosition());
     }
     while(visited.condition->accept(*this), std::get<bool>(getLastResultReference().value));
 }
@@ -838,8 +1312,8 @@ void Interpreter::visit(FunctionDeclaration &visited)
 {
     callPosition = visited.getPosition();
     currentSource = visited.getSource();
-    variables.emplace();
-    variables.top().emplace_back();
+    variables.emplace_back();
+    variables.back().emplace_back();
     for(unsigned i = 0; i < functionArguments.size(); i++)
     {
         std::visit(
@@ -847,36 +1321,103 @@ void Interpreter::visit(FunctionDeclaration &visited)
             getReferenceOrTemporary(functionArguments[i])
         );
     }
-    visitInstructionBlock(visited.body);
+    visitInstructionBlock(visited.getBody());
     shouldReturn = false;
-    variables.pop();
+    variables.pop_back();
 }
 
 void Interpreter::visit(BuiltinFunctionDeclaration &visited)
 {
-    auto result = visited.body(callPosition, currentSource, functionArguments);
+    auto result = visited.body(callPosition, currentSource, functionArguments, environment);
     if(result)
         lastResult = std::move(*result);
 }
 
 void Interpreter::visit(Program &visited)
 {
-    Program fullProgram = prepareBuiltinFunctions(visited.getPosition(), arguments, input, output);
-    mergePrograms(fullProgram, visited);
-    executeIncludes(fullProgram, sourceFiles, parseFromFile);
-    doSemanticAnalysis(fullProgram);
-    if(fullProgram.functions.count({L"main", {}}) == 0)
-        throw MainNotFoundError(
-            L"main function has not been found in the program", sourceFiles.at(0), fullProgram.getPosition()
-        );
-    program = &fullProgram;
-    auto &main = fullProgram.functions.at({L"main", {}});
-    if(main->returnType)
-        throw MainReturnTypeError(
-            std::format(L"main function should not return a type, returns {}", *main->returnType), main->getSource(),
-            main->getPosition()
-        );
-    fullProgram.functions.at({L"main", {}})->accept(*this);
+    if(!sourceFiles)
+        throw RuntimeSemanticException("Interpreter without source files cannot compile programs");
+    CompiledProgram compiled(std::move(visited), *sourceFiles, parseFromFile, tracer);
+    *sourceFiles = compiled.getSourceFiles();
+    execute(compiled);
+}
+
+void Interpreter::execute(const CompiledProgram &compiled)
+{
+    program = &compiled.getProgram();
+    auto &[id, main] = compiled.getMain();
+    Tracer::Span span(tracer, L"execution");
+    startBudgets();
+    try
+    {
+        callFunction(id, *main, main->getPosition());
+        finishSpawnedTasks();
+    }
+    catch(...)
+    {
+        // the tasks use the compiled program, which may be destroyed when the error leaves this function
+        abandonSpawnedTasks();
+        throw;
+    }
+    // the tasks may have exceeded the limit together without reaching their next checks
+    reportInstructions(main->getPosition());
+}
+
+Object Interpreter::executeSpawned(
+    const Program &program, const FunctionIdentification &id, BaseFunctionDeclaration &function,
+    std::vector<Object> arguments, std::shared_ptr<ExecutionBudget> budget, std::shared_ptr<SpawnedTask> task
+)
+{
+    this->program = &program;
+    this->task = std::move(task);
+    startBudgets(std::move(budget));
+    functionArguments.clear();
+    for(Object &argument: arguments)
+        functionArguments.push_back(std::move(argument));
+    callFunction(id, function, function.getPosition());
+    Object result = getLastResultValue();
+    finishSpawnedTasks();
+    reportInstructions(function.getPosition());
+    return result;
+}
+
+void Interpreter::executeInstructions(
+    const Program &program, std::vector<std::unique_ptr<Instruction>> &instructions, const std::wstring &source
+)
+{
+    this->program = &program;
+    currentSource = source;
+    startBudgets();
+    if(variables.empty())
+    {
+        variables.emplace_back();
+        variables.back().emplace_back();
+    }
+    std::unordered_set<std::wstring> previousVariables;
+    for(const auto &[name, value]: variables.back().front())
+        previousVariables.insert(name);
+    try
+    {
+        visitInstructionBlock(instructions);
+        finishSpawnedTasks();
+        if(!instructions.empty())
+            reportInstructions(instructions.back()->getPosition());
+    }
+    catch(...)
+    {
+        // the functions and scopes interrupted by the error are left and the variables declared by the instructions are
+        // removed, as their declarations are forgotten by the semantic analysis
+        while(variables.size() > 1)
+            variables.pop_back();
+        variables.back().resize(1);
+        std::erase_if(variables.back().front(), [&](const auto &variable) {
+            return !previousVariables.contains(variable.first);
+        });
+        shouldReturn = shouldContinue = shouldBreak = false;
+        abandonSpawnedTasks();
+        throw;
+    }
+    shouldReturn = false;
 }
 
 EMPTY_VISIT(VariableDeclaration);
@@ -0,0 +1,18 @@
+#include "jsonEscaping.hpp"
+
+#include <format>
+
+std::wstring escapeJsonString(const std::wstring &string)
+{
+    std::wstring escaped;
+    for(wchar_t character: string)
+    {
+        if(character == L'"' || character == L'\\')
+            escaped += std::format(L"\\{}", character);
+        else if(character < L' ')
+            escaped += std::format(L"\\u{:04x}", static_cast<unsigned>(character));
+        else
+            escaped += character;
+    }
+    return escaped;
+}
@@ -0,0 +1,94 @@
+#include "profiler.hpp"
+
+#include "jsonEscaping.hpp"
+
+#include <algorithm>
+#include <format>
+#include <iterator>
+
+Profiler::CallGuard::CallGuard(Profiler &profiler, const FunctionIdentification &id): profiler(profiler)
+{
+    profiler.enterFunction(id);
+}
+
+Profiler::CallGuard::~CallGuard()
+{
+    profiler.exitFunction();
+}
+
+void Profiler::enterFunction(const FunctionIdentification &id)
+{
+    auto entryFound = entries.find(&id);
+    if(entryFound == entries.end())
+        entryFound = entries.insert({&id, {{id, 0, {}, {}}, 0}}).first;
+    Entry &entry = entryFound->second;
+    entry.profile.calls += 1;
+    entry.activeCalls += 1;
+    callStack.push_back({&entry, Clock::now(), Clock::duration::zero()});
+}
+
+void Profiler::exitFunction()
+{
+    Frame frame = callStack.back();
+    callStack.pop_back();
+    Clock::duration elapsed = Clock::now() - frame.start;
+
+    frame.entry->profile.exclusiveTime += elapsed - frame.childrenTime;
+    frame.entry->activeCalls -= 1;
+    // only the outermost of recursive calls counts towards inclusive time, so it does not exceed the wall time
+    if(frame.entry->activeCalls == 0)
+        frame.entry->profile.inclusiveTime += elapsed;
+    if(!callStack.empty())
+        callStack.back().childrenTime += elapsed;
+}
+
+std::vector<Profiler::FunctionProfile> Profiler::getProfiles() const
+{
+    std::vector<FunctionProfile> profiles;
+    for(const auto &[id, entry]: entries)
+        profiles.push_back(entry.profile);
+    std::sort(profiles.begin(), profiles.end(), [](const FunctionProfile &first, const FunctionProfile &second) {
+        if(first.exclusiveTime != second.exclusiveTime)
+            return first.exclusiveTime > second.exclusiveTime;
+        return std::format(L"{}", first.id) < std::format(L"{}", second.id);
+    });
+    return profiles;
+}
+
+namespace {
+double toMilliseconds(std::chrono::nanoseconds time)
+{
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+}
+
+void Profiler::printReport(std::wostream &out) const
+{
+    std::ostream_iterator<wchar_t, wchar_t> outIterator(out);
+    std::format_to(
+        outIterator, L"{:>10} {:>16} {:>16}  {}\n", L"calls", L"inclusive [ms]", L"exclusive [ms]", L"function"
+    );
+    for(const FunctionProfile &profile: getProfiles())
+    {
+        std::format_to(
+            outIterator, L"{:>10} {:>16.3f} {:>16.3f}  {}\n", profile.calls, toMilliseconds(profile.inclusiveTime),
+            toMilliseconds(profile.exclusiveTime), profile.id
+        );
+    }
+}
+
+void Profiler::writeJson(std::wostream &out) const
+{
+    std::ostream_iterator<wchar_t, wchar_t> outIterator(out);
+    std::vector<FunctionProfile> profiles = getProfiles();
+    out << L"[";
+    for(unsigned i = 0; i < profiles.size(); i++)
+    {
+        std::format_to(
+            outIterator, L"{}\n  {{\"function\": \"{}\", \"calls\": {}, \"inclusive_ns\": {}, \"exclusive_ns\": {}}}",
+            i == 0 ? L"" : L",", escapeJsonString(std::format(L"{}", profiles[i].id)), profiles[i].calls,
+            profiles[i].inclusiveTime.count(), profiles[i].exclusiveTime.count()
+        );
+    }
+    out << L"\n]\n";
+}
@@ -0,0 +1,318 @@
+#include "reachability.hpp"
+
+#include <algorithm>
+#include <format>
+#include <unordered_map>
+#include <unordered_set>
+
+#define EMPTY_VISIT(type) \
+    void visit(type &) override {}
+
+#define BINARY_VISIT(type)                 \
+    void visit(type &visited) override     \
+    {                                      \
+        visited.left->accept(*this);       \
+        visited.right->accept(*this);      \
+    }
+
+namespace {
+// Collects the names of the functions and types referenced by the visited declarations. Every name is returned by
+// nextPending once.
+class ReferenceCollector: public DocumentTreeVisitor
+{
+public:
+    void addName(const std::wstring &name)
+    {
+        if(names.insert(name).second)
+            pending.push_back(name);
+    }
+
+    bool contains(const std::wstring &name) const
+    {
+        return names.contains(name);
+    }
+
+    std::optional<std::wstring> nextPending()
+    {
+        if(pending.empty())
+            return std::nullopt;
+        std::wstring name = std::move(pending.back());
+        pending.pop_back();
+        return name;
+    }
+
+    EMPTY_VISIT(Literal);
+    EMPTY_VISIT(Variable);
+    EMPTY_VISIT(ContinueStatement);
+    EMPTY_VISIT(BreakStatement);
+    EMPTY_VISIT(IncludeStatement);
+    EMPTY_VISIT(Program);
+
+    BINARY_VISIT(OrExpression);
+    BINARY_VISIT(XorExpression);
+    BINARY_VISIT(AndExpression);
+    BINARY_VISIT(EqualExpression);
+    BINARY_VISIT(NotEqualExpression);
+    BINARY_VISIT(IdenticalExpression);
+    BINARY_VISIT(NotIdenticalExpression);
+    BINARY_VISIT(ConcatExpression);
+    BINARY_VISIT(StringMultiplyExpression);
+    BINARY_VISIT(GreaterExpression);
+    BINARY_VISIT(LesserExpression);
+    BINARY_VISIT(GreaterEqualExpression);
+    BINARY_VISIT(LesserEqualExpression);
+    BINARY_VISIT(PlusExpression);
+    BINARY_VISIT(MinusExpression);
+    BINARY_VISIT(MultiplyExpression);
+    BINARY_VISIT(DivideExpression);
+    BINARY_VISIT(FloorDivideExpression);
+    BINARY_VISIT(ModuloExpression);
+    BINARY_VISIT(ExponentExpression);
+    BINARY_VISIT(SubscriptExpression);
+
+    void visit(UnaryMinusExpression &visited) override
+    {
+        visited.value->accept(*this);
+    }
+
+    void visit(NotExpression &visited) override
+    {
+        visited.value->accept(*this);
+    }
+
+    void visit(IsExpression &visited) override
+    {
+        visited.left->accept(*this);
+        addType(visited.right);
+    }
+
+    void visit(DotExpression &visited) override
+    {
+        visited.value->accept(*this);
+    }
+
+    void visit(StructExpression &visited) override
+    {
+        visitAll(visited.arguments);
+        if(visited.structType)
+            addName(*visited.structType);
+    }
+
+    void visit(CastExpression &visited) override
+    {
+        visited.value->accept(*this);
+        addType(visited.targetType);
+    }
+
+    void visit(VariableDeclaration &visited) override
+    {
+        addType(visited.type);
+    }
+
+    void visit(VariableDeclStatement &visited) override
+    {
+        visit(visited.declaration);
+        if(visited.value)
+            visited.value->accept(*this);
+    }
+
+    void visit(Assignable &visited) override
+    {
+        if(visited.left)
+            visit(*visited.left);
+        if(visited.index)
+            visited.index->accept(*this);
+    }
+
+    void visit(AssignmentStatement &visited) override
+    {
+        visit(visited.left);
+        visited.right->accept(*this);
+    }
+
+    // calls of types are casts or initializations of structs and variants
+    void visit(FunctionCall &visited) override
+    {
+        addName(visited.functionName);
+        visitAll(visited.arguments);
+    }
+
+    void visit(FunctionCallInstruction &visited) override
+    {
+        visit(visited.functionCall);
+    }
+
+    void visit(SpawnExpression &visited) override
+    {
+        visit(visited.functionCall);
+    }
+
+    void visit(ReturnStatement &visited) override
+    {
+        if(visited.returnValue)
+            visited.returnValue->accept(*this);
+    }
+
+    void visit(SingleIfCase &visited) override
+    {
+        if(auto declaration = std::get_if<VariableDeclStatement>(&visited.condition))
+            visit(*declaration);
+        else
+            std::get<std::unique_ptr<Expression>>(visited.condition)->accept(*this);
+        visitAll(visited.body);
+    }
+
+    void visit(IfStatement &visited) override
+    {
+        for(SingleIfCase &ifCase: visited.cases)
+            visit(ifCase);
+        visitAll(visited.elseCaseBody);
+    }
+
+    void visit(WhileStatement &visited) override
+    {
+        visited.condition->accept(*this);
+        visitAll(visited.body);
+    }
+
+    void visit(DoWhileStatement &visited) override
+    {
+        visited.condition->accept(*this);
+        visitAll(visited.body);
+    }
+
+    void visit(Field &visited) override
+    {
+        addType(visited.type);
+    }
+
+    void visit(StructDeclaration &visited) override
+    {
+        for(Field &field: visited.fields)
+            visit(field);
+    }
+
+    void visit(VariantDeclaration &visited) override
+    {
+        for(Field &field: visited.fields)
+            visit(field);
+    }
+
+    void visit(FunctionDeclaration &visited) override
+    {
+        visitSignature(visited);
+        visitAll(visited.getBody());
+    }
+
+    void visit(BuiltinFunctionDeclaration &visited) override
+    {
+        visitSignature(visited);
+    }
+private:
+    std::unordered_set<std::wstring> names;
+    std::vector<std::wstring> pending;
+
+    void addType(const Type &type)
+    {
+        if(auto name = std::get_if<std::wstring>(&type.value))
+            addName(*name);
+        else if(auto initializationList = std::get_if<Type::InitializationList>(&type.value))
+        {
+            for(const Type &element: *initializationList)
+                addType(element);
+        }
+        else if(type.isArray())
+            addType(type.getElementType());
+        else if(type.isDictionary())
+        {
+            addType(type.getKeyType());
+            addType(type.getValueType());
+        }
+        else if(type.isTask())
+            addType(type.getResultType());
+    }
+
+    void visitSignature(BaseFunctionDeclaration &visited)
+    {
+        for(VariableDeclaration &parameter: visited.parameters)
+            visit(parameter);
+        if(visited.returnType)
+            addType(*visited.returnType);
+    }
+
+    template <typename Node>
+    void visitAll(std::vector<std::unique_ptr<Node>> &nodes)
+    {
+        for(auto &node: nodes)
+            node->accept(*this);
+    }
+};
+
+template <typename Declaration>
+std::vector<std::wstring> eraseUnreachable(
+    std::unordered_map<std::wstring, Declaration> &declarations, const ReferenceCollector &collector
+)
+{
+    std::vector<std::wstring> erased;
+    std::erase_if(declarations, [&](const auto &entry) {
+        if(collector.contains(entry.first))
+            return false;
+        erased.push_back(entry.first);
+        return true;
+    });
+    std::sort(erased.begin(), erased.end());
+    return erased;
+}
+}
+
+void PrunedDeclarations::printReport(std::wostream &out) const
+{
+    out << std::format(
+        L"Pruned {} functions, {} structs and {} variants unreachable from main\n", functions.size(), structs.size(),
+        variants.size()
+    );
+    for(const FunctionIdentification &id: functions)
+        out << std::format(L"function {}\n", id);
+    for(const std::wstring &name: structs)
+        out << std::format(L"struct {}\n", name);
+    for(const std::wstring &name: variants)
+        out << std::format(L"variant {}\n", name);
+}
+
+PrunedDeclarations pruneUnreachable(Program &program)
+{
+    if(!program.functions.contains(FunctionIdentification(L"main", {})))
+        return {};
+    std::unordered_map<std::wstring, std::vector<BaseFunctionDeclaration *>> overloads;
+    for(auto &[id, function]: program.functions)
+        overloads[id.name].push_back(function.get());
+
+    ReferenceCollector collector;
+    collector.addName(L"main");
+    while(auto name = collector.nextPending())
+    {
+        if(auto found = overloads.find(*name); found != overloads.end())
+        {
+            for(BaseFunctionDeclaration *function: found->second)
+                function->accept(collector);
+        }
+        else if(auto structFound = program.structs.find(*name); structFound != program.structs.end())
+            collector.visit(structFound->second);
+        else if(auto variantFound = program.variants.find(*name); variantFound != program.variants.end())
+            collector.visit(variantFound->second);
+    }
+
+    PrunedDeclarations pruned;
+    std::erase_if(program.functions, [&](const auto &entry) {
+        if(collector.contains(entry.first.name))
+            return false;
+        pruned.functions.push_back(entry.first);
+        return true;
+    });
+    std::sort(pruned.functions.begin(), pruned.functions.end(), [](const auto &left, const auto &right) {
+        return std::format(L"{}", left) < std::format(L"{}", right);
+    });
+    pruned.structs = eraseUnreachable(program.structs, collector);
+    pruned.variants = eraseUnreachable(program.variants, collector);
+    return pruned;
+}
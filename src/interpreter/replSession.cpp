@@ -0,0 +1,54 @@
+#include "replSession.hpp"
+
+#include "builtinFunctions.hpp"
+#include "includeExecution.hpp"
+
+namespace {
+Program prepareProgram(
+    Program loaded, std::vector<std::wstring> &sourceFiles, std::function<Program(const std::wstring &)> parseFromFile
+)
+{
+    Program program = prepareBuiltinFunctions(loaded.getPosition());
+    mergePrograms(program, loaded);
+    executeIncludes(program, sourceFiles, parseFromFile);
+    return program;
+}
+}
+
+ReplSession::ReplSession(
+    Program program, std::vector<std::wstring> sourceFiles, std::function<Program(const std::wstring &)> parseFromFile,
+    std::vector<std::wstring> arguments, std::wistream &input, std::wostream &output, ExecutionLimits limits
+):
+    sourceFiles(std::move(sourceFiles)), parseFromFile(parseFromFile),
+    program(prepareProgram(std::move(program), this->sourceFiles, parseFromFile)), analysis(this->program),
+    interpreter(arguments, input, output, Interpreter::DEFAULT_MAX_STACK_SIZE, nullptr, nullptr, nullptr, limits)
+{}
+
+void ReplSession::enter(ReplEntry entry, const std::wstring &source)
+{
+    std::vector<std::wstring> previousSourceFiles = sourceFiles;
+    try
+    {
+        executeIncludes(entry.declarations, sourceFiles, parseFromFile);
+        analysis.analyzeEntry(entry.declarations, entry.instructions, source);
+    }
+    catch(...)
+    {
+        sourceFiles = previousSourceFiles;
+        throw;
+    }
+    try
+    {
+        interpreter.executeInstructions(program, entry.instructions, source);
+    }
+    catch(...)
+    {
+        analysis.revertInstructions();
+        throw;
+    }
+}
+
+const IncrementalSemanticAnalysis &ReplSession::getAnalysis() const
+{
+    return analysis;
+}
@@ -0,0 +1,76 @@
+#include "samplingProfiler.hpp"
+
+#include <chrono>
+#include <format>
+
+SamplingProfiler::CallGuard::CallGuard(
+    SamplingProfiler &profiler, const FunctionIdentification &id, const BaseFunctionDeclaration &function,
+    Position callPosition
+): profiler(profiler)
+{
+    profiler.enterFunction(id, function, callPosition);
+}
+
+SamplingProfiler::CallGuard::~CallGuard()
+{
+    profiler.exitFunction();
+}
+
+SamplingProfiler::SamplingProfiler(unsigned frequency):
+    pendingSamples(0), sampler([this, frequency](std::stop_token stopToken) {
+        auto interval = std::chrono::nanoseconds(std::chrono::seconds(1)) / frequency;
+        std::unique_lock lock(samplerMutex);
+        while(true)
+        {
+            samplerWakeup.wait_for(lock, stopToken, interval, [] { return false; });
+            if(stopToken.stop_requested())
+                return;
+            pendingSamples.fetch_add(1, std::memory_order_relaxed);
+        }
+    })
+{}
+
+void SamplingProfiler::enterFunction(
+    const FunctionIdentification &id, const BaseFunctionDeclaration &function, Position callPosition
+)
+{
+    // samples requested before the call belong to the caller; those requested before execution started are dropped
+    if(callStack.empty())
+        pendingSamples.store(0, std::memory_order_relaxed);
+    else
+        takePendingSamples();
+    callStack.push_back({&id, &function, callPosition});
+}
+
+void SamplingProfiler::exitFunction()
+{
+    takePendingSamples();
+    callStack.pop_back();
+}
+
+void SamplingProfiler::recordSamples()
+{
+    unsigned samples = pendingSamples.exchange(0, std::memory_order_relaxed);
+    if(!callStack.empty())
+        foldedStacks[foldCallStack()] += samples;
+}
+
+std::wstring SamplingProfiler::foldCallStack() const
+{
+    std::wstring folded = std::format(L"{}", *callStack[0].id);
+    for(unsigned i = 1; i < callStack.size(); i++)
+    {
+        const Frame &frame = callStack[i];
+        folded += std::format(
+            L";{} ({}:{}:{})", *frame.id, callStack[i - 1].function->getSource(), frame.callPosition.line,
+            frame.callPosition.column
+        );
+    }
+    return folded;
+}
+
+void SamplingProfiler::writeFoldedStacks(std::wostream &out) const
+{
+    for(const auto &[stack, samples]: foldedStacks)
+        out << stack << L' ' << samples << L'\n';
+}
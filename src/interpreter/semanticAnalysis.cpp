@@ -1,13 +1,19 @@
 #include "semanticAnalysis.hpp"
 
+#include "builtinFunctions.hpp"
+#include "includeExecution.hpp"
+#include "parserExceptions.hpp"
+#include "scopedSymbolTable.hpp"
 #include "semanticExceptions.hpp"
 
 #include <algorithm>
 #include <functional>
 #include <iostream>
 #include <limits>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 using enum Type::Builtin;
 
@@ -18,19 +24,29 @@ namespace {
 class SemanticAnalyzer: public DocumentTreeVisitor
 {
 public:
-    explicit SemanticAnalyzer(Program &program):
-        program(program), noReturnFunctionPermitted(false), variantReadAccessPermitted(false), accessedVariant(false),
-        blockFurtherDotAccess(false), currentCallHasReturned(false), loopCounter(0)
+    explicit SemanticAnalyzer(Program &program, CallerIndex *callers = nullptr):
+        program(program), callers(callers), currentFunction(nullptr), noReturnFunctionPermitted(false),
+        variantReadAccessPermitted(false), accessedVariant(false), blockFurtherDotAccess(false),
+        currentCallHasReturned(false), loopCounter(0)
     {}
 
     void visit(Program &visited) override
+    {
+        checkNames(visited);
+        analyzeDeclarations(visited);
+    }
+
+    void checkNames(Program &visited)
     {
         if(!visited.includes.empty())
             throw IncludeInSemanticAnalysisError(
                 "Internal error - program's include statements should be executed before calling doSemanticAnalysis"
             );
-
         checkNameDuplicates(visited);
+    }
+
+    void analyzeDeclarations(Program &visited)
+    {
         for(const auto &[name, variant]: visited.variants)
         {
             checkStructOrVariant(name, variant);
@@ -38,17 +54,70 @@ public:
         }
         for(const auto &[name, structure]: visited.structs)
             checkStructOrVariant(name, structure);
-        for(auto &function: visited.functions)
-            function.second->accept(*this);
+        // the functions are collected first, as builtin functions on arrays are added during the analysis
+        std::vector<FunctionIdentification> functions;
+        for(const auto &[id, function]: visited.functions)
+            functions.push_back(id);
+        for(const FunctionIdentification &id: functions)
+            analyzeFunction(id, *visited.functions.at(id));
+    }
+
+    // Analyzes the structs, variants and functions with the given names, which have been added to an already analyzed
+    // program.
+    void analyzeAdded(const std::vector<std::wstring> &types, const std::vector<FunctionIdentification> &functions)
+    {
+        checkAddedNameDuplicates(types, functions);
+        for(const std::wstring &name: types)
+        {
+            if(auto variantFound = findIn(program.variants, name))
+            {
+                checkStructOrVariant(name, (*variantFound)->second);
+                checkFieldTypeDuplicates((*variantFound)->second.fields);
+            }
+            else
+                checkStructOrVariant(name, program.structs.at(name));
+        }
+        for(const FunctionIdentification &id: functions)
+            analyzeFunction(id, *program.functions.at(id));
+    }
+
+    void analyzeFunction(const FunctionIdentification &id, BaseFunctionDeclaration &function)
+    {
+        currentFunction = &id;
+        function.accept(*this);
+        currentFunction = nullptr;
+    }
+
+    // Analyzes instructions executed outside of any function. The variables they declare are added to the given ones.
+    void analyzeTopLevelInstructions(
+        std::vector<std::unique_ptr<Instruction>> &instructions, const std::wstring &source,
+        std::unordered_map<std::wstring, std::pair<Type, bool>> &variables
+    )
+    {
+        currentSource = source;
+        variableTypes.reset(variables);
+        parameterNames.clear();
+        expectedReturnType = std::nullopt;
+        currentCallHasReturned = false;
+        visitInstructions(instructions);
+        variables = variableTypes.getVisible();
     }
 private:
     Program &program;
+    // Set to nullptr when the callers of functions are not recorded.
+    CallerIndex *callers;
+    // Set to nullptr outside of a function, or when the analyzed function is not a part of the program.
+    const FunctionIdentification *currentFunction;
     std::wstring currentSource;
     // Return type expected by the currently analyzed FunctionDeclaration.
     std::optional<Type> expectedReturnType;
     // Type and mutability of the last analyzed expression. Temporaries are treated as immutable.
     std::pair<Type, bool> lastExpressionType;
-    std::vector<std::unordered_map<std::wstring, std::pair<Type, bool>>> variableTypeScopes;
+    // Type and mutability of the variables visible in the analyzed code.
+    ScopedSymbolTable<std::pair<Type, bool>> variableTypes;
+    // Parameters of the analyzed function. They may refer to the same object as other parameters, so they can be
+    // modified through another name.
+    std::unordered_set<std::wstring> parameterNames;
     // Set to true only when a FunctionCall may not return a value (that is, one directly in a FunctionCallInstruction)
     bool noReturnFunctionPermitted;
     // Set to true only in a VariableDeclStatement in an if condition, where variant access (via dot or implicit
@@ -64,20 +133,19 @@ private:
     // Set to something other than nullptr when an expression detects that it should be replaced by another expression.
     std::unique_ptr<Expression> toReplace;
     unsigned loopCounter;
+    // Number of the places in the innermost analyzed while loop that may modify each variable: assignments and mutable
+    // arguments of function calls.
+    std::unordered_map<std::wstring, unsigned> modifiedVariables;
 
     void visit(Literal &visited) override
     {
         lastExpressionType = {visited.getType(), false};
     }
 
-    std::optional<std::pair<Type, bool>> getVariableType(const std::wstring &name)
+    // Returns nullptr if there is no visible variable with the name.
+    const std::pair<Type, bool> *getVariableType(const std::wstring &name) const
     {
-        for(auto scope: variableTypeScopes)
-        {
-            if(auto found = findIn(scope, name))
-                return (*found)->second;
-        }
-        return std::nullopt;
+        return variableTypes.find(name);
     }
 
     void visit(Variable &visited) override
@@ -98,8 +166,21 @@ private:
         toReplace = nullptr;
     }
 
+    // Conversions inserted by an earlier analysis are removed, so that an expression analyzed again, for example after
+    // new overloads of the functions it calls were declared, is analyzed the same way as for the first time.
+    void removeImplicitCasts(std::unique_ptr<Expression> &expression)
+    {
+        while(auto cast = dynamic_cast<CastExpression *>(expression.get()))
+        {
+            if(!cast->isImplicit)
+                return;
+            expression = std::move(cast->value);
+        }
+    }
+
     void visitExpression(std::unique_ptr<Expression> &expression)
     {
+        removeImplicitCasts(expression);
         variantReadAccessPermitted = false;
         expression->accept(*this);
         doReplacement(expression);
@@ -107,7 +188,7 @@ private:
 
     bool isStructInitListValid(Type::InitializationList typeFrom, Type typeTo)
     {
-        if(typeTo.isBuiltin())
+        if(typeTo.isBuiltin() || typeTo.isCollection() || typeTo.isTask())
             return false;
         auto structFound = findIn(program.structs, std::get<std::wstring>(typeTo.value));
         if(!structFound)
@@ -116,7 +197,7 @@ private:
         if(typeFrom.size() != structFields.size())
             return false;
         for(unsigned i = 0; i < typeFrom.size(); i++)
-            if(!areTypesConvertible(typeFrom[i], structFields[i].type))
+            if(!isConvertibleOrEqual(typeFrom[i], structFields[i].type))
                 return false;
         return true;
     }
@@ -129,17 +210,50 @@ private:
         return getField(variantFields, fieldType);
     }
 
+    bool isConvertibleOrEqual(const Type &typeFrom, const Type &typeTo)
+    {
+        return typeFrom == typeTo || areTypesConvertible(typeFrom, typeTo);
+    }
+
+    bool isArrayInitListValid(const Type::InitializationList &typeFrom, const Type &elementType)
+    {
+        return std::all_of(typeFrom.begin(), typeFrom.end(), [&](const Type &type) {
+            return isConvertibleOrEqual(type, elementType);
+        });
+    }
+
+    // Every element of the list must be a pair of a key and a value.
+    bool isDictionaryInitListValid(const Type::InitializationList &typeFrom, const Type &dictionaryType)
+    {
+        return std::all_of(typeFrom.begin(), typeFrom.end(), [&](const Type &type) {
+            if(!type.isInitList())
+                return false;
+            const Type::InitializationList &pair = std::get<Type::InitializationList>(type.value);
+            return pair.size() == 2 && isConvertibleOrEqual(pair[0], dictionaryType.getKeyType()) &&
+                   isConvertibleOrEqual(pair[1], dictionaryType.getValueType());
+        });
+    }
+
     bool areTypesConvertible(Type typeFrom, Type typeTo)
     {
-        if(typeTo.isInitList())
+        if(typeTo.isInitList() || typeTo.isTask())
             return false;
+        if(typeTo.isArray())
+            return typeFrom.isInitList() &&
+                   isArrayInitListValid(std::get<Type::InitializationList>(typeFrom.value), typeTo.getElementType());
+        if(typeTo.isDictionary())
+            return typeFrom.isInitList() &&
+                   isDictionaryInitListValid(std::get<Type::InitializationList>(typeFrom.value), typeTo);
         if(typeFrom.isInitList())
             return isStructInitListValid(std::get<Type::InitializationList>(typeFrom.value), typeTo);
+        // collections are only convertible to the variants which have them as alternatives
         if(!typeTo.isBuiltin())
         {
             std::wstring typeName = std::get<std::wstring>(typeTo.value);
             return isFieldOfVariant(typeName, typeFrom);
         }
+        if(typeFrom.isCollection() || typeFrom.isTask())
+            return false;
         return typeFrom.isBuiltin();
     }
 
@@ -167,6 +281,36 @@ private:
         }
     }
 
+    void setArrayExpressionType(
+        StructExpression &expression, const Type &arrayType, const Type::InitializationList &arrayInitListType
+    )
+    {
+        expression.collectionType = arrayType;
+        const Type &elementType = arrayType.getElementType();
+        for(unsigned i = 0; i < arrayInitListType.size(); i++)
+        {
+            if(arrayInitListType[i] != elementType)
+                insertCast(expression.arguments[i], arrayInitListType[i], elementType);
+        }
+    }
+
+    // The pairs stay untyped initialization lists - only their keys and values are converted.
+    void setDictionaryExpressionType(
+        StructExpression &expression, const Type &dictionaryType, const Type::InitializationList &dictionaryInitListType
+    )
+    {
+        expression.collectionType = dictionaryType;
+        for(unsigned i = 0; i < dictionaryInitListType.size(); i++)
+        {
+            auto &pair = static_cast<StructExpression &>(*expression.arguments[i]);
+            auto &pairType = std::get<Type::InitializationList>(dictionaryInitListType[i].value);
+            if(pairType[0] != dictionaryType.getKeyType())
+                insertCast(pair.arguments[0], pairType[0], dictionaryType.getKeyType());
+            if(pairType[1] != dictionaryType.getValueType())
+                insertCast(pair.arguments[1], pairType[1], dictionaryType.getValueType());
+        }
+    }
+
     void insertCast(std::unique_ptr<Expression> &expression, Type typeFrom, Type typeTo)
     {
         if(!areTypesConvertible(typeFrom, typeTo))
@@ -174,13 +318,25 @@ private:
                 std::format(L"Implicit conversion between types {} and {} is impossible", typeFrom, typeTo),
                 currentSource, expression->getPosition()
             );
-        if(typeFrom.isInitList()) // the type is an initialization list, so it must be a StructExpression
+        if(typeTo.isArray()) // only initialization lists are convertible to arrays and dictionaries
+            setArrayExpressionType(
+                *static_cast<StructExpression *>(expression.get()), typeTo,
+                std::get<Type::InitializationList>(typeFrom.value)
+            );
+        else if(typeTo.isDictionary())
+            setDictionaryExpressionType(
+                *static_cast<StructExpression *>(expression.get()), typeTo,
+                std::get<Type::InitializationList>(typeFrom.value)
+            );
+        else if(typeFrom.isInitList()) // the type is an initialization list, so it must be a StructExpression
             setStructExpressionType(
                 *static_cast<StructExpression *>(expression.get()), std::get<std::wstring>(typeTo.value),
                 std::get<Type::InitializationList>(typeFrom.value)
             );
         else
-            expression = std::make_unique<CastExpression>(expression->getPosition(), std::move(expression), typeTo);
+            expression = std::make_unique<CastExpression>(
+                expression->getPosition(), std::move(expression), typeTo, true
+            );
     }
 
     void ensureExpressionHasType(std::unique_ptr<Expression> &expression, Type desiredType)
@@ -406,7 +562,23 @@ private:
 
     void visit(SubscriptExpression &visited) override
     {
-        ensureExpressionHasType(visited.left, Type{STR});
+        visitExpression(visited.left);
+        if(lastExpressionType.first.isArray())
+        {
+            auto [arrayType, isMutable] = lastExpressionType;
+            ensureExpressionHasType(visited.right, Type{INT});
+            lastExpressionType = {arrayType.getElementType(), isMutable};
+            return;
+        }
+        if(lastExpressionType.first.isDictionary())
+        {
+            auto [dictionaryType, isMutable] = lastExpressionType;
+            ensureExpressionHasType(visited.right, dictionaryType.getKeyType());
+            lastExpressionType = {dictionaryType.getValueType(), isMutable};
+            return;
+        }
+        if(lastExpressionType.first != Type{STR})
+            insertCast(visited.left, lastExpressionType.first, Type{STR});
         ensureExpressionHasType(visited.right, Type{INT});
         lastExpressionType = {{STR}, false};
     }
@@ -427,8 +599,11 @@ private:
             throw InvalidInitListError(
                 L"Structure initialization list is not allowed with '.' operator", currentSource, position
             );
-        if(lastExpressionType.first.isBuiltin())
-            throw FieldAccessError(L"Attempted access to field of simple type {}", currentSource, position);
+        if(lastExpressionType.first.isBuiltin() || lastExpressionType.first.isCollection() ||
+           lastExpressionType.first.isTask())
+            throw FieldAccessError(
+                std::format(L"Attempted access to field of type {}", lastExpressionType.first), currentSource, position
+            );
         return std::get<std::wstring>(leftType.value);
     }
 
@@ -512,13 +687,20 @@ private:
             return false;
         if(type.isBuiltin())
             return true;
+        if(type.isArray())
+            return isValidType(type.getElementType());
+        if(type.isDictionary())
+            return (type.getKeyType() == Type{INT} || type.getKeyType() == Type{STR}) &&
+                   isValidType(type.getValueType());
+        if(type.isTask())
+            return isValidType(type.getResultType());
         std::wstring typeName = std::get<std::wstring>(type.value);
         return findIn(program.structs, typeName) || findIn(program.variants, typeName);
     }
 
     void addVariableType(const std::wstring &name, const std::pair<Type, bool> &type)
     {
-        variableTypeScopes[variableTypeScopes.size() - 1].insert({name, type});
+        variableTypes.declare(name, type);
     }
 
     void visit(VariableDeclaration &visited) override
@@ -537,7 +719,7 @@ private:
 
     std::vector<Field> *getVariantFields(Type type)
     {
-        if(type.isInitList() || type.isBuiltin())
+        if(type.isInitList() || type.isBuiltin() || type.isCollection() || type.isTask())
             return nullptr;
         std::wstring typeName = std::get<std::wstring>(type.value);
         auto fields = findIn(program.variants, typeName);
@@ -588,6 +770,7 @@ private:
         bool shouldAccessVariant = variantReadAccessPermitted;
         accessedVariant = false;
         // not calling visitExpression not to clear variantReadAccessPermitted flag
+        removeImplicitCasts(visited.value);
         visited.value->accept(*this);
         doReplacement(visited.value);
         bool isValueVariant = validateConditionVariantAccess(visited, lastExpressionType.first, shouldAccessVariant);
@@ -607,6 +790,7 @@ private:
                 std::format(L"Attempted to modify immutable variable {}", visited.right), currentSource,
                 visited.getPosition()
             );
+        modifiedVariables[visited.right] += 1;
         lastExpressionType = {variableFound->first, true};
     }
 
@@ -628,6 +812,24 @@ private:
         );
     }
 
+    void visitElementAssignable(Assignable &visited)
+    {
+        Type collectionType = lastExpressionType.first;
+        if(collectionType.isArray())
+        {
+            ensureExpressionHasType(visited.index, Type{INT});
+            lastExpressionType = {collectionType.getElementType(), true};
+            return;
+        }
+        if(!collectionType.isDictionary())
+            throw FieldAccessError(
+                std::format(L"Attempted assignment to element of type {}, which is not a collection", collectionType),
+                currentSource, visited.left->getPosition()
+            );
+        ensureExpressionHasType(visited.index, collectionType.getKeyType());
+        lastExpressionType = {collectionType.getValueType(), true};
+    }
+
     void visit(Assignable &visited) override
     {
         if(visited.left == nullptr)
@@ -639,7 +841,10 @@ private:
                 std::format(L"Attempted access to field of field of variant type"), currentSource,
                 visited.left->getPosition()
             );
-        if(lastExpressionType.first.isBuiltin())
+        if(visited.index)
+            return visitElementAssignable(visited);
+        if(lastExpressionType.first.isBuiltin() || lastExpressionType.first.isCollection() ||
+           lastExpressionType.first.isTask())
             throw FieldAccessError(
                 std::format(L"Attempted access to field of simple type {}", lastExpressionType.first), currentSource,
                 visited.left->getPosition()
@@ -985,15 +1190,116 @@ private:
         const std::unique_ptr<BaseFunctionDeclaration> &function = program.functions.at(*bestId);
 
         validateArgumentMutability(*bestId, function, argumentsMutable, visited.getPosition());
+        visited.runtimeResolved.clear();
         insertArgumentConversions(*bestId, visited.arguments, argumentTypes, {});
         return function->returnType;
     }
 
+    // Builtin functions operating on arrays, dictionaries and tasks are added to the program only for the types they
+    // are called with. Functions declared in the program take precedence over them.
+    void instantiateGenericBuiltins(const std::wstring &functionName, const std::vector<Type> &argumentTypes)
+    {
+        if(argumentTypes.empty())
+            return;
+        std::vector<BuiltinFunction> builtins;
+        if(argumentTypes[0].isArray())
+            builtins = prepareArrayBuiltinFunctions(argumentTypes[0]);
+        else if(argumentTypes[0].isDictionary())
+            builtins = prepareDictionaryBuiltinFunctions(argumentTypes[0]);
+        else if(argumentTypes[0].isTask())
+            builtins = prepareTaskBuiltinFunctions(argumentTypes[0]);
+        for(BuiltinFunction &builtin: builtins)
+        {
+            if(builtin.first.name == functionName && !program.functions.contains(builtin.first))
+                program.add(std::move(builtin));
+        }
+    }
+
+    // Returns the variable, a part of which is the value of the expression, if there is such a variable.
+    static const Variable *getRootVariable(const Expression *expression)
+    {
+        while(true)
+        {
+            if(auto dot = dynamic_cast<const DotExpression *>(expression))
+                expression = dot->value.get();
+            else if(auto subscript = dynamic_cast<const SubscriptExpression *>(expression))
+                expression = subscript->left.get();
+            else
+                return dynamic_cast<const Variable *>(expression);
+        }
+    }
+
+    static bool isReadFromCollection(const Expression *expression)
+    {
+        while(auto dot = dynamic_cast<const DotExpression *>(expression))
+            expression = dot->value.get();
+        return dynamic_cast<const SubscriptExpression *>(expression) != nullptr;
+    }
+
+    bool isPassedAsMutable(const FunctionCall &visited, unsigned argumentIndex)
+    {
+        return std::any_of(program.functions.begin(), program.functions.end(), [&](auto &entry) {
+            auto &[id, function] = entry;
+            return id.name == visited.functionName && argumentIndex < function->parameters.size() &&
+                   function->parameters[argumentIndex].isMutable;
+        });
+    }
+
+    // Arguments passed to mutable parameters of any overload are treated as modified, as the overload called may be
+    // resolved only at runtime. Array and dictionary elements passed to immutable parameters are copied, as the called
+    // function could otherwise move them by inserting into the collection through another argument. For the same
+    // reason such an element cannot be passed as mutable together with another mutable argument referring to the same
+    // variable. A part of a parameter passed as mutable is written back, as the parameter may refer to the same object
+    // as another argument, and so is a structure field passed together with its structure.
+    void recordMutableArguments(FunctionCall &visited, const std::vector<bool> &argumentsMutable)
+    {
+        visited.copiedArguments.clear();
+        visited.writtenBackArguments.clear();
+        std::vector<std::tuple<unsigned, const Variable *, bool>> mutableArguments;
+        for(unsigned i = 0; i < visited.arguments.size(); i++)
+        {
+            const Expression *argument = visited.arguments[i].get();
+            if(!argumentsMutable[i] || !isPassedAsMutable(visited, i))
+            {
+                if(isReadFromCollection(argument))
+                    visited.copiedArguments.push_back(i);
+                continue;
+            }
+            if(const Variable *variable = getRootVariable(argument))
+            {
+                modifiedVariables[variable->name] += 1;
+                mutableArguments.push_back({i, variable, isReadFromCollection(argument)});
+            }
+        }
+        for(const auto &[index, variable, isElement]: mutableArguments)
+        {
+            auto sameVariable = [&](const auto &other) {
+                return std::get<1>(other) != variable && std::get<1>(other)->name == variable->name;
+            };
+            bool isShared = std::any_of(mutableArguments.begin(), mutableArguments.end(), sameVariable);
+            if(isElement && isShared)
+                throw AliasedArgumentsError(
+                    std::format(
+                        L"Element of collection in variable {} cannot be passed as mutable argument together with "
+                        L"another mutable argument referring to the same variable",
+                        variable->name
+                    ),
+                    currentSource, visited.getPosition()
+                );
+            if(variable != visited.arguments[index].get() && (isShared || parameterNames.contains(variable->name)))
+                visited.writtenBackArguments.push_back(index);
+        }
+    }
+
     void visit(FunctionCall &visited) override
     {
         bool noReturnPermitted = noReturnFunctionPermitted;
         noReturnFunctionPermitted = false;
         auto [argumentTypes, argumentsMutable] = visitArguments(visited.arguments);
+        instantiateGenericBuiltins(visited.functionName, argumentTypes);
+        recordMutableArguments(visited, argumentsMutable);
+        if(callers && currentFunction)
+            (*callers)[visited.functionName].insert(*currentFunction);
         if(auto structFound = findIn(program.structs, visited.functionName))
             return visitStructFunctionCall(visited, argumentTypes);
         if(auto variantFound = findIn(program.variants, visited.functionName))
@@ -1016,6 +1322,36 @@ private:
         visit(visited.functionCall);
     }
 
+    bool takesMutableParameters(const FunctionCall &visited)
+    {
+        return std::any_of(program.functions.begin(), program.functions.end(), [&](auto &entry) {
+            auto &[id, function] = entry;
+            return id.name == visited.functionName && id.parameterTypes.size() == visited.arguments.size() &&
+                   std::any_of(function->parameters.begin(), function->parameters.end(), [](auto &parameter) {
+                       return parameter.isMutable;
+                   });
+        });
+    }
+
+    // The spawned call runs in parallel with its caller, so it gets copies of the arguments and no overload it may
+    // resolve to can take mutable parameters.
+    void visit(SpawnExpression &visited) override
+    {
+        FunctionCall &call = visited.functionCall;
+        if(findIn(program.structs, call.functionName) || findIn(program.variants, call.functionName))
+            throw InvalidSpawnError(
+                std::format(L"Only function calls can be spawned, {} is a type", call.functionName), currentSource,
+                visited.getPosition()
+            );
+        visit(call);
+        if(takesMutableParameters(call))
+            throw InvalidSpawnError(
+                std::format(L"Function {} taking mutable parameters cannot be spawned", call.functionName),
+                currentSource, visited.getPosition()
+            );
+        lastExpressionType = {{Type::Task(lastExpressionType.first)}, false};
+    }
+
     void visit(ReturnStatement &visited) override
     {
         if(!expectedReturnType || !visited.returnValue)
@@ -1075,17 +1411,17 @@ private:
 
     void visit(SingleIfCase &visited) override
     {
-        variableTypeScopes.push_back({});
+        variableTypes.enterScope();
         std::visit([&](auto &condition) { visitCondition(condition); }, visited.condition);
         visitInstructions(visited.body);
-        variableTypeScopes.pop_back();
+        variableTypes.exitScope();
     }
 
     void visitNewScope(std::vector<std::unique_ptr<Instruction>> &instructions)
     {
-        variableTypeScopes.push_back({});
+        variableTypes.enterScope();
         visitInstructions(instructions);
-        variableTypeScopes.pop_back();
+        variableTypes.exitScope();
     }
 
     void visit(IfStatement &visited) override
@@ -1106,12 +1442,61 @@ private:
         currentCallHasReturned = previousInstructionReturned || allPathsReturned;
     }
 
+    // Parameters are not local, as they may be modified through an aliasing parameter.
+    bool isLocalIntVariable(const std::wstring &name)
+    {
+        auto type = getVariableType(name);
+        return type && type->first == Type{INT} && !parameterNames.contains(name);
+    }
+
+    std::optional<CountedLoop> findCountedLoop(const WhileStatement &visited)
+    {
+        auto condition = dynamic_cast<const BinaryOperation *>(visited.condition.get());
+        bool isInclusive = dynamic_cast<const LesserEqualExpression *>(condition) != nullptr;
+        if(!isInclusive && !dynamic_cast<const LesserExpression *>(condition))
+            return std::nullopt;
+        auto counter = dynamic_cast<const Variable *>(condition->left.get());
+        if(!counter || visited.body.empty())
+            return std::nullopt;
+        auto counterModifications = modifiedVariables.find(counter->name);
+        if(!isLocalIntVariable(counter->name) || counterModifications == modifiedVariables.end() ||
+           counterModifications->second != 1)
+            return std::nullopt;
+
+        std::variant<int32_t, std::wstring> bound;
+        if(auto literal = dynamic_cast<const Literal *>(condition->right.get());
+           literal && std::holds_alternative<int32_t>(literal->value))
+            bound = std::get<int32_t>(literal->value);
+        else if(auto variable = dynamic_cast<const Variable *>(condition->right.get());
+                variable && isLocalIntVariable(variable->name) && !modifiedVariables.contains(variable->name))
+            bound = variable->name;
+        else
+            return std::nullopt;
+
+        // the only modification of the counter has to be the increment ending the body
+        auto increment = dynamic_cast<const AssignmentStatement *>(visited.body.back().get());
+        if(!increment || increment->left.left || increment->left.right != counter->name)
+            return std::nullopt;
+        auto sum = dynamic_cast<const PlusExpression *>(increment->right.get());
+        auto incremented = sum ? dynamic_cast<const Variable *>(sum->left.get()) : nullptr;
+        auto step = sum ? dynamic_cast<const Literal *>(sum->right.get()) : nullptr;
+        if(!incremented || incremented->name != counter->name || !step ||
+           !std::holds_alternative<int32_t>(step->value) || std::get<int32_t>(step->value) <= 0)
+            return std::nullopt;
+        return CountedLoop{counter->name, bound, isInclusive, std::get<int32_t>(step->value)};
+    }
+
     void visit(WhileStatement &visited) override
     {
+        std::unordered_map<std::wstring, unsigned> outerModifiedVariables = std::exchange(modifiedVariables, {});
         visitCondition(visited.condition);
         loopCounter += 1;
         visitNewScope(visited.body);
         loopCounter -= 1;
+        visited.countedLoop = findCountedLoop(visited);
+        for(auto &[name, modifications]: modifiedVariables)
+            outerModifiedVariables[name] += modifications;
+        modifiedVariables = std::move(outerModifiedVariables);
     }
 
     void visit(DoWhileStatement &visited) override
@@ -1124,9 +1509,13 @@ private:
 
     void parametersToVariables(std::vector<VariableDeclaration> &parameters)
     {
-        variableTypeScopes = {{}};
+        variableTypes.reset();
+        parameterNames.clear();
         for(VariableDeclaration &parameter: parameters)
+        {
             parameter.accept(*this);
+            parameterNames.insert(parameter.name);
+        }
     }
 
     void visit(FunctionDeclaration &visited) override
@@ -1135,7 +1524,7 @@ private:
         parametersToVariables(visited.parameters);
         expectedReturnType = visited.returnType;
         currentCallHasReturned = false;
-        visitInstructions(visited.body);
+        visitInstructions(visited.getBody());
         if(expectedReturnType && !currentCallHasReturned)
             throw InvalidReturnError(
                 L"Return with value is required in a function that returns a value", currentSource,
@@ -1165,6 +1554,49 @@ private:
         }
     }
 
+    void checkAddedNameDuplicates(
+        const std::vector<std::wstring> &types, const std::vector<FunctionIdentification> &functions
+    )
+    {
+        for(const FunctionIdentification &id: functions)
+        {
+            const BaseFunctionDeclaration &function = *program.functions.at(id);
+            if(auto variantFound = findIn(program.variants, id.name))
+                throw NameCollisionError(
+                    L"function " + id.name, function, L"variant " + (*variantFound)->first, (*variantFound)->second
+                );
+            if(auto structFound = findIn(program.structs, id.name))
+                throw NameCollisionError(
+                    L"function " + id.name, function, L"struct " + (*structFound)->first, (*structFound)->second
+                );
+        }
+        for(const std::wstring &name: types)
+        {
+            auto variantFound = findIn(program.variants, name);
+            auto structFound = findIn(program.structs, name);
+            if(variantFound && structFound)
+                throw NameCollisionError(
+                    L"variant " + name, (*variantFound)->second, L"struct " + name, (*structFound)->second
+                );
+            if(variantFound)
+                checkFunctionNameCollision(L"variant", name, (*variantFound)->second);
+            else
+                checkFunctionNameCollision(L"struct", name, (*structFound)->second);
+        }
+    }
+
+    template <typename StructOrVariantDeclaration>
+    void checkFunctionNameCollision(
+        const std::wstring &kind, const std::wstring &name, const StructOrVariantDeclaration &type
+    )
+    {
+        for(const auto &[id, function]: program.functions)
+        {
+            if(id.name == name)
+                throw NameCollisionError(L"function " + id.name, *function, kind + L" " + name, type);
+        }
+    }
+
     void checkFieldNameDuplicates(const std::vector<Field> &fields)
     {
         std::unordered_set<std::wstring> fieldNames;
@@ -1205,9 +1637,10 @@ private:
     }
 
     // Returns whether type1 (struct or variant type) is among the subtypes of type2.
+    // Arrays and dictionaries may be empty, so a type can contain collections of itself.
     bool isInSubtypes(const std::wstring &type1, const Type &type2)
     {
-        if(type2.isBuiltin() || type2.isInitList())
+        if(type2.isBuiltin() || type2.isInitList() || type2.isCollection() || type2.isTask())
             return false;
         std::wstring type2Name = std::get<std::wstring>(type2.value);
         if(type2Name == type1)
@@ -1268,3 +1701,117 @@ void doSemanticAnalysis(Program &program)
 {
     SemanticAnalyzer(program).visit(program);
 }
+
+PrunedDeclarations doReachableSemanticAnalysis(Program &program)
+{
+    SemanticAnalyzer analyzer(program);
+    // name collisions are reported also between the declarations that are going to be removed
+    analyzer.checkNames(program);
+    PrunedDeclarations pruned = pruneUnreachable(program);
+    analyzer.analyzeDeclarations(program);
+    return pruned;
+}
+
+IncrementalSemanticAnalysis::IncrementalSemanticAnalysis(Program &program): program(program), analyzedFunctions(0)
+{
+    SemanticAnalyzer analyzer(program, &callers);
+    analyzer.visit(program);
+    analyzedFunctions = program.functions.size();
+}
+
+void IncrementalSemanticAnalysis::analyzeEntry(
+    Program &declarations, std::vector<std::unique_ptr<Instruction>> &instructions, const std::wstring &source
+)
+{
+    if(!declarations.includes.empty())
+        throw IncludeInSemanticAnalysisError(
+            "Internal error - include statements should be executed before adding declarations to analysis"
+        );
+    std::vector<std::wstring> types;
+    std::vector<FunctionIdentification> functions;
+    for(const auto &[name, structure]: declarations.structs)
+    {
+        if(program.structs.contains(name))
+            throw DuplicateStructError(
+                std::format(L"Duplicate structure with name {}", name), structure.getSource(), structure.getPosition()
+            );
+        types.push_back(name);
+    }
+    for(const auto &[name, variant]: declarations.variants)
+    {
+        if(program.variants.contains(name))
+            throw DuplicateVariantError(
+                std::format(L"Duplicate variant with name {}", name), variant.getSource(), variant.getPosition()
+            );
+        types.push_back(name);
+    }
+    for(const auto &[id, function]: declarations.functions)
+    {
+        if(program.functions.contains(id))
+            throw DuplicateFunctionError(
+                std::format(L"Duplicate function with signature {}", id), function->getSource(),
+                function->getPosition()
+            );
+        functions.push_back(id);
+    }
+    mergePrograms(program, declarations);
+
+    // the functions calling the overloaded names were analyzed before the new overloads existed
+    std::unordered_set<std::wstring> overloadedNames;
+    for(const FunctionIdentification &id: functions)
+        overloadedNames.insert(id.name);
+    std::vector<FunctionIdentification> affected;
+    for(const std::wstring &name: overloadedNames)
+    {
+        auto found = callers.find(name);
+        if(found == callers.end())
+            continue;
+        for(const FunctionIdentification &caller: found->second)
+        {
+            // the callers recorded for removed functions are skipped
+            if(!declarations.functions.contains(caller) && program.functions.contains(caller))
+                affected.push_back(caller);
+        }
+    }
+    std::unordered_map<std::wstring, std::pair<Type, bool>> analyzedVariables = variables;
+    try
+    {
+        SemanticAnalyzer(program, &callers).analyzeAdded(types, functions);
+        analyzedFunctions += functions.size();
+        analyzeFunctions(affected);
+        SemanticAnalyzer(program).analyzeTopLevelInstructions(instructions, source, analyzedVariables);
+    }
+    catch(...)
+    {
+        for(const std::wstring &name: types)
+        {
+            program.structs.erase(name);
+            program.variants.erase(name);
+        }
+        for(const FunctionIdentification &id: functions)
+            program.functions.erase(id);
+        // the affected functions were valid without the new declarations, so they are valid again
+        analyzeFunctions(affected);
+        throw;
+    }
+    previousVariables = std::move(variables);
+    variables = std::move(analyzedVariables);
+}
+
+void IncrementalSemanticAnalysis::revertInstructions()
+{
+    variables = previousVariables;
+}
+
+void IncrementalSemanticAnalysis::analyzeFunctions(const std::vector<FunctionIdentification> &functions)
+{
+    SemanticAnalyzer analyzer(program, &callers);
+    for(const FunctionIdentification &id: functions)
+        analyzer.analyzeFunction(id, *program.functions.at(id));
+    analyzedFunctions += functions.size();
+}
+
+unsigned IncrementalSemanticAnalysis::getAnalyzedFunctions() const
+{
+    return analyzedFunctions;
+}
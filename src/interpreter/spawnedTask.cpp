@@ -0,0 +1,111 @@
+#include "spawnedTask.hpp"
+
+#include <chrono>
+#include <sstream>
+
+namespace {
+// Number of jobs the current thread runs nested in each other while waiting for tasks.
+thread_local unsigned helpingDepth = 0;
+}
+
+SpawnedTask::SpawnedTask(WorkStealingPool &pool, Call call, std::shared_ptr<const SpawnedTask> parent):
+    pool(pool), call(std::move(call)), parent(std::move(parent)), cancelled(false), started(false), finished(false),
+    joined(false)
+{}
+
+std::shared_ptr<SpawnedTask> SpawnedTask::spawn(
+    WorkStealingPool &pool, Call call, std::shared_ptr<const SpawnedTask> parent
+)
+{
+    std::shared_ptr<SpawnedTask> task(new SpawnedTask(pool, std::move(call), std::move(parent)));
+    pool.submit([task]() { task->run(); });
+    return task;
+}
+
+bool SpawnedTask::run()
+{
+    {
+        std::lock_guard lock(mutex);
+        if(started)
+            return false;
+        started = true;
+    }
+    std::wostringstream callOutput;
+    std::optional<Object> callResult;
+    std::exception_ptr callError;
+    try
+    {
+        callResult = call(callOutput, shared_from_this());
+    }
+    catch(...)
+    {
+        callError = std::current_exception();
+    }
+    {
+        std::lock_guard lock(mutex);
+        result = std::move(callResult);
+        error = callError;
+        output = callOutput.str();
+        finished = true;
+        // the call holds copies of the arguments, which are not needed anymore
+        call = nullptr;
+    }
+    finishedChanged.notify_all();
+    return true;
+}
+
+void SpawnedTask::wait()
+{
+    while(true)
+    {
+        {
+            std::lock_guard lock(mutex);
+            if(finished)
+                return;
+        }
+        // running the task itself grows the stack like a nested call, while other jobs could nest without bound
+        if(run())
+            continue;
+        if(helpingDepth < MAX_HELPING_DEPTH)
+        {
+            helpingDepth++;
+            bool ranJob = pool.runPendingJob();
+            helpingDepth--;
+            if(ranJob)
+                continue;
+        }
+        std::unique_lock lock(mutex);
+        finishedChanged.wait_for(lock, std::chrono::milliseconds(1), [&]() { return finished; });
+    }
+}
+
+Object SpawnedTask::join(std::wostream &joiningOutput)
+{
+    wait();
+    std::lock_guard lock(mutex);
+    if(!joined)
+    {
+        joined = true;
+        joiningOutput << output;
+        output.clear();
+    }
+    if(error)
+        std::rethrow_exception(error);
+    return Object(*result);
+}
+
+bool SpawnedTask::isJoined()
+{
+    std::lock_guard lock(mutex);
+    return joined;
+}
+
+void SpawnedTask::cancel()
+{
+    cancelled = true;
+}
+
+bool SpawnedTask::isCancelled() const
+{
+    return cancelled || (parent && parent->isCancelled());
+}
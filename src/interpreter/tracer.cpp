@@ -0,0 +1,62 @@
+#include "tracer.hpp"
+
+#include "jsonEscaping.hpp"
+
+#include <format>
+#include <iterator>
+
+Tracer::Span::Span(Tracer *tracer, std::wstring name, std::optional<std::wstring> file):
+    tracer(tracer), event(tracer ? tracer->beginEvent(std::move(name), std::move(file)) : 0)
+{}
+
+Tracer::Span::~Span()
+{
+    if(tracer)
+        tracer->endEvent(event);
+}
+
+Tracer::Tracer(): start(Clock::now()) {}
+
+const std::vector<Tracer::Event> &Tracer::getEvents() const
+{
+    return events;
+}
+
+unsigned Tracer::beginEvent(std::wstring name, std::optional<std::wstring> file)
+{
+    events.push_back({std::move(name), std::move(file), Clock::now() - start, {}});
+    return events.size() - 1;
+}
+
+void Tracer::endEvent(unsigned event)
+{
+    events[event].duration = Clock::now() - start - events[event].start;
+}
+
+namespace {
+double toMicroseconds(std::chrono::nanoseconds time)
+{
+    return std::chrono::duration<double, std::micro>(time).count();
+}
+}
+
+void Tracer::writeJson(std::wostream &out) const
+{
+    std::ostream_iterator<wchar_t, wchar_t> outIterator(out);
+    out << L"{\"traceEvents\": [";
+    for(unsigned i = 0; i < events.size(); i++)
+    {
+        // all phases are complete events of the only thread of the interpreter
+        std::format_to(
+            outIterator,
+            L"{}\n  {{\"name\": \"{}\", \"cat\": \"pipeline\", \"ph\": \"X\", \"ts\": {:.3f}, \"dur\": {:.3f}, "
+            L"\"pid\": 1, \"tid\": 1",
+            i == 0 ? L"" : L",", escapeJsonString(events[i].name), toMicroseconds(events[i].start),
+            toMicroseconds(events[i].duration)
+        );
+        if(events[i].file)
+            std::format_to(outIterator, L", \"args\": {{\"file\": \"{}\"}}", escapeJsonString(*events[i].file));
+        out << L"}";
+    }
+    out << L"\n], \"displayTimeUnit\": \"ms\"}\n";
+}
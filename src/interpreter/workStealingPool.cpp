@@ -0,0 +1,117 @@
+#include "workStealingPool.hpp"
+
+#include <algorithm>
+
+namespace {
+// Pool and queue index of the worker running on this thread.
+thread_local const WorkStealingPool *currentPool = nullptr;
+thread_local unsigned currentQueue = 0;
+}
+
+WorkStealingPool::WorkStealingPool(unsigned threads): pendingJobs(0), stopping(false), nextQueue(0)
+{
+    threads = std::max(threads, 1u);
+    for(unsigned i = 0; i < threads; i++)
+        queues.push_back(std::make_unique<Queue>());
+    for(unsigned i = 0; i < threads; i++)
+        this->threads.emplace_back([this, i]() { work(i); });
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard lock(sleepMutex);
+        stopping = true;
+    }
+    jobAdded.notify_all();
+    threads.clear();
+}
+
+void WorkStealingPool::submit(Job job)
+{
+    std::optional<unsigned> workerIndex = getWorkerIndex();
+    unsigned index = workerIndex ? *workerIndex : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    {
+        std::lock_guard lock(queues[index]->mutex);
+        queues[index]->jobs.push_back(std::move(job));
+    }
+    {
+        std::lock_guard lock(sleepMutex);
+        pendingJobs += 1;
+    }
+    jobAdded.notify_one();
+}
+
+bool WorkStealingPool::runPendingJob()
+{
+    std::optional<unsigned> workerIndex = getWorkerIndex();
+    std::optional<Job> job = takeJob(workerIndex ? *workerIndex : 0);
+    if(!job)
+        return false;
+    (*job)();
+    return true;
+}
+
+unsigned WorkStealingPool::getThreads() const
+{
+    return static_cast<unsigned>(queues.size());
+}
+
+WorkStealingPool &WorkStealingPool::getShared()
+{
+    static WorkStealingPool shared(std::thread::hardware_concurrency());
+    return shared;
+}
+
+std::optional<unsigned> WorkStealingPool::getWorkerIndex() const
+{
+    if(currentPool != this)
+        return std::nullopt;
+    return currentQueue;
+}
+
+std::optional<WorkStealingPool::Job> WorkStealingPool::takeJob(unsigned preferredQueue)
+{
+    {
+        Queue &own = *queues[preferredQueue];
+        std::lock_guard lock(own.mutex);
+        if(!own.jobs.empty())
+        {
+            Job job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            pendingJobs -= 1;
+            return job;
+        }
+    }
+    for(unsigned offset = 1; offset < queues.size(); offset++)
+    {
+        Queue &victim = *queues[(preferredQueue + offset) % queues.size()];
+        std::lock_guard lock(victim.mutex);
+        if(!victim.jobs.empty())
+        {
+            Job job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            pendingJobs -= 1;
+            return job;
+        }
+    }
+    return std::nullopt;
+}
+
+void WorkStealingPool::work(unsigned index)
+{
+    currentPool = this;
+    currentQueue = index;
+    while(true)
+    {
+        if(std::optional<Job> job = takeJob(index))
+        {
+            (*job)();
+            continue;
+        }
+        std::unique_lock lock(sleepMutex);
+        jobAdded.wait(lock, [&]() { return stopping || pendingJobs > 0; });
+        if(stopping && pendingJobs <= 0)
+            return;
+    }
+}
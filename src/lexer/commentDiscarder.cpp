@@ -14,3 +14,13 @@ Token CommentDiscarder::getNextToken()
         returned = lexer.getNextToken();
     return returned;
 }
+
+void CommentDiscarder::readTokens(TokenBatch &batch)
+{
+    while(!batch.isComplete())
+    {
+        size_t begin = batch.size();
+        lexer.readTokens(batch);
+        batch.removeTokens(TokenType::COMMENT, begin);
+    }
+}
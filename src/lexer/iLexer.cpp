@@ -0,0 +1,7 @@
+#include "iLexer.hpp"
+
+void ILexer::readTokens(TokenBatch &batch)
+{
+    while(!batch.isComplete())
+        batch.append(getNextToken());
+}
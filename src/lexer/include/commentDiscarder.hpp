@@ -6,6 +6,7 @@ public:
     explicit CommentDiscarder(ILexer &lexer);
     std::wstring getSourceName() override;
     Token getNextToken() override;
+    void readTokens(TokenBatch &batch) override;
 private:
     ILexer &lexer;
 };
@@ -2,6 +2,7 @@
 #define ILEXER_HPP
 
 #include "token.hpp"
+#include "tokenBatch.hpp"
 
 class ILexer
 {
@@ -9,6 +10,9 @@ public:
     virtual std::wstring getSourceName() = 0;
     // Returns next token constructed from input. After input ends, returns EOT token.
     virtual Token getNextToken() = 0;
+    // Appends the next tokens to the batch, until it is full or the EOT token is appended. The default implementation
+    // calls getNextToken for every token.
+    virtual void readTokens(TokenBatch &batch);
 
     virtual ~ILexer() = default;
 };
@@ -12,37 +12,53 @@
 class Lexer: public ILexer
 {
 public:
-    explicit Lexer(IReader &reader);
+    enum class CommentMode
+    {
+        EMIT,
+        // comments are skipped without building their tokens, their maximum size is still checked
+        SKIP,
+    };
+
+    explicit Lexer(IReader &reader, CommentMode commentMode = CommentMode::EMIT);
     std::wstring getSourceName() override;
     Token getNextToken() override;
+    // Builds the tokens directly in the batch, without constructing Token objects.
+    void readTokens(TokenBatch &batch) override;
 
-    static const int MAX_IDENTIFIER_SIZE = 40;
-    static const int MAX_COMMENT_SIZE = 100;
-    static const int MAX_STRING_SIZE = 100;
+    static constexpr size_t MAX_IDENTIFIER_SIZE = 40;
+    static constexpr size_t MAX_COMMENT_SIZE = 100;
+    static constexpr size_t MAX_STRING_SIZE = 100;
 private:
     IReader &reader;
     std::wstring sourceName;
+    CommentMode commentMode;
+    // value of the token being built, reused between tokens
+    std::wstring tokenText;
+    TokenBatch singleToken;
     void skipWhitespace();
+    void skipComments();
+    void buildNextToken(TokenBatch &batch);
+    // The tryBuild methods append the token to the batch and return true if it begins at the current character.
     // Will also build keywords and bool literals
-    std::optional<Token> tryBuildIdentifier();
-    std::optional<Token> tryBuildComment();
-    std::optional<Token> tryBuildString();
+    bool tryBuildIdentifier(TokenBatch &batch);
+    bool tryBuildComment(TokenBatch &batch);
+    bool tryBuildString(TokenBatch &batch);
     // Will build int or float literals
-    std::optional<Token> tryBuildNumber();
-    std::optional<Token> tryBuildFraction(int32_t integralPart);
+    bool tryBuildNumber(TokenBatch &batch);
+    bool tryBuildFraction(TokenBatch &batch, int32_t integralPart);
     // Returns the built integer and the number of leading zeros
     std::pair<int32_t, int> buildIntegerWithLeadingZeros();
     std::optional<std::pair<int32_t, int>> tryBuildFractionalPart();
     std::optional<int32_t> tryBuildExponent();
-    std::optional<Token> tryBuildOperator();
+    bool tryBuildOperator(TokenBatch &batch);
     TokenType build2CharOp(wchar_t second, TokenType oneCharType, TokenType twoCharType);
     TokenType build3CharOp(
         wchar_t second, wchar_t third, TokenType oneCharType, TokenType twoCharType, TokenType threeCharType
     );
     unsigned hexToNumber(wchar_t character);
     wchar_t buildHexChar();
-    void buildEscapeSequence(std::wstringstream &tokenValue);
-    std::unordered_map<wchar_t, std::function<Token(void)>> firstCharToFunction;
+    void buildEscapeSequence();
+    std::unordered_map<wchar_t, std::function<TokenType(void)>> firstCharToFunction;
     void prepareOperatorMap();
     Position tokenStart;
 };
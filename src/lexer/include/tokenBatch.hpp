@@ -0,0 +1,112 @@
+#ifndef TOKENBATCH_HPP
+#define TOKENBATCH_HPP
+
+#include "token.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class TokenBatch;
+
+// Token read from a TokenBatch. It is trivially copyable - the texts of identifiers, string literals and comments are
+// kept in the batch, which has to outlive the token.
+class BatchedToken
+{
+public:
+    TokenType getType() const
+    {
+        return type;
+    }
+
+    Position getPosition() const
+    {
+        return position;
+    }
+
+    // Returns the text of an identifier, a string literal or a comment.
+    std::wstring_view getText() const;
+    std::variant<std::monostate, std::wstring, int32_t, double> getValue() const;
+    Token toToken() const;
+private:
+    friend class TokenBatch;
+
+    const TokenBatch *batch;
+    TokenType type;
+    Position position;
+
+    union
+    {
+        int32_t integer;
+        double floating;
+
+        struct
+        {
+            uint32_t offset, length;
+        } text;
+    } value;
+
+    BatchedToken(const TokenBatch &batch, TokenType type, Position position);
+};
+
+// Buffer filled with many tokens at once by ILexer::readTokens. Removing the tokens keeps their texts, so tokens copied
+// out of the batch stay valid until the batch is destroyed.
+class TokenBatch
+{
+public:
+    static constexpr size_t CAPACITY = 256;
+
+    TokenBatch() = default;
+    // The tokens refer to the batch by its address.
+    TokenBatch(const TokenBatch &) = delete;
+
+    void append(TokenType type, Position position);
+    void append(TokenType type, Position position, std::wstring_view text);
+    void append(TokenType type, Position position, int32_t value);
+    void append(TokenType type, Position position, double value);
+    void append(const Token &token);
+    // Appends a copy of the token, which can come from another batch.
+    void append(const BatchedToken &token);
+
+    size_t size() const
+    {
+        return tokens.size();
+    }
+
+    const BatchedToken &operator[](size_t index) const
+    {
+        return tokens[index];
+    }
+
+    const BatchedToken &back() const
+    {
+        return tokens.back();
+    }
+
+    // Returns whether the batch is full or ends with the EOT token, after which no tokens should be appended.
+    bool isComplete() const;
+    // Removes the tokens of the given type, beginning from the given index.
+    void removeTokens(TokenType type, size_t begin);
+    // Removes the tokens, keeping their texts.
+    void clearTokens();
+    // Removes the tokens and their texts, which invalidates the tokens copied out of the batch.
+    void clear();
+private:
+    friend class BatchedToken;
+
+    std::vector<BatchedToken> tokens;
+    std::wstring texts;
+};
+
+template <>
+struct std::formatter<BatchedToken, wchar_t>: std::formatter<Token, wchar_t>
+{
+    template <class FormatContext>
+    auto format(BatchedToken token, FormatContext &context) const
+    {
+        return std::formatter<Token, wchar_t>::format(token.toToken(), context);
+    }
+};
+
+#endif
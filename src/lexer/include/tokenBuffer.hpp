@@ -0,0 +1,21 @@
+#ifndef TOKENBUFFER_HPP
+#define TOKENBUFFER_HPP
+
+#include "iLexer.hpp"
+
+#include <vector>
+
+// Reads all tokens from the given lexer on construction, up to and including EOT, and then returns them one by one.
+class TokenBuffer: public ILexer
+{
+public:
+    explicit TokenBuffer(ILexer &lexer);
+    std::wstring getSourceName() override;
+    Token getNextToken() override;
+private:
+    std::wstring sourceName;
+    std::vector<Token> tokens;
+    unsigned next;
+};
+
+#endif
@@ -19,6 +19,7 @@ enum class TokenType
     KW_ELSE,
     KW_WHILE,
     KW_DO,
+    KW_SPAWN,
     KW_IS,
     KW_OR,
     KW_XOR,
@@ -28,6 +29,7 @@ enum class TokenType
     KW_FLOAT,
     KW_BOOL,
     KW_STR,
+    KW_TASK,
     LBRACE,
     RBRACE,
     SEMICOLON,
@@ -5,7 +5,6 @@
 
 #include <cmath>
 #include <format>
-#include <sstream>
 #include <string>
 #include <unordered_map>
 
@@ -25,6 +24,7 @@ const std::unordered_map<std::wstring, TokenType> keywordToTokenType = {
     {L"else", KW_ELSE},
     {L"while", KW_WHILE},
     {L"do", KW_DO},
+    {L"spawn", KW_SPAWN},
     {L"is", KW_IS},
     {L"or", KW_OR},
     {L"xor", KW_XOR},
@@ -34,12 +34,14 @@ const std::unordered_map<std::wstring, TokenType> keywordToTokenType = {
     {L"float", KW_FLOAT},
     {L"bool", KW_BOOL},
     {L"str", KW_STR},
+    {L"task", KW_TASK},
     {L"true", TRUE_LITERAL},
     {L"false", FALSE_LITERAL},
 };
 }
 
-Lexer::Lexer(IReader &reader): reader(reader), sourceName(reader.getSourceName())
+Lexer::Lexer(IReader &reader, CommentMode commentMode):
+    reader(reader), sourceName(reader.getSourceName()), commentMode(commentMode)
 {
     prepareOperatorMap();
 }
@@ -55,45 +57,57 @@ void Lexer::skipWhitespace()
         reader.next();
 }
 
-std::optional<Token> Lexer::tryBuildIdentifier()
+bool Lexer::tryBuildIdentifier(TokenBatch &batch)
 {
     wchar_t current = reader.get().first;
     if(!(std::iswalpha(current) || current == L'_'))
-        return std::nullopt;
+        return false;
 
-    std::wstringstream tokenValue;
-    tokenValue.put(current);
+    tokenText.assign(1, current);
     current = reader.next().first;
 
     while(std::isalnum(current) || current == L'_' || current == L'\'')
     {
-        tokenValue.put(current);
-        if(tokenValue.tellp() > MAX_IDENTIFIER_SIZE)
+        tokenText.push_back(current);
+        if(tokenText.size() > MAX_IDENTIFIER_SIZE)
             throw IdentifierTooLongError(L"Maximum identifier size exceeded", sourceName, tokenStart);
         current = reader.next().first;
     }
-    std::wstring result = tokenValue.str();
-    if(keywordToTokenType.find(result) != keywordToTokenType.end())
-        return Token(keywordToTokenType.at(result), tokenStart);
+    if(auto keyword = keywordToTokenType.find(tokenText); keyword != keywordToTokenType.end())
+        batch.append(keyword->second, tokenStart);
     else
-        return Token(IDENTIFIER, tokenStart, result);
+        batch.append(IDENTIFIER, tokenStart, tokenText);
+    return true;
 }
 
-std::optional<Token> Lexer::tryBuildComment()
+void Lexer::skipComments()
+{
+    while(reader.get().first == L'#')
+    {
+        tokenStart = reader.get().second;
+        reader.next();
+        if(reader.skipLine() > MAX_COMMENT_SIZE)
+            throw CommentTooLongError(L"Maximum comment size exceeded", sourceName, tokenStart);
+        skipWhitespace();
+    }
+}
+
+bool Lexer::tryBuildComment(TokenBatch &batch)
 {
     if(reader.get().first != L'#')
-        return std::nullopt;
+        return false;
 
     wchar_t current = reader.next().first;
-    std::wstringstream tokenValue;
+    tokenText.clear();
     while(current != L'\n' && current != IReader::EOT)
     {
-        tokenValue.put(current);
-        if(tokenValue.tellp() > MAX_COMMENT_SIZE)
+        tokenText.push_back(current);
+        if(tokenText.size() > MAX_COMMENT_SIZE)
             throw CommentTooLongError(L"Maximum comment size exceeded", sourceName, tokenStart);
         current = reader.next().first;
     }
-    return Token(COMMENT, tokenStart, tokenValue.str());
+    batch.append(COMMENT, tokenStart, tokenText);
+    return true;
 }
 
 unsigned Lexer::hexToNumber(wchar_t character)
@@ -120,28 +134,28 @@ wchar_t Lexer::buildHexChar()
     return static_cast<wchar_t>(first * 16 + second);
 }
 
-void Lexer::buildEscapeSequence(std::wstringstream &tokenValue)
+void Lexer::buildEscapeSequence()
 {
     switch(reader.get().first)
     {
     case L't':
-        tokenValue.put(L'\t');
+        tokenText.push_back(L'\t');
         break;
     case L'r':
-        tokenValue.put(L'\r');
+        tokenText.push_back(L'\r');
         break;
     case L'n':
-        tokenValue.put(L'\n');
+        tokenText.push_back(L'\n');
         break;
     case L'"':
-        tokenValue.put(L'"');
+        tokenText.push_back(L'"');
         break;
     case L'\\':
-        tokenValue.put(L'\\');
+        tokenText.push_back(L'\\');
         break;
     case L'x':
         reader.next();
-        tokenValue.put(buildHexChar());
+        tokenText.push_back(buildHexChar());
         break;
     case L'\n':
         throw NewlineInStringError(L"Newline character in string literal encountered", sourceName, tokenStart);
@@ -154,13 +168,13 @@ void Lexer::buildEscapeSequence(std::wstringstream &tokenValue)
     }
 }
 
-std::optional<Token> Lexer::tryBuildString()
+bool Lexer::tryBuildString(TokenBatch &batch)
 {
     if(reader.get().first != L'"')
-        return std::nullopt;
+        return false;
     wchar_t current = reader.next().first;
 
-    std::wstringstream tokenValue;
+    tokenText.clear();
     while(current != L'"')
     {
         if(current == L'\n')
@@ -170,18 +184,19 @@ std::optional<Token> Lexer::tryBuildString()
         else if(current == L'\\')
         {
             reader.next();
-            buildEscapeSequence(tokenValue);
+            buildEscapeSequence();
         }
         else
         {
-            tokenValue.put(current);
-            if(tokenValue.tellp() > MAX_STRING_SIZE)
+            tokenText.push_back(current);
+            if(tokenText.size() > MAX_STRING_SIZE)
                 throw StringTooLongError(L"Maximum string literal size exceeded", sourceName, tokenStart);
         }
         current = reader.next().first;
     }
     reader.next();
-    return Token(STR_LITERAL, tokenStart, tokenValue.str());
+    batch.append(STR_LITERAL, tokenStart, tokenText);
+    return true;
 }
 
 std::pair<int32_t, int> Lexer::buildIntegerWithLeadingZeros()
@@ -245,12 +260,12 @@ std::optional<int32_t> Lexer::tryBuildExponent()
     return exponent;
 }
 
-std::optional<Token> Lexer::tryBuildFraction(int32_t integralPart)
+bool Lexer::tryBuildFraction(TokenBatch &batch, int32_t integralPart)
 {
     auto fractionalPart = tryBuildFractionalPart();
     auto exponent = tryBuildExponent();
     if(!fractionalPart && !exponent)
-        return std::nullopt;
+        return false;
     if(!fractionalPart)
         fractionalPart = {0, 0};
     if(!exponent)
@@ -258,26 +273,25 @@ std::optional<Token> Lexer::tryBuildFraction(int32_t integralPart)
 
     double value = integralPart * std::pow(10., *exponent) +
                    static_cast<double>(fractionalPart->first) * std::pow(10., *exponent - fractionalPart->second);
-    return Token(FLOAT_LITERAL, tokenStart, value);
+    batch.append(FLOAT_LITERAL, tokenStart, value);
+    return true;
 }
 
-std::optional<Token> Lexer::tryBuildNumber()
+bool Lexer::tryBuildNumber(TokenBatch &batch)
 {
     if(!std::iswdigit(reader.get().first))
-        return std::nullopt;
+        return false;
     auto [integralPart, leadingZeros] = buildIntegerWithLeadingZeros();
     if((integralPart != 0 && leadingZeros > 0) || leadingZeros > 1)
         throw IntWithLeadingZeroError(L"Leading zeros in numeric constant are not permitted", sourceName, tokenStart);
 
-    std::optional<Token> tokenBuilt;
-    if((tokenBuilt = tryBuildFraction(integralPart)))
-        return tokenBuilt;
-
-    return Token(INT_LITERAL, tokenStart, integralPart);
+    if(!tryBuildFraction(batch, integralPart))
+        batch.append(INT_LITERAL, tokenStart, integralPart);
+    return true;
 }
 
 #define ADD_OPERATOR(firstChar, returnedType) \
-    firstCharToFunction.emplace(L##firstChar, [&]() { return Token(returnedType, tokenStart); });
+    firstCharToFunction.emplace(L##firstChar, [&]() { return returnedType; });
 
 void Lexer::prepareOperatorMap()
 {
@@ -332,29 +346,47 @@ TokenType Lexer::build3CharOp(
         return oneCharType;
 }
 
-std::optional<Token> Lexer::tryBuildOperator()
+bool Lexer::tryBuildOperator(TokenBatch &batch)
 {
-    wchar_t firstChar = reader.get().first;
-    if(firstCharToFunction.find(firstChar) == firstCharToFunction.end())
-        return std::nullopt;
+    auto buildOperator = firstCharToFunction.find(reader.get().first);
+    if(buildOperator == firstCharToFunction.end())
+        return false;
     reader.next();
-    return firstCharToFunction.at(firstChar)();
+    batch.append(buildOperator->second(), tokenStart);
+    return true;
 }
 
 Token Lexer::getNextToken()
+{
+    singleToken.clear();
+    buildNextToken(singleToken);
+    return singleToken.back().toToken();
+}
+
+void Lexer::readTokens(TokenBatch &batch)
+{
+    while(!batch.isComplete())
+        buildNextToken(batch);
+}
+
+void Lexer::buildNextToken(TokenBatch &batch)
 {
     skipWhitespace();
+    if(commentMode == CommentMode::SKIP)
+        skipComments();
     tokenStart = reader.get().second;
     if(reader.get().first == IReader::EOT)
-        return Token(EOT, tokenStart);
+    {
+        batch.append(EOT, tokenStart);
+        return;
+    }
 
-    std::optional<Token> tokenBuilt;
     for(auto tryBuild:
         {&Lexer::tryBuildOperator, &Lexer::tryBuildNumber, &Lexer::tryBuildString, &Lexer::tryBuildComment,
          &Lexer::tryBuildIdentifier})
     {
-        if((tokenBuilt = std::invoke(tryBuild, this)))
-            return *tokenBuilt;
+        if(std::invoke(tryBuild, this, batch))
+            return;
     }
     throw UnknownTokenError(
         std::format(L"No known token begins with character {}", reader.get().first), sourceName, tokenStart
@@ -0,0 +1,125 @@
+#include "tokenBatch.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+using enum TokenType;
+
+BatchedToken::BatchedToken(const TokenBatch &batch, TokenType type, Position position):
+    batch(&batch), type(type), position(position), value{.integer = 0}
+{}
+
+std::wstring_view BatchedToken::getText() const
+{
+    return std::wstring_view(batch->texts).substr(value.text.offset, value.text.length);
+}
+
+std::variant<std::monostate, std::wstring, int32_t, double> BatchedToken::getValue() const
+{
+    switch(type)
+    {
+    case IDENTIFIER:
+    case STR_LITERAL:
+    case COMMENT:
+        return std::wstring(getText());
+    case INT_LITERAL:
+        return value.integer;
+    case FLOAT_LITERAL:
+        return value.floating;
+    default:
+        return std::monostate();
+    }
+}
+
+Token BatchedToken::toToken() const
+{
+    switch(type)
+    {
+    case IDENTIFIER:
+    case STR_LITERAL:
+    case COMMENT:
+        return Token(type, position, std::wstring(getText()));
+    case INT_LITERAL:
+        return Token(type, position, value.integer);
+    case FLOAT_LITERAL:
+        return Token(type, position, value.floating);
+    default:
+        return Token(type, position);
+    }
+}
+
+void TokenBatch::append(TokenType type, Position position)
+{
+    tokens.push_back(BatchedToken(*this, type, position));
+}
+
+void TokenBatch::append(TokenType type, Position position, std::wstring_view text)
+{
+    BatchedToken &token = tokens.emplace_back(BatchedToken(*this, type, position));
+    token.value.text = {static_cast<uint32_t>(texts.size()), static_cast<uint32_t>(text.size())};
+    texts.append(text);
+}
+
+void TokenBatch::append(TokenType type, Position position, int32_t value)
+{
+    tokens.push_back(BatchedToken(*this, type, position));
+    tokens.back().value.integer = value;
+}
+
+void TokenBatch::append(TokenType type, Position position, double value)
+{
+    tokens.push_back(BatchedToken(*this, type, position));
+    tokens.back().value.floating = value;
+}
+
+void TokenBatch::append(const Token &token)
+{
+    std::visit(
+        [&](const auto &value) {
+            if constexpr(std::is_same_v<std::decay_t<decltype(value)>, std::monostate>)
+                append(token.getType(), token.getPosition());
+            else
+                append(token.getType(), token.getPosition(), value);
+        },
+        token.getValue()
+    );
+}
+
+void TokenBatch::append(const BatchedToken &token)
+{
+    switch(token.getType())
+    {
+    case IDENTIFIER:
+    case STR_LITERAL:
+    case COMMENT:
+        append(token.getType(), token.getPosition(), token.getText());
+        break;
+    default:
+        tokens.push_back(token);
+        tokens.back().batch = this;
+    }
+}
+
+bool TokenBatch::isComplete() const
+{
+    return tokens.size() >= CAPACITY || (!tokens.empty() && tokens.back().getType() == EOT);
+}
+
+void TokenBatch::removeTokens(TokenType type, size_t begin)
+{
+    auto removed = std::remove_if(tokens.begin() + begin, tokens.end(), [&](const BatchedToken &token) {
+        return token.getType() == type;
+    });
+    tokens.erase(removed, tokens.end());
+}
+
+void TokenBatch::clearTokens()
+{
+    tokens.clear();
+}
+
+void TokenBatch::clear()
+{
+    tokens.clear();
+    texts.clear();
+}
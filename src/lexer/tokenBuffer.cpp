@@ -0,0 +1,20 @@
+#include "tokenBuffer.hpp"
+
+TokenBuffer::TokenBuffer(ILexer &lexer): sourceName(lexer.getSourceName()), next(0)
+{
+    do
+        tokens.push_back(lexer.getNextToken());
+    while(tokens.back().getType() != TokenType::EOT);
+}
+
+std::wstring TokenBuffer::getSourceName()
+{
+    return sourceName;
+}
+
+Token TokenBuffer::getNextToken()
+{
+    if(next + 1 == tokens.size())
+        return tokens.back();
+    return tokens[next++];
+}
@@ -30,6 +30,8 @@ std::wstring toString(TokenType tokenType)
         return L"while";
     case KW_DO:
         return L"do";
+    case KW_SPAWN:
+        return L"spawn";
     case KW_IS:
         return L"is";
     case KW_OR:
@@ -48,6 +50,8 @@ std::wstring toString(TokenType tokenType)
         return L"bool";
     case KW_STR:
         return L"str";
+    case KW_TASK:
+        return L"task";
     case LBRACE:
         return L"{";
     case RBRACE:
@@ -58,8 +58,10 @@ StructExpression::StructExpression(
 ): Expression(position), arguments(std::move(arguments)), structType(structType)
 {}
 
-CastExpression::CastExpression(Position position, std::unique_ptr<Expression> value, Type targetType):
-    Expression(position), value(std::move(value)), targetType(targetType)
+CastExpression::CastExpression(
+    Position position, std::unique_ptr<Expression> value, Type targetType, bool isImplicit
+):
+    Expression(position), value(std::move(value)), targetType(targetType), isImplicit(isImplicit)
 {}
 
 VariableDeclaration::VariableDeclaration(Position position, Type type, std::wstring name, bool isMutable):
@@ -75,6 +77,10 @@ Assignable::Assignable(Position position, std::unique_ptr<Assignable> left, std:
     DocumentTreeNode(position), left(std::move(left)), right(right)
 {}
 
+Assignable::Assignable(Position position, std::unique_ptr<Assignable> left, std::unique_ptr<Expression> index):
+    DocumentTreeNode(position), left(std::move(left)), index(std::move(index))
+{}
+
 Assignable::Assignable(Position position, std::wstring value): DocumentTreeNode(position), left(nullptr), right(value)
 {}
 
@@ -91,6 +97,10 @@ FunctionCallInstruction::FunctionCallInstruction(Position position, FunctionCall
     Instruction(position), functionCall(std::move(functionCall))
 {}
 
+SpawnExpression::SpawnExpression(Position position, FunctionCall functionCall):
+    Expression(position), functionCall(std::move(functionCall))
+{}
+
 ContinueStatement::ContinueStatement(Position position): Instruction(position) {}
 
 BreakStatement::BreakStatement(Position position): Instruction(position) {}
@@ -162,6 +172,33 @@ FunctionDeclaration::FunctionDeclaration(
 ): BaseFunctionDeclaration(position, source, parameters, returnType), body(std::move(body))
 {}
 
+SkippedBody::SkippedBody(
+    Position begin, Position end, std::function<std::vector<std::unique_ptr<Instruction>>()> parse
+): begin(begin), end(end), parse(std::move(parse))
+{}
+
+FunctionDeclaration::FunctionDeclaration(
+    Position position, std::wstring source, std::vector<VariableDeclaration> parameters, std::optional<Type> returnType,
+    SkippedBody body
+): BaseFunctionDeclaration(position, source, parameters, returnType), skippedBody(std::move(body))
+{}
+
+std::vector<std::unique_ptr<Instruction>> &FunctionDeclaration::getBody()
+{
+    if(skippedBody)
+    {
+        body = skippedBody->parse();
+        // releases the tokens of the body
+        skippedBody.reset();
+    }
+    return body;
+}
+
+bool FunctionDeclaration::isBodyParsed() const
+{
+    return !skippedBody;
+}
+
 BuiltinFunctionDeclaration::BuiltinFunctionDeclaration(
     Position position, std::wstring source, std::vector<VariableDeclaration> parameters, std::optional<Type> returnType,
     Body body
@@ -262,6 +299,7 @@ DEFINE_ACCEPT(Assignable);
 DEFINE_ACCEPT(AssignmentStatement);
 DEFINE_ACCEPT(FunctionCall);
 DEFINE_ACCEPT(FunctionCallInstruction);
+DEFINE_ACCEPT(SpawnExpression);
 DEFINE_ACCEPT(ReturnStatement);
 DEFINE_ACCEPT(ContinueStatement);
 DEFINE_ACCEPT(BreakStatement);
@@ -0,0 +1,153 @@
+#include "hashMap.hpp"
+
+#include "object.hpp"
+
+#include <utility>
+
+struct HashMap::Slot
+{
+    bool isOccupied = false;
+    size_t hash = 0;
+    Key key;
+    Object value;
+};
+
+namespace {
+constexpr size_t INITIAL_CAPACITY = 8;
+
+// The standard hashes of integers are identities, so the bits are mixed for the low ones to be used as index.
+size_t hashKey(const HashMap::Key &key)
+{
+    size_t hash = std::hash<HashMap::Key>()(key);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+}
+
+HashMap::HashMap(): count(0) {}
+
+HashMap::HashMap(const HashMap &other): slots(other.slots), count(other.count) {}
+
+HashMap::HashMap(HashMap &&other) noexcept: slots(std::move(other.slots)), count(other.count)
+{
+    other.count = 0;
+}
+
+HashMap &HashMap::operator=(HashMap &&other) noexcept
+{
+    slots = std::move(other.slots);
+    count = other.count;
+    other.count = 0;
+    return *this;
+}
+
+HashMap::~HashMap() = default;
+
+bool HashMap::operator==(const HashMap &other) const
+{
+    if(count != other.count)
+        return false;
+    for(const Slot &slot: slots)
+    {
+        if(!slot.isOccupied)
+            continue;
+        const Object *otherValue = other.find(slot.key);
+        if(!otherValue || *otherValue != slot.value)
+            return false;
+    }
+    return true;
+}
+
+size_t HashMap::getHomeIndex(size_t hash) const
+{
+    return hash & (slots.size() - 1);
+}
+
+size_t HashMap::findSlot(const Key &key, size_t hash) const
+{
+    size_t index = getHomeIndex(hash);
+    while(slots[index].isOccupied && (slots[index].hash != hash || slots[index].key != key))
+        index = (index + 1) & (slots.size() - 1);
+    return index;
+}
+
+Object *HashMap::find(const Key &key)
+{
+    return const_cast<Object *>(std::as_const(*this).find(key));
+}
+
+const Object *HashMap::find(const Key &key) const
+{
+    if(count == 0)
+        return nullptr;
+    const Slot &slot = slots[findSlot(key, hashKey(key))];
+    return slot.isOccupied ? &slot.value : nullptr;
+}
+
+Object &HashMap::findOrInsert(const Key &key)
+{
+    // the load factor is kept at most 3/4, so that the probe sequences stay short
+    if((count + 1) * 4 > slots.size() * 3)
+        grow();
+    size_t hash = hashKey(key);
+    Slot &slot = slots[findSlot(key, hash)];
+    if(!slot.isOccupied)
+    {
+        slot.isOccupied = true;
+        slot.hash = hash;
+        slot.key = key;
+        count += 1;
+    }
+    return slot.value;
+}
+
+bool HashMap::remove(const Key &key)
+{
+    if(count == 0)
+        return false;
+    size_t emptied = findSlot(key, hashKey(key));
+    if(!slots[emptied].isOccupied)
+        return false;
+    slots[emptied] = Slot();
+    count -= 1;
+    size_t mask = slots.size() - 1;
+    for(size_t index = (emptied + 1) & mask; slots[index].isOccupied; index = (index + 1) & mask)
+    {
+        // an entry can fill the emptied slot only if the slot lies between its home slot and its current one
+        size_t home = getHomeIndex(slots[index].hash);
+        if(((index - home) & mask) >= ((index - emptied) & mask))
+        {
+            slots[emptied] = std::move(slots[index]);
+            slots[index] = Slot();
+            emptied = index;
+        }
+    }
+    return true;
+}
+
+void HashMap::forEach(const std::function<void(const Key &, const Object &)> &function) const
+{
+    for(const Slot &slot: slots)
+    {
+        if(slot.isOccupied)
+            function(slot.key, slot.value);
+    }
+}
+
+size_t HashMap::getTableSize() const
+{
+    return slots.capacity() * sizeof(Slot);
+}
+
+void HashMap::grow()
+{
+    std::vector<Slot> oldSlots = std::move(slots);
+    slots = std::vector<Slot>(oldSlots.empty() ? INITIAL_CAPACITY : oldSlots.size() * 2);
+    for(Slot &slot: oldSlots)
+    {
+        if(slot.isOccupied)
+            slots[findSlot(slot.key, slot.hash)] = std::move(slot);
+    }
+}
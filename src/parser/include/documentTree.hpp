@@ -211,9 +211,13 @@ struct DotExpression: public Expression
 
 struct CastExpression: public Expression
 {
-    explicit CastExpression(Position position, std::unique_ptr<Expression> value, Type targetType);
+    explicit CastExpression(
+        Position position, std::unique_ptr<Expression> value, Type targetType, bool isImplicit = false
+    );
     std::unique_ptr<Expression> value;
     Type targetType;
+    // Set for conversions inserted by semantic analysis, which removes them when it analyzes the expression again.
+    bool isImplicit;
     void accept(DocumentTreeVisitor &visitor) override;
 };
 
@@ -225,6 +229,8 @@ struct StructExpression: public Expression
     );
     std::vector<std::unique_ptr<Expression>> arguments;
     std::optional<std::wstring> structType;
+    // set by semantic analysis for expressions initializing arrays and dictionaries
+    std::optional<Type> collectionType;
     void accept(DocumentTreeVisitor &visitor) override;
 };
 
@@ -255,9 +261,12 @@ struct VariableDeclStatement: public Instruction
 struct Assignable: public DocumentTreeNode
 {
     explicit Assignable(Position position, std::unique_ptr<Assignable> left, std::wstring right);
+    explicit Assignable(Position position, std::unique_ptr<Assignable> left, std::unique_ptr<Expression> index);
     explicit Assignable(Position position, std::wstring value);
     std::unique_ptr<Assignable> left;
     std::wstring right;
+    // set for assignments to an element of an array, in which case right is empty
+    std::unique_ptr<Expression> index;
     void accept(DocumentTreeVisitor &visitor) override;
 };
 
@@ -277,6 +286,11 @@ struct FunctionCall: public Expression
     std::wstring functionName;
     std::vector<std::unique_ptr<Expression>> arguments;
     std::vector<unsigned> runtimeResolved;
+    // indices of arguments read from array elements, which are passed by value
+    std::vector<unsigned> copiedArguments;
+    // indices of parts of variables passed as mutable arguments, which are passed as copies assigned back to them after
+    // the call, as the call may destroy or move them through another name of the variable
+    std::vector<unsigned> writtenBackArguments;
     void accept(DocumentTreeVisitor &visitor) override;
 };
 
@@ -287,6 +301,14 @@ struct FunctionCallInstruction: public Instruction
     void accept(DocumentTreeVisitor &visitor) override;
 };
 
+// Function call started in parallel, evaluated to a task joined later to get the call's result.
+struct SpawnExpression: public Expression
+{
+    SpawnExpression(Position position, FunctionCall functionCall);
+    FunctionCall functionCall;
+    void accept(DocumentTreeVisitor &visitor) override;
+};
+
 struct ReturnStatement: public Instruction
 {
     explicit ReturnStatement(Position position, std::unique_ptr<Expression> returnValue);
@@ -327,6 +349,17 @@ struct IfStatement: public Instruction
     void accept(DocumentTreeVisitor &visitor) override;
 };
 
+// Loop of the form while(counter < bound) { ...; counter = counter + step; } (or with <=), in which the mutable int
+// counter is modified only by the last instruction of the body, bound is an int literal or an int variable not modified
+// in the loop and step is a positive int literal. The counter and the bound variable are not function parameters.
+struct CountedLoop
+{
+    std::wstring counter;
+    std::variant<int32_t, std::wstring> bound;
+    bool isInclusive;
+    int32_t step;
+};
+
 struct WhileStatement: public Instruction
 {
     explicit WhileStatement(
@@ -334,6 +367,9 @@ struct WhileStatement: public Instruction
     );
     std::unique_ptr<Expression> condition;
     std::vector<std::unique_ptr<Instruction>> body;
+    // Set by semantic analysis when the loop is a counted loop, whose condition and increment the interpreter can
+    // execute without evaluating them as expressions.
+    std::optional<CountedLoop> countedLoop;
     void accept(DocumentTreeVisitor &visitor) override;
 };
 
@@ -439,20 +475,46 @@ private:
     std::wstring source;
 };
 
+// Function body skipped by the parser, spanning from the opening brace at begin to the closing brace at end. It is
+// parsed with parse when it is first needed.
+struct SkippedBody
+{
+    explicit SkippedBody(
+        Position begin, Position end, std::function<std::vector<std::unique_ptr<Instruction>>()> parse
+    );
+    Position begin, end;
+    std::function<std::vector<std::unique_ptr<Instruction>>()> parse;
+};
+
 struct FunctionDeclaration: public BaseFunctionDeclaration
 {
     explicit FunctionDeclaration(
         Position position, std::wstring source, std::vector<VariableDeclaration> parameters,
         std::optional<Type> returnType, std::vector<std::unique_ptr<Instruction>> body
     );
-    std::vector<std::unique_ptr<Instruction>> body;
+    explicit FunctionDeclaration(
+        Position position, std::wstring source, std::vector<VariableDeclaration> parameters,
+        std::optional<Type> returnType, SkippedBody body
+    );
+    // Parses the body first if it was skipped, so syntax errors in it are thrown from here. The parsing is not
+    // synchronized - semantic analysis parses the bodies of the analyzed functions before they can be executed.
+    std::vector<std::unique_ptr<Instruction>> &getBody();
+    bool isBodyParsed() const;
     void accept(DocumentTreeVisitor &visitor) override;
+private:
+    std::vector<std::unique_ptr<Instruction>> body;
+    std::optional<SkippedBody> skippedBody;
 };
 
+// Per-execution state available to builtin functions, defined by the interpreter.
+struct ExecutionEnvironment;
+
 struct BuiltinFunctionDeclaration: public BaseFunctionDeclaration
 {
-    using Body = std::function<std::optional<
-        Object>(Position, const std::wstring &, std::vector<std::variant<Object, std::reference_wrapper<Object>>> &)>;
+    using Body = std::function<std::optional<Object>(
+        Position, const std::wstring &, std::vector<std::variant<Object, std::reference_wrapper<Object>>> &,
+        ExecutionEnvironment &
+    )>;
     explicit BuiltinFunctionDeclaration(
         Position position, std::wstring source, std::vector<VariableDeclaration> parameters,
         std::optional<Type> returnType, Body body
@@ -36,6 +36,7 @@ struct Assignable;
 struct AssignmentStatement;
 struct FunctionCall;
 struct FunctionCallInstruction;
+struct SpawnExpression;
 struct ReturnStatement;
 struct ContinueStatement;
 struct BreakStatement;
@@ -91,6 +92,7 @@ public:
     virtual void visit(AssignmentStatement &visited) = 0;
     virtual void visit(FunctionCall &visited) = 0;
     virtual void visit(FunctionCallInstruction &visited) = 0;
+    virtual void visit(SpawnExpression &visited) = 0;
     virtual void visit(ReturnStatement &visited) = 0;
     virtual void visit(ContinueStatement &visited) = 0;
     virtual void visit(BreakStatement &visited) = 0;
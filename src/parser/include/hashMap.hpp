@@ -0,0 +1,55 @@
+#ifndef HASHMAP_HPP
+#define HASHMAP_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <variant>
+#include <vector>
+
+struct Object;
+
+// Hash table with open addressing and linear probing, mapping int or str keys to objects. Removed entries are replaced
+// by shifting back the following entries of their probe sequence, so that no tombstones slow down later lookups.
+class HashMap
+{
+public:
+    // str keys are stored as their UTF-8 bytes
+    using Key = std::variant<int32_t, std::string>;
+
+    HashMap();
+    HashMap(const HashMap &other);
+    HashMap(HashMap &&other) noexcept;
+    HashMap &operator=(HashMap &&other) noexcept;
+    ~HashMap();
+    bool operator==(const HashMap &other) const;
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    // Returns nullptr if there is no value with the given key.
+    Object *find(const Key &key);
+    const Object *find(const Key &key) const;
+    // Returns the value with the given key, inserting a default constructed one if there is none. The references to
+    // the values are invalidated by insertions and removals.
+    Object &findOrInsert(const Key &key);
+    // Returns whether the key was present.
+    bool remove(const Key &key);
+    // Visits the entries in an unspecified order.
+    void forEach(const std::function<void(const Key &, const Object &)> &function) const;
+    // Returns the size in bytes of the table of slots, not including the memory held by the keys and values.
+    size_t getTableSize() const;
+private:
+    struct Slot;
+    std::vector<Slot> slots;
+    size_t count;
+
+    size_t getHomeIndex(size_t hash) const;
+    // Returns the index of the slot holding the key or of the empty slot, which ends its probe sequence.
+    size_t findSlot(const Key &key, size_t hash) const;
+    void grow();
+};
+
+#endif
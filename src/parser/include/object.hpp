@@ -1,20 +1,37 @@
+#ifndef OBJECT_HPP
+#define OBJECT_HPP
+
+#include "hashMap.hpp"
 #include "type.hpp"
+#include "utf8String.hpp"
 
 #include <memory>
 #include <variant>
 
+// Defined by the interpreter, which runs the spawned function calls.
+class SpawnedTask;
+
 struct Object
 {
+    // Copies of a task share it.
+    using Value = std::variant<
+        Utf8String, int32_t, double, bool, std::vector<Object>, std::unique_ptr<Object>, HashMap,
+        std::shared_ptr<SpawnedTask>>;
+
     Type type;
-    std::variant<std::wstring, int32_t, double, bool, std::vector<Object>, std::unique_ptr<Object>> value;
+    Value value;
     bool operator==(const Object &other) const;
     bool operator!=(const Object &other) const;
 
     Object() = default;
-    Object(
-        Type type, std::variant<std::wstring, int32_t, double, bool, std::vector<Object>, std::unique_ptr<Object>> value
-    );
+    Object(Type type, Value value);
     explicit Object(const Object &other);
     Object(Object &&other) = default;
     Object &operator=(Object &&other) = default;
 };
+
+// Can be called only on objects of type int or str.
+HashMap::Key toHashMapKey(const Object &key);
+Object fromHashMapKey(const HashMap::Key &key);
+
+#endif
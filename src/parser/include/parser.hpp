@@ -5,18 +5,39 @@
 #include "iLexer.hpp"
 #include "parserExceptions.hpp"
 
+// Declarations and instructions entered at once in the REPL.
+struct ReplEntry
+{
+    Program declarations;
+    std::vector<std::unique_ptr<Instruction>> instructions;
+};
+
 class Parser
 {
 public:
-    explicit Parser(ILexer &source);
+    enum class BodyMode
+    {
+        PARSE,
+        // only the tokens of function bodies are kept, they are parsed when the body is first accessed
+        SKIP,
+    };
+
+    explicit Parser(ILexer &source, BodyMode bodyMode = BodyMode::PARSE);
     Program parseProgram();
+    ReplEntry parseReplEntry();
 private:
     ILexer &source;
     std::wstring sourceName;
-    Token current, next;
+    BodyMode bodyMode;
+    // tokens are read from the source in batches, to avoid a virtual call for every token
+    TokenBatch batch;
+    size_t batchPosition;
+    BatchedToken current, next;
+    BatchedToken readToken();
     void advance();
     void checkAndAdvance(TokenType type);
-    void checkAndAdvance(TokenType type, std::wstring errorMessage);
+    // Reports the expected token description if the current token is not of the given type.
+    void checkAndAdvance(TokenType type, std::wstring_view expected);
     std::wstring loadAndAdvance(TokenType type);
     auto mustBePresent(auto built, std::wstring_view expectedMessage);
     void checkForEOT();
@@ -28,20 +49,23 @@ private:
     std::pair<std::wstring, std::vector<Field>> parseDeclarationBlock();
     std::optional<Field> parseField();
     std::optional<Type> parseTypeIdentifier();
+    std::optional<Type> parseCollectionType();
+    std::optional<Type> parseTaskType();
     std::optional<Type> parseBuiltinType();
     std::vector<VariableDeclaration> parseParameters();
     std::optional<VariableDeclaration> parseVariableDeclaration();
+    SkippedBody skipFunctionBody();
     std::vector<std::unique_ptr<Instruction>> parseInstructionBlock();
     std::unique_ptr<Instruction> parseInstruction();
     std::pair<bool, std::wstring> parseVariableDeclarationBody();
     std::unique_ptr<Instruction> parseDeclOrAssignOrFunCall();
-    std::unique_ptr<VariableDeclStatement> parseVariableDeclStatement(Token firstToken);
+    std::unique_ptr<VariableDeclStatement> parseVariableDeclStatement(BatchedToken firstToken);
     std::unique_ptr<VariableDeclStatement> parseBuiltinDeclStatement();
     std::tuple<bool, std::wstring, std::unique_ptr<Expression>> parseNoTypeDecl();
-    std::unique_ptr<AssignmentStatement> parseAssignmentStatement(Token firstToken);
-    std::optional<FunctionCall> parseFunctionCall(Token functionNameToken);
-    std::unique_ptr<FunctionCall> parseFunctionCallExpression(Token firstToken);
-    std::unique_ptr<FunctionCallInstruction> parseFunctionCallInstruction(Token firstToken);
+    std::unique_ptr<AssignmentStatement> parseAssignmentStatement(BatchedToken firstToken);
+    std::optional<FunctionCall> parseFunctionCall(BatchedToken functionNameToken);
+    std::unique_ptr<FunctionCall> parseFunctionCallExpression(BatchedToken firstToken);
+    std::unique_ptr<FunctionCallInstruction> parseFunctionCallInstruction(BatchedToken firstToken);
     std::vector<std::unique_ptr<Expression>> parseArguments();
     std::unique_ptr<ContinueStatement> parseContinueStatement();
     std::unique_ptr<BreakStatement> parseBreakStatement();
@@ -51,15 +75,7 @@ private:
     std::unique_ptr<WhileStatement> parseWhileStatement();
     std::unique_ptr<DoWhileStatement> parseDoWhileStatement();
     std::unique_ptr<Expression> parseExpression();
-    std::unique_ptr<Expression> parseXorExpression();
-    std::unique_ptr<Expression> parseAndExpression();
-    std::unique_ptr<Expression> parseEqualityExpression();
-    std::unique_ptr<Expression> parseConcatExpression();
-    std::unique_ptr<Expression> parseStringMultiplyExpression();
-    std::unique_ptr<Expression> parseCompareExpression();
-    std::unique_ptr<Expression> parseAdditiveExpression();
-    std::unique_ptr<Expression> parseMultiplicativeExpression();
-    std::unique_ptr<Expression> parseExponentExpression();
+    std::unique_ptr<Expression> parseBinaryExpression(unsigned minPrecedence);
     std::unique_ptr<Expression> parseUnaryExpression();
     std::unique_ptr<Expression> parseIsExpression();
     std::unique_ptr<Expression> parseSubscriptExpression();
@@ -68,6 +84,7 @@ private:
     std::unique_ptr<Expression> parseParenthExpression();
     std::unique_ptr<CastExpression> parseExplicitCast();
     std::unique_ptr<Expression> parseVariableOrFunCall();
+    std::unique_ptr<SpawnExpression> parseSpawnExpression();
     std::unique_ptr<Expression> parseExpressionInParentheses();
     std::unique_ptr<Literal> parseLiteral();
 };
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <format>
+#include <memory>
 #include <variant>
 #include <vector>
 
@@ -16,10 +17,48 @@ struct Type
         BOOL
     };
     typedef std::vector<Type> InitializationList;
-    std::variant<Builtin, std::wstring, InitializationList> value;
+
+    // Contiguous sequence of elements of the same type.
+    struct Array
+    {
+        std::shared_ptr<const Type> elementType;
+        explicit Array(Type elementType);
+        bool operator==(const Array &other) const;
+    };
+
+    // Hash table mapping keys of type int or str to values.
+    struct Dictionary
+    {
+        std::shared_ptr<const Type> keyType;
+        std::shared_ptr<const Type> valueType;
+        explicit Dictionary(Type keyType, Type valueType);
+        bool operator==(const Dictionary &other) const;
+    };
+
+    // Handle of a function call running in parallel, joined to get its result.
+    struct Task
+    {
+        std::shared_ptr<const Type> resultType;
+        explicit Task(Type resultType);
+        bool operator==(const Task &other) const;
+    };
+
+    std::variant<Builtin, std::wstring, InitializationList, Array, Dictionary, Task> value;
     bool operator==(const Type &other) const = default;
     bool isBuiltin() const;
     bool isInitList() const;
+    bool isArray() const;
+    bool isDictionary() const;
+    // Returns whether the type is an array or a dictionary type.
+    bool isCollection() const;
+    bool isTask() const;
+    // Can be called only on array types.
+    const Type &getElementType() const;
+    // Can be called only on dictionary types.
+    const Type &getKeyType() const;
+    const Type &getValueType() const;
+    // Can be called only on task types.
+    const Type &getResultType() const;
 };
 
 std::wostream &operator<<(std::wostream &out, Type type);
@@ -79,6 +118,60 @@ struct std::formatter<Type::InitializationList, wchar_t>: std::formatter<std::ws
     }
 };
 
+template <>
+struct std::formatter<Type::Array, wchar_t>: std::formatter<std::wstring, wchar_t>
+{
+    template <class ParseContext>
+    constexpr auto parse(ParseContext &context)
+    {
+        if(context.begin() != context.end() && *context.begin() != L'}')
+            throw std::format_error("Type::Array does not take any format args.");
+        return context.begin();
+    }
+
+    template <class FormatContext>
+    auto format(const Type::Array &type, FormatContext &context) const
+    {
+        return std::format_to(context.out(), L"[{}]", *type.elementType);
+    }
+};
+
+template <>
+struct std::formatter<Type::Dictionary, wchar_t>: std::formatter<std::wstring, wchar_t>
+{
+    template <class ParseContext>
+    constexpr auto parse(ParseContext &context)
+    {
+        if(context.begin() != context.end() && *context.begin() != L'}')
+            throw std::format_error("Type::Dictionary does not take any format args.");
+        return context.begin();
+    }
+
+    template <class FormatContext>
+    auto format(const Type::Dictionary &type, FormatContext &context) const
+    {
+        return std::format_to(context.out(), L"[{} -> {}]", *type.keyType, *type.valueType);
+    }
+};
+
+template <>
+struct std::formatter<Type::Task, wchar_t>: std::formatter<std::wstring, wchar_t>
+{
+    template <class ParseContext>
+    constexpr auto parse(ParseContext &context)
+    {
+        if(context.begin() != context.end() && *context.begin() != L'}')
+            throw std::format_error("Type::Task does not take any format args.");
+        return context.begin();
+    }
+
+    template <class FormatContext>
+    auto format(const Type::Task &type, FormatContext &context) const
+    {
+        return std::format_to(context.out(), L"task<{}>", *type.resultType);
+    }
+};
+
 template <>
 struct std::formatter<Type, wchar_t>: std::formatter<std::wstring, wchar_t>
 {
@@ -93,7 +186,7 @@ struct std::formatter<Type, wchar_t>: std::formatter<std::wstring, wchar_t>
     template <class FormatContext>
     auto format(const Type &type, FormatContext &context) const
     {
-        std::visit([&](auto value) { std::format_to(context.out(), L"{}", value); }, type.value);
+        std::visit([&](const auto &value) { std::format_to(context.out(), L"{}", value); }, type.value);
         return context.out();
     }
 };
@@ -105,6 +198,12 @@ struct std::hash<Type>
     {
         if(type.isBuiltin())
             return static_cast<std::size_t>(std::get<Type::Builtin>(type.value));
+        else if(type.isArray())
+            return std::hash<Type>()(type.getElementType()) * 31 + 1;
+        else if(type.isDictionary())
+            return (std::hash<Type>()(type.getKeyType()) * 31 + std::hash<Type>()(type.getValueType())) * 31 + 2;
+        else if(type.isTask())
+            return std::hash<Type>()(type.getResultType()) * 31 + 3;
         else
             return std::hash<std::wstring>()(std::get<std::wstring>(type.value));
     }
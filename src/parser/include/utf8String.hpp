@@ -0,0 +1,99 @@
+#ifndef UTF8STRING_HPP
+#define UTF8STRING_HPP
+
+#include <compare>
+#include <cstdint>
+#include <format>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// String value of the interpreted programs, stored as UTF-8. Indexes and lengths are counted in code points. Most of
+// the processed text is ASCII, where code point indexes are byte offsets; for other strings the byte offsets of every
+// INDEX_STRIDE-th code point are cached on first indexed access, so that an index is found by a short scan.
+class Utf8String
+{
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    Utf8String() = default;
+    // Encodes the wide string.
+    Utf8String(const std::wstring &string);
+    Utf8String(const wchar_t *string);
+    explicit Utf8String(std::wstring_view string);
+    // The bytes must be valid UTF-8.
+    static Utf8String fromUtf8(std::string bytes);
+
+    bool operator==(const Utf8String &other) const;
+    // Byte order of UTF-8 strings is the order of their code points.
+    std::strong_ordering operator<=>(const Utf8String &other) const;
+    Utf8String &operator+=(const Utf8String &other);
+    Utf8String operator+(const Utf8String &other) const;
+
+    size_t size() const
+    {
+        return length;
+    }
+
+    bool isAscii() const
+    {
+        return length == bytes.size();
+    }
+
+    const std::string &getBytes() const
+    {
+        return bytes;
+    }
+
+    std::wstring toWstring() const;
+    // Returns the code point at the index as a string. The index must be lower than size().
+    Utf8String at(size_t index) const;
+    // The substring is cut short at the end of the string. start must not be greater than size().
+    Utf8String substr(size_t start, size_t count) const;
+    // Returns the index of the first occurrence of the fragment or npos.
+    size_t find(const Utf8String &fragment) const;
+    bool startsWith(const Utf8String &prefix) const;
+    // Splits the string on every occurrence of the non-empty separator.
+    std::vector<Utf8String> split(const Utf8String &separator) const;
+    // Returns the string without the leading and trailing whitespace.
+    Utf8String trim() const;
+    Utf8String repeat(size_t times) const;
+    // Returns the heap memory held by the string, including the index cache.
+    size_t getHeapSize() const;
+    void writeTo(std::wostream &out) const;
+private:
+    static constexpr size_t INDEX_STRIDE = 64;
+
+    std::string bytes;
+    size_t length = 0;
+    // byte offsets of code points 0, INDEX_STRIDE, 2 * INDEX_STRIDE, ... - built only for non-ASCII strings
+    mutable std::vector<uint32_t> strideOffsets;
+
+    Utf8String(std::string bytes, size_t length);
+    size_t getByteOffset(size_t index) const;
+    Utf8String sliceBytes(size_t begin, size_t end) const;
+};
+
+std::wostream &operator<<(std::wostream &out, const Utf8String &string);
+
+template <>
+struct std::hash<Utf8String>
+{
+    size_t operator()(const Utf8String &string) const
+    {
+        return std::hash<std::string>()(string.getBytes());
+    }
+};
+
+template <>
+struct std::formatter<Utf8String, wchar_t>: std::formatter<std::wstring, wchar_t>
+{
+    template <class FormatContext>
+    auto format(const Utf8String &string, FormatContext &context) const
+    {
+        return std::formatter<std::wstring, wchar_t>::format(string.toWstring(), context);
+    }
+};
+
+#endif
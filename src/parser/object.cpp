@@ -1,8 +1,6 @@
 #include "object.hpp"
 
-Object::Object(
-    Type type, std::variant<std::wstring, int32_t, double, bool, std::vector<Object>, std::unique_ptr<Object>> value
-): type(type), value(std::move(value))
+Object::Object(Type type, Value value): type(type), value(std::move(value))
 {}
 
 bool Object::operator==(const Object &other) const
@@ -25,17 +23,13 @@ bool Object::operator!=(const Object &other) const
 
 namespace {
 template <typename Contained>
-std::variant<std::wstring, int32_t, double, bool, std::vector<Object>, std::unique_ptr<Object>> copyValue(
-    const Contained &value
-)
+Object::Value copyValue(const Contained &value)
 {
     return value;
 }
 
 template <>
-std::variant<std::wstring, int32_t, double, bool, std::vector<Object>, std::unique_ptr<Object>> copyValue(
-    const std::unique_ptr<Object> &value
-)
+Object::Value copyValue(const std::unique_ptr<Object> &value)
 {
     return std::make_unique<Object>(Object(*value.get()));
 }
@@ -44,3 +38,17 @@ std::variant<std::wstring, int32_t, double, bool, std::vector<Object>, std::uniq
 Object::Object(const Object &other):
     type(other.type), value(std::visit([](const auto &value) { return copyValue(value); }, other.value))
 {}
+
+HashMap::Key toHashMapKey(const Object &key)
+{
+    if(auto number = std::get_if<int32_t>(&key.value))
+        return *number;
+    return std::get<Utf8String>(key.value).getBytes();
+}
+
+Object fromHashMapKey(const HashMap::Key &key)
+{
+    if(auto number = std::get_if<int32_t>(&key))
+        return Object{{Type::Builtin::INT}, *number};
+    return Object{{Type::Builtin::STR}, Utf8String::fromUtf8(std::get<std::string>(key))};
+}
@@ -2,31 +2,51 @@
 
 #include "parserExceptions.hpp"
 
+#include <array>
+#include <climits>
 #include <functional>
 #include <map>
+#include <memory>
 #include <unordered_map>
 
 using enum TokenType;
 
-Parser::Parser(ILexer &source):
-    source(source), sourceName(source.getSourceName()), current(source.getNextToken()), next(source.getNextToken())
+Parser::Parser(ILexer &source, BodyMode bodyMode):
+    source(source), sourceName(source.getSourceName()), bodyMode(bodyMode), batchPosition(0), current(readToken()),
+    next(readToken())
 {}
 
+BatchedToken Parser::readToken()
+{
+    if(batchPosition == batch.size())
+    {
+        if(batch.size() > 0 && batch.back().getType() == EOT)
+            return batch.back();
+        // the texts of the tokens are kept, as current, next and tokens held by the parsing methods refer to them
+        batch.clearTokens();
+        source.readTokens(batch);
+        batchPosition = 0;
+    }
+    return batch[batchPosition++];
+}
+
 void Parser::advance()
 {
-    this->current = this->next;
-    this->next = source.getNextToken();
+    current = next;
+    next = readToken();
 }
 
 void Parser::checkAndAdvance(TokenType type)
 {
-    checkAndAdvance(type, std::format(L"Expected '{}', got '{}'", type, current));
+    if(current.getType() != type)
+        throw SyntaxError(std::format(L"Expected '{}', got '{}'", type, current), sourceName, current.getPosition());
+    advance();
 }
 
-void Parser::checkAndAdvance(TokenType type, std::wstring errorMessage)
+void Parser::checkAndAdvance(TokenType type, std::wstring_view expected)
 {
     if(current.getType() != type)
-        throw SyntaxError(errorMessage, sourceName, current.getPosition());
+        throw SyntaxError(std::format(L"Expected {}, got '{}'", expected, current), sourceName, current.getPosition());
     advance();
 }
 
@@ -34,7 +54,7 @@ std::wstring Parser::loadAndAdvance(TokenType type)
 {
     if(current.getType() != type)
         throw SyntaxError(std::format(L"Expected {}, got '{}'", type, current), sourceName, current.getPosition());
-    std::wstring loaded = std::get<std::wstring>(current.getValue());
+    std::wstring loaded(current.getText());
     advance();
     return loaded;
 }
@@ -83,6 +103,32 @@ Program Parser::parseProgram()
     }
 }
 
+// REPL_ENTRY = { TOP_STMT | INSTRUCTION } ;
+ReplEntry Parser::parseReplEntry()
+{
+    ReplEntry entry{Program(current.getPosition()), {}};
+    while(true)
+    {
+        if(auto includeBuilt = parseIncludeStatement())
+            entry.declarations.includes.push_back(*includeBuilt);
+        else if(auto structBuilt = parseStructDeclaration())
+            entry.declarations.add(std::move(*structBuilt));
+        else if(auto variantBuilt = parseVariantDeclaration())
+            entry.declarations.add(std::move(*variantBuilt));
+        else if(auto functionBuilt = parseFunctionDeclaration())
+            entry.declarations.add(std::move(*functionBuilt));
+        else if(auto instruction = parseInstruction())
+            entry.instructions.push_back(std::move(instruction));
+        else if(current.getType() != EOT)
+            throw SyntaxError(
+                std::format(L"Expected a declaration, an instruction or end of text, got '{}'", current), sourceName,
+                current.getPosition()
+            );
+        else
+            return entry;
+    }
+}
+
 // INCLUDE_STMT = 'include', STRING_LITERAL ;
 std::optional<IncludeStatement> Parser::parseIncludeStatement()
 {
@@ -133,7 +179,7 @@ std::pair<std::wstring, std::vector<Field>> Parser::parseDeclarationBlock()
     if(fields.empty())
         throw SyntaxError(L"Expected at least one field in declaration block", sourceName, current.getPosition());
 
-    checkAndAdvance(RBRACE, std::format(L"Expected field or }}, got '{}'", current));
+    checkAndAdvance(RBRACE, L"field or }");
     return {name, fields};
 }
 
@@ -151,14 +197,20 @@ std::optional<Field> Parser::parseField()
 }
 
 // TYPE_IDENT = BUILTIN_TYPE
+//            | COLLECTION_TYPE
+//            | TASK_TYPE
 //            | IDENTIFIER ;
 std::optional<Type> Parser::parseTypeIdentifier()
 {
     if(auto builtinType = parseBuiltinType())
         return *builtinType;
+    if(auto collectionType = parseCollectionType())
+        return *collectionType;
+    if(auto taskType = parseTaskType())
+        return *taskType;
     if(current.getType() != IDENTIFIER)
         return std::nullopt;
-    std::wstring type = std::get<std::wstring>(current.getValue());
+    std::wstring type(current.getText());
     advance();
     return {{type}};
 }
@@ -193,6 +245,36 @@ std::optional<Type> Parser::parseBuiltinType()
     return {{tokenToBuiltinType.at(type)}};
 }
 
+// COLLECTION_TYPE = '[', TYPE_IDENT, [ '->', TYPE_IDENT ], ']' ;
+std::optional<Type> Parser::parseCollectionType()
+{
+    if(current.getType() != LSQUAREBRACE)
+        return std::nullopt;
+    advance();
+    Type elementType = *mustBePresent(parseTypeIdentifier(), L"array element type or dictionary key type");
+    if(current.getType() == ARROW)
+    {
+        advance();
+        Type valueType = *mustBePresent(parseTypeIdentifier(), L"dictionary value type");
+        checkAndAdvance(RSQUAREBRACE);
+        return Type{Type::Dictionary(elementType, valueType)};
+    }
+    checkAndAdvance(RSQUAREBRACE);
+    return Type{Type::Array(elementType)};
+}
+
+// TASK_TYPE = 'task', '<', TYPE_IDENT, '>' ;
+std::optional<Type> Parser::parseTaskType()
+{
+    if(current.getType() != KW_TASK)
+        return std::nullopt;
+    advance();
+    checkAndAdvance(OP_LESSER);
+    Type resultType = *mustBePresent(parseTypeIdentifier(), L"task result type");
+    checkAndAdvance(OP_GREATER);
+    return Type{Type::Task(resultType)};
+}
+
 // FUNCTION_DECL = 'func', IDENTIFIER, '(', [ PARAMETERS ], ')', [ '->', TYPE_IDENT ] , INSTR_BLOCK ;
 std::optional<std::pair<FunctionIdentification, FunctionDeclaration>> Parser::parseFunctionDeclaration()
 {
@@ -204,22 +286,93 @@ std::optional<std::pair<FunctionIdentification, FunctionDeclaration>> Parser::pa
     std::wstring name = loadAndAdvance(IDENTIFIER);
     checkAndAdvance(LPAREN);
     std::vector<VariableDeclaration> parameters = parseParameters();
-    checkAndAdvance(RPAREN, std::format(L"Expected parameter or ')', got '{}'", current));
+    checkAndAdvance(RPAREN, L"parameter or ')'");
     std::optional<Type> returnType;
     if(current.getType() == ARROW)
     {
         advance();
         returnType = mustBePresent(parseTypeIdentifier(), L"type identifier");
     }
-    std::vector<std::unique_ptr<Instruction>> body = parseInstructionBlock();
     std::vector<Type> parameterTypes;
     for(VariableDeclaration parameter: parameters)
         parameterTypes.push_back(parameter.type);
 
-    return std::pair{
-        FunctionIdentification(name, parameterTypes),
-        FunctionDeclaration(begin, sourceName, parameters, returnType, std::move(body))
-    };
+    FunctionIdentification id(name, parameterTypes);
+    if(bodyMode == BodyMode::SKIP)
+        return std::pair{id, FunctionDeclaration(begin, sourceName, parameters, returnType, skipFunctionBody())};
+    return std::pair{id, FunctionDeclaration(begin, sourceName, parameters, returnType, parseInstructionBlock())};
+}
+
+namespace {
+// Returns the tokens of a skipped function body, followed by EOT.
+class SkippedTokens: public ILexer
+{
+public:
+    SkippedTokens(const TokenBatch &tokens, std::wstring sourceName):
+        tokens(tokens), sourceName(std::move(sourceName)), next(0)
+    {}
+
+    std::wstring getSourceName() override
+    {
+        return sourceName;
+    }
+
+    Token getNextToken() override
+    {
+        if(next + 1 == tokens.size())
+            return tokens.back().toToken();
+        return tokens[next++].toToken();
+    }
+
+    void readTokens(TokenBatch &batch) override
+    {
+        while(!batch.isComplete())
+        {
+            batch.append(tokens[next]);
+            if(next + 1 < tokens.size())
+                next++;
+        }
+    }
+private:
+    const TokenBatch &tokens;
+    std::wstring sourceName;
+    size_t next;
+};
+}
+
+// Keeps the tokens of an instruction block up to its matching closing brace. The block is parsed from them as if it was
+// parsed in place, so the syntax errors inside it are reported with the same messages and positions.
+SkippedBody Parser::skipFunctionBody()
+{
+    Position begin = current.getPosition();
+    if(current.getType() != LBRACE)
+        throw SyntaxError(std::format(L"Expected '{}', got '{}'", LBRACE, current), sourceName, begin);
+    auto tokens = std::make_shared<TokenBatch>();
+    unsigned depth = 0;
+    do
+    {
+        if(current.getType() == EOT)
+            throw SyntaxError(
+                std::format(L"Expected instruction or '}}', got '{}'", current), sourceName, current.getPosition()
+            );
+        if(current.getType() == LBRACE)
+            depth++;
+        else if(current.getType() == RBRACE)
+            depth--;
+        tokens->append(current);
+        advance();
+    }
+    while(depth > 0);
+    Position end = tokens->back().getPosition();
+    tokens->append(EOT, current.getPosition());
+
+    return SkippedBody(begin, end, [tokens, source = sourceName]() {
+        SkippedTokens lexer(*tokens, source);
+        Parser parser(lexer);
+        std::vector<std::unique_ptr<Instruction>> body = parser.parseInstructionBlock();
+        parser.checkForEOT();
+        return body;
+    });
 }
 
 // PARAMETERS = VARIABLE_DECL, {',', VARIABLE_DECL};
@@ -272,7 +425,7 @@ std::vector<std::unique_ptr<Instruction>> Parser::parseInstructionBlock()
     std::unique_ptr<Instruction> instruction;
     while((instruction = parseInstruction()))
         instructions.push_back(std::move(instruction));
-    checkAndAdvance(RBRACE, std::format(L"Expected instruction or '}}', got '{}'", current));
+    checkAndAdvance(RBRACE, L"instruction or '}'");
     return instructions;
 }
 
@@ -303,7 +456,7 @@ std::unique_ptr<Instruction> Parser::parseDeclOrAssignOrFunCall()
 {
     if(current.getType() != IDENTIFIER)
         return nullptr;
-    Token firstIdentifier = current;
+    BatchedToken firstIdentifier = current;
     advance();
 
     std::unique_ptr<Instruction> instruction;
@@ -319,13 +472,13 @@ std::unique_ptr<Instruction> Parser::parseDeclOrAssignOrFunCall()
 }
 
 // IDENTIFIER, NO_TYPE_DECL
-std::unique_ptr<VariableDeclStatement> Parser::parseVariableDeclStatement(Token firstToken)
+std::unique_ptr<VariableDeclStatement> Parser::parseVariableDeclStatement(BatchedToken firstToken)
 {
     if(current.getType() != DOLLAR_SIGN && current.getType() != IDENTIFIER)
         return nullptr;
 
     Position begin = firstToken.getPosition();
-    Type type = {std::get<std::wstring>(firstToken.getValue())};
+    Type type = {std::wstring(firstToken.getText())};
     auto [isMutable, name, value] = parseNoTypeDecl();
 
     return std::make_unique<VariableDeclStatement>(
@@ -333,12 +486,12 @@ std::unique_ptr<VariableDeclStatement> Parser::parseVariableDeclStatement(Token
     );
 }
 
-// BUILTIN_DECL =  BUILTIN_TYPE, NO_TYPE_DECL, ';' ;
+// BUILTIN_DECL =  ( BUILTIN_TYPE | COLLECTION_TYPE | TASK_TYPE ), NO_TYPE_DECL, ';' ;
 std::unique_ptr<VariableDeclStatement> Parser::parseBuiltinDeclStatement()
 {
     Position begin = current.getPosition();
     std::optional<Type> type;
-    if(!(type = parseBuiltinType()))
+    if(!(type = parseBuiltinType()) && !(type = parseCollectionType()) && !(type = parseTaskType()))
         return nullptr;
     auto [isMutable, name, value] = parseNoTypeDecl();
     checkAndAdvance(SEMICOLON);
@@ -357,42 +510,50 @@ std::tuple<bool, std::wstring, std::unique_ptr<Expression>> Parser::parseNoTypeD
     return std::tuple{isMutable, name, std::move(value)};
 }
 
-// IDENTIFIER, { '.', IDENTIFIER }, '=', EXPRESSION
-std::unique_ptr<AssignmentStatement> Parser::parseAssignmentStatement(Token firstToken)
+// IDENTIFIER, { '.', IDENTIFIER | '[', EXPRESSION, ']' }, '=', EXPRESSION
+std::unique_ptr<AssignmentStatement> Parser::parseAssignmentStatement(BatchedToken firstToken)
 {
-    if(current.getType() != OP_DOT && current.getType() != OP_ASSIGN)
+    if(current.getType() != OP_DOT && current.getType() != LSQUAREBRACE && current.getType() != OP_ASSIGN)
         return nullptr;
 
     Position begin = firstToken.getPosition();
-    Assignable leftAssignable(begin, std::get<std::wstring>(firstToken.getValue()));
-    while(current.getType() == OP_DOT)
+    Assignable leftAssignable(begin, std::wstring(firstToken.getText()));
+    while(current.getType() == OP_DOT || current.getType() == LSQUAREBRACE)
     {
+        if(current.getType() == OP_DOT)
+        {
+            advance();
+            std::wstring right = loadAndAdvance(IDENTIFIER);
+            leftAssignable = Assignable(begin, std::make_unique<Assignable>(std::move(leftAssignable)), right);
+            continue;
+        }
         advance();
-        std::wstring right = loadAndAdvance(IDENTIFIER);
-        leftAssignable = Assignable(begin, std::make_unique<Assignable>(std::move(leftAssignable)), right);
+        std::unique_ptr<Expression> index = mustBePresent(parseExpression(), L"expression as subscript index");
+        checkAndAdvance(RSQUAREBRACE);
+        leftAssignable = Assignable(begin, std::make_unique<Assignable>(std::move(leftAssignable)), std::move(index));
     }
-    checkAndAdvance(OP_ASSIGN, std::format(L"Expected '.' or '=', got '{}'", current));
+    checkAndAdvance(OP_ASSIGN, L"'.', '[' or '='");
 
     std::unique_ptr<Expression> value = mustBePresent(parseExpression(), L"expression");
     return std::make_unique<AssignmentStatement>(begin, std::move(leftAssignable), std::move(value));
 }
 
 // IDENTIFIER, '(', [ EXPRESSION, { ',', EXPRESSION } ] , ')'
-std::optional<FunctionCall> Parser::parseFunctionCall(Token functionNameToken)
+std::optional<FunctionCall> Parser::parseFunctionCall(BatchedToken functionNameToken)
 {
     if(current.getType() != LPAREN)
         return std::nullopt;
     advance();
 
     Position begin = functionNameToken.getPosition();
-    std::wstring name = std::get<std::wstring>(functionNameToken.getValue());
+    std::wstring name(functionNameToken.getText());
 
     std::vector<std::unique_ptr<Expression>> arguments = parseArguments();
-    checkAndAdvance(RPAREN, std::format(L"Expected argument or ')', got '{}'", current));
+    checkAndAdvance(RPAREN, L"argument or ')'");
     return FunctionCall(begin, name, std::move(arguments));
 }
 
-std::unique_ptr<FunctionCall> Parser::parseFunctionCallExpression(Token firstToken)
+std::unique_ptr<FunctionCall> Parser::parseFunctionCallExpression(BatchedToken firstToken)
 {
     if(auto built = parseFunctionCall(firstToken))
         return std::make_unique<FunctionCall>(std::move(*built));
@@ -400,7 +561,7 @@ std::unique_ptr<FunctionCall> Parser::parseFunctionCallExpression(Token firstTok
         return nullptr;
 }
 
-std::unique_ptr<FunctionCallInstruction> Parser::parseFunctionCallInstruction(Token firstToken)
+std::unique_ptr<FunctionCallInstruction> Parser::parseFunctionCallInstruction(BatchedToken firstToken)
 {
     if(auto built = parseFunctionCall(firstToken))
         return std::make_unique<FunctionCallInstruction>(built->getPosition(), std::move(*built));
@@ -499,7 +660,9 @@ std::variant<VariableDeclStatement, std::unique_ptr<Expression>> Parser::parseIf
 {
     Position begin = current.getPosition();
     std::optional<Type> type;
-    if((next.getType() == IDENTIFIER || next.getType() == DOLLAR_SIGN) && (type = parseTypeIdentifier()))
+    if((current.getType() == LSQUAREBRACE || current.getType() == KW_TASK || next.getType() == IDENTIFIER ||
+        next.getType() == DOLLAR_SIGN) &&
+       (type = parseTypeIdentifier()))
     { // special case of looking at next token for disambiguation,
       // as both EXPRESSION and VARIABLE_DECL may begin with IDENTIFIER or BUILTIN_TYPE
         auto [isMutable, name, value] = parseNoTypeDecl();
@@ -538,234 +701,119 @@ std::unique_ptr<DoWhileStatement> Parser::parseDoWhileStatement()
 }
 
 // EXPRESSION = XOR_EXPR, { 'or', XOR_EXPR } ;
-std::unique_ptr<Expression> Parser::parseExpression()
-{
-    Position begin = current.getPosition();
-    std::unique_ptr<Expression> left = parseXorExpression();
-    if(!left)
-        return nullptr;
-    while(current.getType() == KW_OR)
-    {
-        advance();
-        std::unique_ptr<Expression> right = mustBePresent(parseXorExpression(), L"expression after 'or'");
-        left = std::make_unique<OrExpression>(begin, std::move(left), std::move(right));
-    }
-    return left;
-}
-
 // XOR_EXPR = AND_EXPR, { 'xor', AND_EXPR } ;
-std::unique_ptr<Expression> Parser::parseXorExpression()
-{
-    Position begin = current.getPosition();
-    std::unique_ptr<Expression> left = parseAndExpression();
-    if(!left)
-        return nullptr;
-    while(current.getType() == KW_XOR)
-    {
-        advance();
-        std::unique_ptr<Expression> right = mustBePresent(parseAndExpression(), L"expression after 'xor'");
-        left = std::make_unique<XorExpression>(begin, std::move(left), std::move(right));
-    }
-    return left;
-}
-
 // AND_EXPR = EQUALITY_EXPR, { 'and', EQUALITY_EXPR } ;
-std::unique_ptr<Expression> Parser::parseAndExpression()
-{
-    Position begin = current.getPosition();
-    std::unique_ptr<Expression> left = parseEqualityExpression();
-    if(!left)
-        return nullptr;
-    while(current.getType() == KW_AND)
-    {
-        advance();
-        std::unique_ptr<Expression> right = mustBePresent(parseEqualityExpression(), L"expression after 'and'");
-        left = std::make_unique<AndExpression>(begin, std::move(left), std::move(right));
-    }
-    return left;
-}
-
-#define BINARY_OP_CONSTRUCTOR_PAIR(tokenType, type)                                                             \
-    std::pair                                                                                                   \
-    {                                                                                                           \
-        tokenType, [](Position position, std::unique_ptr<Expression> left, std::unique_ptr<Expression> right) { \
-            return std::make_unique<type>(position, std::move(left), std::move(right));                         \
-        }                                                                                                       \
-    }
-
-typedef std::function<std::unique_ptr<Expression>(Position, std::unique_ptr<Expression>, std::unique_ptr<Expression>)>
-    BinaryExpressionConstructor;
-
-namespace {
-const std::map<TokenType, BinaryExpressionConstructor> tokenTypeToEqualityExpression = {
-    BINARY_OP_CONSTRUCTOR_PAIR(OP_EQUAL, EqualExpression),
-    BINARY_OP_CONSTRUCTOR_PAIR(OP_NOT_EQUAL, NotEqualExpression),
-    BINARY_OP_CONSTRUCTOR_PAIR(OP_IDENTICAL, IdenticalExpression),
-    BINARY_OP_CONSTRUCTOR_PAIR(OP_NOT_IDENTICAL, NotIdenticalExpression),
-};
-}
-
 // EQUALITY_EXPR = CONCAT_EXPR, [ EQUALITY_OP, CONCAT_EXPR ] ;
 // EQUALITY_OP = '=='
 //             | '!='
 //             | '==='
 //             | '!==' ;
-std::unique_ptr<Expression> Parser::parseEqualityExpression()
-{
-    Position begin = current.getPosition();
-    std::unique_ptr<Expression> left = parseConcatExpression();
-    if(!left)
-        return nullptr;
-    if(isIn(current.getType(), tokenTypeToEqualityExpression))
-    {
-        TokenType operation = current.getType();
-        advance();
-        std::unique_ptr<Expression> right = mustBePresent(
-            parseConcatExpression(), L"expression after equality operator"
-        );
-        left = tokenTypeToEqualityExpression.at(operation)(begin, std::move(left), std::move(right));
-    }
-    return left;
-}
-
 // CONCAT_EXPR = STR_MUL_EXPR, { '!', STR_MUL_EXPR } ;
-std::unique_ptr<Expression> Parser::parseConcatExpression()
-{
-    Position begin = current.getPosition();
-    std::unique_ptr<Expression> left = parseStringMultiplyExpression();
-    if(!left)
-        return nullptr;
-    while(current.getType() == OP_CONCAT)
-    {
-        advance();
-        std::unique_ptr<Expression> right = mustBePresent(parseStringMultiplyExpression(), L"expression after '!'");
-        left = std::make_unique<ConcatExpression>(begin, std::move(left), std::move(right));
-    }
-    return left;
-}
-
 // STR_MUL_EXPR = COMPARE_EXPR, { '@', COMPARE_EXPR } ;
-std::unique_ptr<Expression> Parser::parseStringMultiplyExpression()
-{
-    Position begin = current.getPosition();
-    std::unique_ptr<Expression> left = parseCompareExpression();
-    if(!left)
-        return nullptr;
-    while(current.getType() == OP_STR_MULTIPLY)
-    {
-        advance();
-        std::unique_ptr<Expression> right = mustBePresent(parseCompareExpression(), L"expression after '@'");
-        left = std::make_unique<StringMultiplyExpression>(begin, std::move(left), std::move(right));
-    }
-    return left;
-}
-
-namespace {
-const std::map<TokenType, BinaryExpressionConstructor> tokenTypeToCompareExpression = {
-    BINARY_OP_CONSTRUCTOR_PAIR(OP_GREATER, GreaterExpression),
-    BINARY_OP_CONSTRUCTOR_PAIR(OP_LESSER, LesserExpression),
-    BINARY_OP_CONSTRUCTOR_PAIR(OP_GREATER_EQUAL, GreaterEqualExpression),
-    BINARY_OP_CONSTRUCTOR_PAIR(OP_LESSER_EQUAL, LesserEqualExpression),
-};
-}
-
 // COMPARE_EXPR = ADDITIVE_EXPR, [ COMPARISON_OP, ADDITIVE_EXPR ] ;
 // COMPARISON_OP = '>'
 //               | '<'
 //               | '>='
 //               | '<=' ;
-std::unique_ptr<Expression> Parser::parseCompareExpression()
-{
-    Position begin = current.getPosition();
-    std::unique_ptr<Expression> left = parseAdditiveExpression();
-    if(!left)
-        return nullptr;
-    if(isIn(current.getType(), tokenTypeToCompareExpression))
-    {
-        TokenType operation = current.getType();
-        advance();
-        std::unique_ptr<Expression> right = mustBePresent(
-            parseAdditiveExpression(), L"expression after comparison operator"
-        );
-        left = tokenTypeToCompareExpression.at(operation)(begin, std::move(left), std::move(right));
-    }
-    return left;
-}
-
-namespace {
-const std::map<TokenType, BinaryExpressionConstructor> tokenTypeToAdditiveExpression = {
-    BINARY_OP_CONSTRUCTOR_PAIR(OP_PLUS, PlusExpression),
-    BINARY_OP_CONSTRUCTOR_PAIR(OP_MINUS, MinusExpression),
-};
-}
-
 // ADDITIVE_EXPR = TERM, { ADDITIVE_OP, TERM } ;
 // ADDITIVE_OP = '+'
 //             | '-' ;
-std::unique_ptr<Expression> Parser::parseAdditiveExpression()
-{
-    Position begin = current.getPosition();
-    std::unique_ptr<Expression> left = parseMultiplicativeExpression();
-    if(!left)
-        return nullptr;
-    while(isIn(current.getType(), tokenTypeToAdditiveExpression))
-    {
-        TokenType operation = current.getType();
-        advance();
-        std::unique_ptr<Expression> right = mustBePresent(
-            parseMultiplicativeExpression(), L"expression after additive operator"
-        );
-        left = tokenTypeToAdditiveExpression.at(operation)(begin, std::move(left), std::move(right));
-    }
-    return left;
-}
-
-namespace {
-const std::map<TokenType, BinaryExpressionConstructor> tokenTypeToMultiplicativeExpression = {
-    BINARY_OP_CONSTRUCTOR_PAIR(OP_MULTIPLY, MultiplyExpression),
-    BINARY_OP_CONSTRUCTOR_PAIR(OP_DIVIDE, DivideExpression),
-    BINARY_OP_CONSTRUCTOR_PAIR(OP_FLOOR_DIVIDE, FloorDivideExpression),
-    BINARY_OP_CONSTRUCTOR_PAIR(OP_MODULO, ModuloExpression),
-};
-}
-
 // TERM = FACTOR, { MULTIPL_OP, FACTOR } ;
 // MULTIPL_OP =    '*'
 //               | '/'
 //               | '//'
 //               | '%' ;
-std::unique_ptr<Expression> Parser::parseMultiplicativeExpression()
+// FACTOR = UNARY_EXPR, { '**', UNARY_EXPR } ;
+std::unique_ptr<Expression> Parser::parseExpression()
 {
-    Position begin = current.getPosition();
-    std::unique_ptr<Expression> left = parseExponentExpression();
-    if(!left)
-        return nullptr;
-    while(isIn(current.getType(), tokenTypeToMultiplicativeExpression))
-    {
-        TokenType operation = current.getType();
-        advance();
-        std::unique_ptr<Expression> right = mustBePresent(
-            parseExponentExpression(), L"expression after multiplicative operator"
-        );
-        left = tokenTypeToMultiplicativeExpression.at(operation)(begin, std::move(left), std::move(right));
-    }
-    return left;
+    return parseBinaryExpression(1);
 }
 
-// FACTOR = UNARY_EXPR, { '**', UNARY_EXPR } ;
-std::unique_ptr<Expression> Parser::parseExponentExpression()
+namespace {
+typedef std::unique_ptr<Expression> (*BinaryExpressionConstructor)(
+    Position, std::unique_ptr<Expression>, std::unique_ptr<Expression>
+);
+
+template <typename ExpressionType>
+std::unique_ptr<Expression> makeBinaryExpression(
+    Position position, std::unique_ptr<Expression> left, std::unique_ptr<Expression> right
+)
+{
+    return std::make_unique<ExpressionType>(position, std::move(left), std::move(right));
+}
+
+struct BinaryOperator
+{
+    // 0 for tokens which are not binary operators, the operators of the rules above have increasing precedences
+    unsigned precedence = 0;
+    // whether the operator can be repeated, grouping to the left, or may appear at most once in its rule
+    bool repeatable = true;
+    BinaryExpressionConstructor construct = nullptr;
+    const wchar_t *missingOperandMessage = nullptr;
+};
+
+constexpr auto binaryOperators = []() {
+    std::array<BinaryOperator, static_cast<size_t>(EOT) + 1> operators;
+    auto add = [&](TokenType type, unsigned precedence, bool repeatable, BinaryExpressionConstructor construct,
+                   const wchar_t *missingOperandMessage) {
+        operators[static_cast<size_t>(type)] = {precedence, repeatable, construct, missingOperandMessage};
+    };
+    add(KW_OR, 1, true, makeBinaryExpression<OrExpression>, L"expression after 'or'");
+    add(KW_XOR, 2, true, makeBinaryExpression<XorExpression>, L"expression after 'xor'");
+    add(KW_AND, 3, true, makeBinaryExpression<AndExpression>, L"expression after 'and'");
+    const wchar_t *afterEquality = L"expression after equality operator";
+    add(OP_EQUAL, 4, false, makeBinaryExpression<EqualExpression>, afterEquality);
+    add(OP_NOT_EQUAL, 4, false, makeBinaryExpression<NotEqualExpression>, afterEquality);
+    add(OP_IDENTICAL, 4, false, makeBinaryExpression<IdenticalExpression>, afterEquality);
+    add(OP_NOT_IDENTICAL, 4, false, makeBinaryExpression<NotIdenticalExpression>, afterEquality);
+    add(OP_CONCAT, 5, true, makeBinaryExpression<ConcatExpression>, L"expression after '!'");
+    add(OP_STR_MULTIPLY, 6, true, makeBinaryExpression<StringMultiplyExpression>, L"expression after '@'");
+    const wchar_t *afterComparison = L"expression after comparison operator";
+    add(OP_GREATER, 7, false, makeBinaryExpression<GreaterExpression>, afterComparison);
+    add(OP_LESSER, 7, false, makeBinaryExpression<LesserExpression>, afterComparison);
+    add(OP_GREATER_EQUAL, 7, false, makeBinaryExpression<GreaterEqualExpression>, afterComparison);
+    add(OP_LESSER_EQUAL, 7, false, makeBinaryExpression<LesserEqualExpression>, afterComparison);
+    const wchar_t *afterAdditive = L"expression after additive operator";
+    add(OP_PLUS, 8, true, makeBinaryExpression<PlusExpression>, afterAdditive);
+    add(OP_MINUS, 8, true, makeBinaryExpression<MinusExpression>, afterAdditive);
+    const wchar_t *afterMultiplicative = L"expression after multiplicative operator";
+    add(OP_MULTIPLY, 9, true, makeBinaryExpression<MultiplyExpression>, afterMultiplicative);
+    add(OP_DIVIDE, 9, true, makeBinaryExpression<DivideExpression>, afterMultiplicative);
+    add(OP_FLOOR_DIVIDE, 9, true, makeBinaryExpression<FloorDivideExpression>, afterMultiplicative);
+    add(OP_MODULO, 9, true, makeBinaryExpression<ModuloExpression>, afterMultiplicative);
+    add(OP_EXPONENT, 10, true, makeBinaryExpression<ExponentExpression>, L"expression after '**'");
+    return operators;
+}();
+
+const BinaryOperator &getBinaryOperator(TokenType type)
+{
+    return binaryOperators[static_cast<size_t>(type)];
+}
+}
+
+// Parses the rules above by precedence climbing, building the same tree as their recursive descent would. The result
+// contains only the operators with precedence of at least minPrecedence.
+std::unique_ptr<Expression> Parser::parseBinaryExpression(unsigned minPrecedence)
 {
     Position begin = current.getPosition();
     std::unique_ptr<Expression> left = parseUnaryExpression();
     if(!left)
         return nullptr;
-    while(current.getType() == OP_EXPONENT)
+    // after an operator is applied, the following ones must have lower precedence, or the same if it is repeatable,
+    // as the right operand has taken all operators of higher precedence
+    unsigned maxPrecedence = UINT_MAX;
+    while(true)
     {
+        const BinaryOperator &operation = getBinaryOperator(current.getType());
+        if(operation.precedence < minPrecedence || operation.precedence > maxPrecedence)
+            return left;
         advance();
-        std::unique_ptr<Expression> right = mustBePresent(parseUnaryExpression(), L"expression after '**'");
-        left = std::make_unique<ExponentExpression>(begin, std::move(left), std::move(right));
+        std::unique_ptr<Expression> right = mustBePresent(
+            parseBinaryExpression(operation.precedence + 1), operation.missingOperandMessage
+        );
+        left = operation.construct(begin, std::move(left), std::move(right));
+        maxPrecedence = operation.repeatable ? operation.precedence : operation.precedence - 1;
     }
-    return left;
 }
 
 // UNARY_EXPR = { UNARY_OP } , IS_EXPR ;
@@ -836,7 +884,7 @@ std::unique_ptr<Expression> Parser::parseDotExpression()
     return left;
 }
 
-// STRUCT_EXPR = '{', EXPRESSION, { ',', EXPRESSION } , '}'
+// STRUCT_EXPR = '{', [ EXPRESSION, { ',', EXPRESSION } ], '}'
 //             | PARENTH_EXPR ;
 std::unique_ptr<Expression> Parser::parseStructExpression()
 {
@@ -845,15 +893,14 @@ std::unique_ptr<Expression> Parser::parseStructExpression()
         Position begin = current.getPosition();
         advance();
         std::vector<std::unique_ptr<Expression>> arguments = parseArguments();
-        if(arguments.size() < 1)
-            throw SyntaxError(L"Expected at least 1 argument in StructExpression", sourceName, begin);
-        checkAndAdvance(RBRACE, std::format(L"Expected struct expression argument or '}}', got '{}'", current));
+        checkAndAdvance(RBRACE, L"struct expression argument or '}'");
         return std::make_unique<StructExpression>(begin, std::move(arguments));
     }
     return parseParenthExpression();
 }
 
 // PARENTH_EXPR =  IDENTIFIER, [ '(', [ EXPRESSION, { ',', EXPRESSION } ] , ')' ]
+//               | SPAWN_EXPR
 //               | '(', EXPRESSION, ')'
 //               | LITERAL ;
 std::unique_ptr<Expression> Parser::parseParenthExpression()
@@ -861,6 +908,8 @@ std::unique_ptr<Expression> Parser::parseParenthExpression()
     std::unique_ptr<Expression> built;
     if((built = parseVariableOrFunCall()))
         return built;
+    if((built = parseSpawnExpression()))
+        return built;
     if((built = parseExplicitCast()))
         return built;
     if((built = parseExpressionInParentheses()))
@@ -875,9 +924,9 @@ std::unique_ptr<CastExpression> Parser::parseExplicitCast()
     auto type = parseBuiltinType();
     if(!type)
         return nullptr;
-    checkAndAdvance(LPAREN, std::format(L"Expected '(', got '{}'", current));
+    checkAndAdvance(LPAREN, L"'('");
     std::unique_ptr<Expression> argumentBuilt = mustBePresent(parseExpression(), L"expression");
-    checkAndAdvance(RPAREN, std::format(L"Expected argument or ')', got '{}'", current));
+    checkAndAdvance(RPAREN, L"argument or ')'");
 
     return std::make_unique<CastExpression>(begin, std::move(argumentBuilt), *type);
 }
@@ -887,16 +936,31 @@ std::unique_ptr<Expression> Parser::parseVariableOrFunCall()
 {
     if(current.getType() != IDENTIFIER)
         return nullptr;
-    Token firstIdentifier = current;
+    BatchedToken firstIdentifier = current;
     advance();
     std::unique_ptr<FunctionCall> call;
     if((call = parseFunctionCallExpression(firstIdentifier)))
         return call;
     return std::make_unique<Variable>(
-        firstIdentifier.getPosition(), std::get<std::wstring>(firstIdentifier.getValue())
+        firstIdentifier.getPosition(), std::wstring(firstIdentifier.getText())
     );
 }
 
+// SPAWN_EXPR = 'spawn', IDENTIFIER, '(', [ EXPRESSION, { ',', EXPRESSION } ] , ')' ;
+std::unique_ptr<SpawnExpression> Parser::parseSpawnExpression()
+{
+    if(current.getType() != KW_SPAWN)
+        return nullptr;
+    Position begin = current.getPosition();
+    advance();
+    BatchedToken functionName = current;
+    checkAndAdvance(IDENTIFIER);
+    std::optional<FunctionCall> call = parseFunctionCall(functionName);
+    if(!call)
+        throw SyntaxError(std::format(L"Expected '(', got '{}'", current), sourceName, current.getPosition());
+    return std::make_unique<SpawnExpression>(begin, std::move(*call));
+}
+
 // '(', EXPRESSION, ')'
 std::unique_ptr<Expression> Parser::parseExpressionInParentheses()
 {
@@ -922,7 +986,7 @@ std::unique_ptr<Literal> Parser::parseLiteral()
     switch(current.getType())
     {
     case STR_LITERAL:
-        value = std::get<std::wstring>(current.getValue());
+        value = std::wstring(current.getText());
         break;
     case INT_LITERAL:
         value = std::get<int32_t>(current.getValue());
@@ -126,6 +126,8 @@ void PrintingVisitor::visit(StructExpression &visited)
     out << L"StructExpression " << visited.getPosition();
     if(visited.structType)
         out << L" structType=" << *visited.structType;
+    if(visited.collectionType)
+        out << L" collectionType=" << *visited.collectionType;
     out << L"\n";
     visitContainer(visited.arguments);
 }
@@ -161,6 +163,18 @@ void PrintingVisitor::visit(VariableDeclStatement &visited)
 
 void PrintingVisitor::visit(Assignable &visited)
 {
+    if(visited.index)
+    {
+        out << L"Assignable " << visited.getPosition() << L"\n" << indent << L"|-";
+        indent += L"|";
+        visited.left->accept(*this);
+        popIndent();
+        out << indent << L"`-";
+        indent += L" ";
+        visited.index->accept(*this);
+        popIndent();
+        return;
+    }
     out << L"Assignable " << visited.getPosition() << L" right=" << visited.right << L"\n";
     if(visited.left)
     {
@@ -186,12 +200,15 @@ void PrintingVisitor::visit(AssignmentStatement &visited)
 void PrintingVisitor::visit(FunctionCall &visited)
 {
     out << L"FunctionCall " << visited.getPosition() << L" functionName=" << visited.functionName;
-    if(!visited.runtimeResolved.empty())
+    for(auto [name, indices]: {
+            std::pair{L"runtimeResolved", &visited.runtimeResolved}, {L"copiedArguments", &visited.copiedArguments},
+            {L"writtenBackArguments", &visited.writtenBackArguments}
+        })
     {
-        out << L" runtimeResolved={" << visited.runtimeResolved[0];
-        std::for_each(visited.runtimeResolved.begin() + 1, visited.runtimeResolved.end(), [&](unsigned index) {
-            out << L", " << index;
-        });
+        if(indices->empty())
+            continue;
+        out << L" " << name << L"={" << (*indices)[0];
+        std::for_each(indices->begin() + 1, indices->end(), [&](unsigned index) { out << L", " << index; });
         out << L"}";
     }
     out << L"\n";
@@ -207,6 +224,15 @@ void PrintingVisitor::visit(FunctionCallInstruction &visited)
     popIndent();
 }
 
+void PrintingVisitor::visit(SpawnExpression &visited)
+{
+    out << L"SpawnExpression " << visited.getPosition() << L"\n";
+    out << indent << L"`-";
+    indent += L" ";
+    visited.functionCall.accept(*this);
+    popIndent();
+}
+
 void PrintingVisitor::visit(ReturnStatement &visited)
 {
     out << L"ReturnStatement " << visited.getPosition() << L"\n";
@@ -304,7 +330,7 @@ void PrintingVisitor::visit(FunctionDeclaration &visited)
     if(!visited.parameters.empty())
     {
         out << indent;
-        if(!visited.body.empty())
+        if(!visited.getBody().empty())
         {
             out << L"|-";
             indent += L"|";
@@ -318,11 +344,11 @@ void PrintingVisitor::visit(FunctionDeclaration &visited)
         visitContainer(visited.parameters);
         popIndent();
     }
-    if(!visited.body.empty())
+    if(!visited.getBody().empty())
     {
         out << indent << L"`-Body:\n";
         indent += L" ";
-        visitContainer(visited.body);
+        visitContainer(visited.getBody());
         popIndent();
     }
 }
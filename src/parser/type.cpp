@@ -3,6 +3,30 @@
 #include <iterator>
 #include <ostream>
 
+Type::Array::Array(Type elementType): elementType(std::make_shared<const Type>(std::move(elementType))) {}
+
+bool Type::Array::operator==(const Array &other) const
+{
+    return *elementType == *other.elementType;
+}
+
+Type::Dictionary::Dictionary(Type keyType, Type valueType):
+    keyType(std::make_shared<const Type>(std::move(keyType))),
+    valueType(std::make_shared<const Type>(std::move(valueType)))
+{}
+
+bool Type::Dictionary::operator==(const Dictionary &other) const
+{
+    return *keyType == *other.keyType && *valueType == *other.valueType;
+}
+
+Type::Task::Task(Type resultType): resultType(std::make_shared<const Type>(std::move(resultType))) {}
+
+bool Type::Task::operator==(const Task &other) const
+{
+    return *resultType == *other.resultType;
+}
+
 bool Type::isBuiltin() const
 {
     return std::holds_alternative<Type::Builtin>(value);
@@ -13,6 +37,46 @@ bool Type::isInitList() const
     return std::holds_alternative<Type::InitializationList>(value);
 }
 
+bool Type::isArray() const
+{
+    return std::holds_alternative<Type::Array>(value);
+}
+
+bool Type::isDictionary() const
+{
+    return std::holds_alternative<Type::Dictionary>(value);
+}
+
+bool Type::isCollection() const
+{
+    return isArray() || isDictionary();
+}
+
+bool Type::isTask() const
+{
+    return std::holds_alternative<Type::Task>(value);
+}
+
+const Type &Type::getElementType() const
+{
+    return *std::get<Type::Array>(value).elementType;
+}
+
+const Type &Type::getKeyType() const
+{
+    return *std::get<Type::Dictionary>(value).keyType;
+}
+
+const Type &Type::getValueType() const
+{
+    return *std::get<Type::Dictionary>(value).valueType;
+}
+
+const Type &Type::getResultType() const
+{
+    return *std::get<Type::Task>(value).resultType;
+}
+
 std::wostream &operator<<(std::wostream &out, Type type)
 {
     std::ostream_iterator<wchar_t, wchar_t> outIterator(out);
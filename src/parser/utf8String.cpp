@@ -0,0 +1,278 @@
+#include "utf8String.hpp"
+
+#include "stringKernels.hpp"
+
+#include <algorithm>
+#include <cwctype>
+#include <utility>
+
+namespace {
+constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+bool isContinuationByte(char byte)
+{
+    return (static_cast<unsigned char>(byte) & 0xC0) == 0x80;
+}
+
+size_t countCodePoints(std::string_view bytes)
+{
+    return StringKernels::get().countCodePoints(bytes.data(), bytes.size());
+}
+
+void appendEncoded(std::string &bytes, char32_t codePoint)
+{
+    if((codePoint >= 0xD800 && codePoint < 0xE000) || codePoint > 0x10FFFF)
+        codePoint = REPLACEMENT_CHARACTER;
+    if(codePoint < 0x80)
+        bytes += static_cast<char>(codePoint);
+    else if(codePoint < 0x800)
+    {
+        bytes += static_cast<char>(0xC0 | (codePoint >> 6));
+        bytes += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else if(codePoint < 0x10000)
+    {
+        bytes += static_cast<char>(0xE0 | (codePoint >> 12));
+        bytes += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        bytes += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else
+    {
+        bytes += static_cast<char>(0xF0 | (codePoint >> 18));
+        bytes += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        bytes += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        bytes += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+// Decodes the code point starting at offset and moves offset past it.
+char32_t decodeAt(std::string_view bytes, size_t &offset)
+{
+    unsigned char first = static_cast<unsigned char>(bytes[offset++]);
+    if(first < 0x80)
+        return first;
+    unsigned continuationBytes = first >= 0xF0 ? 3 : (first >= 0xE0 ? 2 : 1);
+    char32_t codePoint = first & (0x3F >> continuationBytes);
+    for(unsigned i = 0; i < continuationBytes; i++)
+        codePoint = (codePoint << 6) | (static_cast<unsigned char>(bytes[offset++]) & 0x3F);
+    return codePoint;
+}
+
+// Returns the offset of the code point ending just before offset.
+size_t findPreviousCodePoint(std::string_view bytes, size_t offset)
+{
+    do
+        offset -= 1;
+    while(isContinuationByte(bytes[offset]));
+    return offset;
+}
+}
+
+Utf8String::Utf8String(std::string bytes, size_t length): bytes(std::move(bytes)), length(length) {}
+
+Utf8String::Utf8String(std::wstring_view string)
+{
+    bytes.reserve(string.size());
+    for(wchar_t character: string)
+        appendEncoded(bytes, static_cast<char32_t>(character));
+    length = string.size();
+}
+
+Utf8String::Utf8String(const std::wstring &string): Utf8String(std::wstring_view(string)) {}
+
+Utf8String::Utf8String(const wchar_t *string): Utf8String(std::wstring_view(string)) {}
+
+Utf8String Utf8String::fromUtf8(std::string bytes)
+{
+    size_t length = countCodePoints(bytes);
+    return Utf8String(std::move(bytes), length);
+}
+
+bool Utf8String::operator==(const Utf8String &other) const
+{
+    if(bytes.size() != other.bytes.size())
+        return false;
+    return StringKernels::get().findMismatch(bytes.data(), other.bytes.data(), bytes.size()) == bytes.size();
+}
+
+std::strong_ordering Utf8String::operator<=>(const Utf8String &other) const
+{
+    size_t commonSize = std::min(bytes.size(), other.bytes.size());
+    size_t mismatch = StringKernels::get().findMismatch(bytes.data(), other.bytes.data(), commonSize);
+    if(mismatch == commonSize)
+        return bytes.size() <=> other.bytes.size();
+    return static_cast<unsigned char>(bytes[mismatch]) <=> static_cast<unsigned char>(other.bytes[mismatch]);
+}
+
+Utf8String &Utf8String::operator+=(const Utf8String &other)
+{
+    bytes += other.bytes;
+    length += other.length;
+    strideOffsets.clear();
+    return *this;
+}
+
+Utf8String Utf8String::operator+(const Utf8String &other) const
+{
+    std::string result;
+    result.reserve(bytes.size() + other.bytes.size());
+    result += bytes;
+    result += other.bytes;
+    return Utf8String(std::move(result), length + other.length);
+}
+
+std::wstring Utf8String::toWstring() const
+{
+    if(isAscii())
+        return std::wstring(bytes.begin(), bytes.end());
+    std::wstring result;
+    result.reserve(length);
+    for(size_t offset = 0; offset < bytes.size();)
+        result += static_cast<wchar_t>(decodeAt(bytes, offset));
+    return result;
+}
+
+size_t Utf8String::getByteOffset(size_t index) const
+{
+    if(isAscii())
+        return index;
+    if(index >= length)
+        return bytes.size();
+    if(strideOffsets.empty())
+    {
+        strideOffsets.reserve(length / INDEX_STRIDE + 1);
+        size_t codePoint = 0;
+        for(size_t offset = 0; offset < bytes.size(); offset++)
+        {
+            if(isContinuationByte(bytes[offset]))
+                continue;
+            if(codePoint % INDEX_STRIDE == 0)
+                strideOffsets.push_back(static_cast<uint32_t>(offset));
+            codePoint += 1;
+        }
+    }
+    size_t offset = strideOffsets[index / INDEX_STRIDE];
+    for(size_t skipped = 0; skipped < index % INDEX_STRIDE; skipped++)
+    {
+        do
+            offset += 1;
+        while(isContinuationByte(bytes[offset]));
+    }
+    return offset;
+}
+
+Utf8String Utf8String::sliceBytes(size_t begin, size_t end) const
+{
+    std::string_view slice = std::string_view(bytes).substr(begin, end - begin);
+    return Utf8String(std::string(slice), isAscii() ? slice.size() : countCodePoints(slice));
+}
+
+Utf8String Utf8String::at(size_t index) const
+{
+    size_t begin = getByteOffset(index);
+    size_t end = begin + 1;
+    while(end < bytes.size() && isContinuationByte(bytes[end]))
+        end += 1;
+    return Utf8String(bytes.substr(begin, end - begin), 1);
+}
+
+Utf8String Utf8String::substr(size_t start, size_t count) const
+{
+    count = std::min(count, length - start);
+    size_t begin = getByteOffset(start);
+    size_t end = getByteOffset(start + count);
+    return Utf8String(bytes.substr(begin, end - begin), count);
+}
+
+size_t Utf8String::find(const Utf8String &fragment) const
+{
+    // a valid UTF-8 fragment can match only at code point boundaries
+    size_t found = bytes.find(fragment.bytes);
+    if(found == std::string::npos)
+        return npos;
+    return isAscii() ? found : countCodePoints(std::string_view(bytes).substr(0, found));
+}
+
+bool Utf8String::startsWith(const Utf8String &prefix) const
+{
+    return bytes.starts_with(prefix.bytes);
+}
+
+std::vector<Utf8String> Utf8String::split(const Utf8String &separator) const
+{
+    std::vector<Utf8String> parts;
+    size_t partStart = 0;
+    while(true)
+    {
+        size_t partEnd = bytes.find(separator.bytes, partStart);
+        if(partEnd == std::string::npos)
+            break;
+        parts.push_back(sliceBytes(partStart, partEnd));
+        partStart = partEnd + separator.bytes.size();
+    }
+    parts.push_back(sliceBytes(partStart, bytes.size()));
+    return parts;
+}
+
+Utf8String Utf8String::trim() const
+{
+    auto isSpace = [](char32_t codePoint) {
+        return std::iswspace(static_cast<wint_t>(codePoint));
+    };
+    size_t begin = 0;
+    while(begin < bytes.size())
+    {
+        size_t next = begin;
+        if(!isSpace(decodeAt(bytes, next)))
+            break;
+        begin = next;
+    }
+    size_t end = bytes.size();
+    while(end > begin)
+    {
+        size_t previous = findPreviousCodePoint(bytes, end);
+        size_t decoded = previous;
+        if(!isSpace(decodeAt(bytes, decoded)))
+            break;
+        end = previous;
+    }
+    return sliceBytes(begin, end);
+}
+
+Utf8String Utf8String::repeat(size_t times) const
+{
+    std::string result(bytes.size() * times, '\0');
+    fillRepeated(result.data(), bytes, times);
+    return Utf8String(std::move(result), length * times);
+}
+
+size_t Utf8String::getHeapSize() const
+{
+    // short strings are stored inside the string object
+    static const size_t inlineCapacity = std::string().capacity();
+    size_t size = bytes.capacity() > inlineCapacity ? bytes.capacity() + 1 : 0;
+    return size + strideOffsets.capacity() * sizeof(uint32_t);
+}
+
+void Utf8String::writeTo(std::wostream &out) const
+{
+    // the code points are decoded into a buffer, so that the stream is written in blocks
+    wchar_t buffer[256];
+    size_t buffered = 0;
+    for(size_t offset = 0; offset < bytes.size();)
+    {
+        if(buffered == std::size(buffer))
+        {
+            out.write(buffer, static_cast<std::streamsize>(buffered));
+            buffered = 0;
+        }
+        buffer[buffered++] = static_cast<wchar_t>(decodeAt(bytes, offset));
+    }
+    out.write(buffer, static_cast<std::streamsize>(buffered));
+}
+
+std::wostream &operator<<(std::wostream &out, const Utf8String &string)
+{
+    string.writeTo(out);
+    return out;
+}
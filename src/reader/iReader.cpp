@@ -0,0 +1,12 @@
+#include "iReader.hpp"
+
+size_t IReader::skipLine()
+{
+    size_t skipped = 0;
+    while(get().first != L'\n' && get().first != EOT)
+    {
+        next();
+        skipped += 1;
+    }
+    return skipped;
+}
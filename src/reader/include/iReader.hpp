@@ -3,6 +3,7 @@
 
 #include "position.hpp"
 
+#include <cstddef>
 #include <utility>
 
 class IReader
@@ -20,6 +21,10 @@ public:
     // Returns EOT when end of input is reached.
     virtual std::pair<wchar_t, Position> get() = 0;
 
+    // Advances to the newline character ending the current line or to EOT.
+    // Returns the number of characters passed.
+    virtual size_t skipLine();
+
     virtual ~IReader() = default;
 };
 
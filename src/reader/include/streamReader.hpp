@@ -4,7 +4,10 @@
 #include "iReader.hpp"
 
 #include <istream>
+#include <vector>
 
+// Reads the source in blocks. Each block is scanned for characters outside of printable ASCII with the vectorized
+// string kernels, so that only these characters are checked one by one for being control characters.
 class StreamReader final: public IReader
 {
 public:
@@ -12,11 +15,26 @@ public:
     std::wstring getSourceName() override;
     std::pair<wchar_t, Position> next() override;
     std::pair<wchar_t, Position> get() override;
+    // Passes the printable ASCII characters in bulk.
+    size_t skipLine() override;
 private:
+    static constexpr size_t BLOCK_SIZE = 4096;
+
     std::wistream &source;
     std::wstring sourceName;
+    std::vector<wchar_t> buffer;
+    size_t bufferEnd;
+    size_t bufferPosition;
+    // index of the next buffered character which is not printable ASCII
+    size_t nextUnusualCharacter;
     wchar_t current;
     Position currentPosition;
+
+    void checkStream();
+    bool fillBuffer();
+    // Returns the next character of the source after checking it or EOT at the end of the source.
+    wchar_t readCharacter();
+    bool peekCharacter(wchar_t expected);
 };
 
 #endif
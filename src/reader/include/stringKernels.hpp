@@ -0,0 +1,37 @@
+#ifndef STRINGKERNELS_HPP
+#define STRINGKERNELS_HPP
+
+#include <string_view>
+#include <vector>
+
+// Bulk string routines, vectorized with SSE2 or AVX2 on x86 processors. The widest instruction set supported by the
+// processor is selected at runtime, so the binaries do not require AVX2.
+struct StringKernels
+{
+    enum class Level
+    {
+        SCALAR,
+        SSE2,
+        AVX2,
+    };
+
+    Level level;
+    // Returns the index of the first character outside of printable ASCII (0x20-0x7E) or size if there is none.
+    size_t (*findNonPrintableAscii)(const wchar_t *characters, size_t size);
+    // Returns the number of code points in valid UTF-8, that is the number of bytes which are not continuation bytes.
+    size_t (*countCodePoints)(const char *bytes, size_t size);
+    // Returns the index of the first byte differing between the buffers or size if they are equal.
+    size_t (*findMismatch)(const char *first, const char *second, size_t size);
+
+    // Returns the kernels of the widest level supported by the processor.
+    static const StringKernels &get();
+    // The level must be supported by the processor.
+    static const StringKernels &get(Level level);
+    static std::vector<Level> getSupportedLevels();
+};
+
+// Writes the pattern the given number of times to the destination, copying the already written part at each step, so
+// that the number of copies is logarithmic.
+void fillRepeated(char *destination, std::string_view pattern, size_t times);
+
+#endif
@@ -1,11 +1,14 @@
 #include "streamReader.hpp"
 
 #include "readerExceptions.hpp"
+#include "stringKernels.hpp"
 
+#include <algorithm>
 #include <format>
 
 StreamReader::StreamReader(std::wistream &source, std::wstring sourceName):
-    source(source), sourceName(sourceName), current(0), currentPosition(Position(1, 0))
+    source(source), sourceName(sourceName), buffer(BLOCK_SIZE), bufferEnd(0), bufferPosition(0),
+    nextUnusualCharacter(0), current(0), currentPosition(Position(1, 0))
 {
     next(); // set to the first character of input
 }
@@ -15,6 +18,50 @@ std::wstring StreamReader::getSourceName()
     return sourceName;
 }
 
+void StreamReader::checkStream()
+{
+    if(source.bad() || (source.fail() && !source.eof()))
+        throw ReaderInputError(L"Input stream returned error", sourceName, currentPosition);
+}
+
+bool StreamReader::fillBuffer()
+{
+    source.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    bufferEnd = static_cast<size_t>(source.gcount());
+    bufferPosition = 0;
+    checkStream();
+    nextUnusualCharacter = StringKernels::get().findNonPrintableAscii(buffer.data(), bufferEnd);
+    return bufferEnd > 0;
+}
+
+wchar_t StreamReader::readCharacter()
+{
+    checkStream();
+    if(bufferPosition == bufferEnd && !fillBuffer())
+        return EOT;
+    wchar_t character = buffer[bufferPosition];
+    if(bufferPosition == nextUnusualCharacter)
+    {
+        if(!std::iswspace(character) && std::iswcntrl(character))
+            throw ControlCharError(
+                std::format(L"Control character encountered in input: \\x{:x}", character), sourceName,
+                currentPosition
+            );
+        size_t scanStart = bufferPosition + 1;
+        nextUnusualCharacter =
+            scanStart + StringKernels::get().findNonPrintableAscii(buffer.data() + scanStart, bufferEnd - scanStart);
+    }
+    bufferPosition += 1;
+    return character;
+}
+
+bool StreamReader::peekCharacter(wchar_t expected)
+{
+    if(bufferPosition == bufferEnd && !fillBuffer())
+        return false;
+    return buffer[bufferPosition] == expected;
+}
+
 std::pair<wchar_t, Position> StreamReader::next()
 {
     if(current == EOT)
@@ -28,28 +75,33 @@ std::pair<wchar_t, Position> StreamReader::next()
     else
         currentPosition.column += 1;
 
-    current = source.get();
-    if(!std::iswspace(current) && std::iswcntrl(current))
-        throw ControlCharError(
-            std::format(L"Control character encountered in input: \\x{:x}", current), sourceName, currentPosition
-        );
-    if(source.eof())
-    {
-        current = EOT;
-        return get();
-    }
-    else if(source.bad() || source.fail())
-        throw ReaderInputError(L"Input stream returned error", sourceName, currentPosition);
-
+    current = readCharacter();
     if(current == L'\r')
     {
-        if(source.peek() == L'\n')
-            source.get();
+        if(peekCharacter(L'\n'))
+            readCharacter();
         current = L'\n';
     }
     return get();
 }
 
+size_t StreamReader::skipLine()
+{
+    size_t skipped = 0;
+    while(current != L'\n' && current != EOT)
+    {
+        // the buffered characters before the next unusual one are printable ASCII, so none of them ends the line
+        size_t printable = std::min(nextUnusualCharacter, bufferEnd) - bufferPosition;
+        bufferPosition += printable;
+        currentPosition.column += static_cast<unsigned>(printable);
+        if(printable > 0)
+            current = buffer[bufferPosition - 1];
+        next();
+        skipped += printable + 1;
+    }
+    return skipped;
+}
+
 std::pair<wchar_t, Position> StreamReader::get()
 {
     return {current, currentPosition};
@@ -0,0 +1,232 @@
+#include "stringKernels.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define STRING_KERNELS_X86
+#endif
+
+namespace {
+bool isPrintableAscii(wchar_t character)
+{
+    return character >= 0x20 && character < 0x7F;
+}
+
+size_t findNonPrintableAsciiScalar(const wchar_t *characters, size_t size)
+{
+    for(size_t i = 0; i < size; i++)
+    {
+        if(!isPrintableAscii(characters[i]))
+            return i;
+    }
+    return size;
+}
+
+// continuation bytes are 0x80-0xBF, which as signed chars are -128 to -65
+bool isCodePointStart(char byte)
+{
+    return static_cast<signed char>(byte) > -65;
+}
+
+size_t countCodePointsScalar(const char *bytes, size_t size)
+{
+    size_t count = 0;
+    for(size_t i = 0; i < size; i++)
+        count += isCodePointStart(bytes[i]);
+    return count;
+}
+
+size_t findMismatchScalar(const char *first, const char *second, size_t size)
+{
+    for(size_t i = 0; i < size; i++)
+    {
+        if(first[i] != second[i])
+            return i;
+    }
+    return size;
+}
+
+#ifdef STRING_KERNELS_X86
+// the vectorized character scans compare wchar_t as 32-bit integers
+constexpr bool WIDE_CHARACTERS_ARE_32_BIT = sizeof(wchar_t) == sizeof(int32_t);
+
+size_t findNonPrintableAsciiSse2(const wchar_t *characters, size_t size)
+{
+    size_t i = 0;
+    if constexpr(WIDE_CHARACTERS_ARE_32_BIT)
+    {
+        // characters above 0x7FFFFFFF are negative as signed integers, so they fail the lower bound
+        const __m128i belowPrintable = _mm_set1_epi32(0x1F);
+        const __m128i abovePrintable = _mm_set1_epi32(0x7F);
+        for(; i + 4 <= size; i += 4)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(characters + i));
+            __m128i printable =
+                _mm_and_si128(_mm_cmpgt_epi32(block, belowPrintable), _mm_cmplt_epi32(block, abovePrintable));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(printable)));
+            if(mask != 0xF)
+                return i + std::countr_one(mask);
+        }
+    }
+    return i + findNonPrintableAsciiScalar(characters + i, size - i);
+}
+
+size_t countCodePointsSse2(const char *bytes, size_t size)
+{
+    const __m128i lastContinuationByte = _mm_set1_epi8(-65);
+    size_t count = 0;
+    size_t i = 0;
+    for(; i + 16 <= size; i += 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(block, lastContinuationByte)));
+        count += std::popcount(mask);
+    }
+    return count + countCodePointsScalar(bytes + i, size - i);
+}
+
+size_t findMismatchSse2(const char *first, const char *second, size_t size)
+{
+    size_t i = 0;
+    for(; i + 16 <= size; i += 16)
+    {
+        __m128i firstBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first + i));
+        __m128i secondBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(second + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(firstBlock, secondBlock)));
+        if(mask != 0xFFFF)
+            return i + std::countr_one(mask);
+    }
+    return i + findMismatchScalar(first + i, second + i, size - i);
+}
+
+__attribute__((target("avx2"))) size_t findNonPrintableAsciiAvx2(const wchar_t *characters, size_t size)
+{
+    size_t i = 0;
+    if constexpr(WIDE_CHARACTERS_ARE_32_BIT)
+    {
+        const __m256i belowPrintable = _mm256_set1_epi32(0x1F);
+        const __m256i abovePrintable = _mm256_set1_epi32(0x7F);
+        for(; i + 8 <= size; i += 8)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(characters + i));
+            __m256i printable = _mm256_and_si256(
+                _mm256_cmpgt_epi32(block, belowPrintable), _mm256_cmpgt_epi32(abovePrintable, block)
+            );
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(printable)));
+            if(mask != 0xFF)
+                return i + std::countr_one(mask);
+        }
+    }
+    return i + findNonPrintableAsciiSse2(characters + i, size - i);
+}
+
+__attribute__((target("avx2"))) size_t countCodePointsAvx2(const char *bytes, size_t size)
+{
+    const __m256i lastContinuationByte = _mm256_set1_epi8(-65);
+    size_t count = 0;
+    size_t i = 0;
+    for(; i + 32 <= size; i += 32)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bytes + i));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(block, lastContinuationByte)));
+        count += std::popcount(mask);
+    }
+    return count + countCodePointsSse2(bytes + i, size - i);
+}
+
+__attribute__((target("avx2"))) size_t findMismatchAvx2(const char *first, const char *second, size_t size)
+{
+    size_t i = 0;
+    for(; i + 32 <= size; i += 32)
+    {
+        __m256i firstBlock = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + i));
+        __m256i secondBlock = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(second + i));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(firstBlock, secondBlock)));
+        if(mask != 0xFFFFFFFF)
+            return i + std::countr_one(mask);
+    }
+    return i + findMismatchSse2(first + i, second + i, size - i);
+}
+#endif
+
+const StringKernels scalarKernels = {
+    StringKernels::Level::SCALAR, findNonPrintableAsciiScalar, countCodePointsScalar, findMismatchScalar
+};
+
+#ifdef STRING_KERNELS_X86
+const StringKernels sse2Kernels = {
+    StringKernels::Level::SSE2, findNonPrintableAsciiSse2, countCodePointsSse2, findMismatchSse2
+};
+
+const StringKernels avx2Kernels = {
+    StringKernels::Level::AVX2, findNonPrintableAsciiAvx2, countCodePointsAvx2, findMismatchAvx2
+};
+#endif
+
+bool isSupported(StringKernels::Level level)
+{
+    switch(level)
+    {
+    case StringKernels::Level::SCALAR:
+        return true;
+#ifdef STRING_KERNELS_X86
+    case StringKernels::Level::SSE2:
+        return true;
+    case StringKernels::Level::AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+}
+
+const StringKernels &StringKernels::get()
+{
+    static const StringKernels &best = get(getSupportedLevels().back());
+    return best;
+}
+
+const StringKernels &StringKernels::get(Level level)
+{
+    switch(level)
+    {
+#ifdef STRING_KERNELS_X86
+    case Level::SSE2:
+        return sse2Kernels;
+    case Level::AVX2:
+        return avx2Kernels;
+#endif
+    default:
+        return scalarKernels;
+    }
+}
+
+std::vector<StringKernels::Level> StringKernels::getSupportedLevels()
+{
+    std::vector<Level> levels;
+    for(Level level: {Level::SCALAR, Level::SSE2, Level::AVX2})
+    {
+        if(isSupported(level))
+            levels.push_back(level);
+    }
+    return levels;
+}
+
+void fillRepeated(char *destination, std::string_view pattern, size_t times)
+{
+    size_t total = pattern.size() * times;
+    if(total == 0)
+        return;
+    std::memcpy(destination, pattern.data(), pattern.size());
+    size_t written = pattern.size();
+    while(written < total)
+    {
+        size_t copied = std::min(written, total - written);
+        std::memcpy(destination + written, destination, copied);
+        written += copied;
+    }
+}
@@ -33,3 +33,176 @@ TEST_CASE("duplicate file name given", "[parseArguments]")
     const char *argv[] = {"execname", "file1.txt", "--dump-dt", "file1.txt", "--args", "file1.txt", "file2.txt"};
     REQUIRE_THROWS_AS(parseArguments(sizeof(argv) / sizeof(const char *), argv), DuplicateFileError);
 }
+
+TEST_CASE("with --profile", "[parseArguments]")
+{
+    const char *argv[] = {"execname", "file1.txt", "--profile", "--args", "arg1"};
+    Arguments arguments = parseArguments(sizeof(argv) / sizeof(const char *), argv);
+    REQUIRE(arguments.files == std::vector<std::wstring>{L"file1.txt"});
+    REQUIRE(arguments.profile == true);
+    REQUIRE(arguments.profileJsonFile == std::nullopt);
+    REQUIRE(arguments.programArguments == std::vector<std::wstring>{L"arg1"});
+}
+
+TEST_CASE("with --profile-json", "[parseArguments]")
+{
+    const char *argv[] = {"execname", "file1.txt", "--profile-json", "profile.json", "file2.txt"};
+    Arguments arguments = parseArguments(sizeof(argv) / sizeof(const char *), argv);
+    REQUIRE(arguments.files == std::vector<std::wstring>{L"file1.txt", L"file2.txt"});
+    REQUIRE(arguments.profile == true);
+    REQUIRE(arguments.profileJsonFile == L"profile.json");
+
+    const char *argvNoValue[] = {"execname", "file1.txt", "--profile-json"};
+    REQUIRE_THROWS_AS(
+        parseArguments(sizeof(argvNoValue) / sizeof(const char *), argvNoValue), MissingOptionValueError
+    );
+}
+
+TEST_CASE("with --sample and --sample-frequency", "[parseArguments]")
+{
+    const char *argv[] = {"execname", "file1.txt", "--sample", "stacks.txt"};
+    Arguments arguments = parseArguments(sizeof(argv) / sizeof(const char *), argv);
+    REQUIRE(arguments.sampleFile == L"stacks.txt");
+    REQUIRE(arguments.sampleFrequency == DEFAULT_SAMPLE_FREQUENCY);
+
+    const char *argvFrequency[] = {"execname", "file1.txt", "--sample-frequency", "250", "--sample", "stacks.txt"};
+    arguments = parseArguments(sizeof(argvFrequency) / sizeof(const char *), argvFrequency);
+    REQUIRE(arguments.sampleFile == L"stacks.txt");
+    REQUIRE(arguments.sampleFrequency == 250);
+
+    for(const char *invalid: {"0", "-5", "12a", "", "1000001", "99999999999999999999"})
+    {
+        const char *argvInvalid[] = {"execname", "file1.txt", "--sample-frequency", invalid};
+        REQUIRE_THROWS_AS(
+            parseArguments(sizeof(argvInvalid) / sizeof(const char *), argvInvalid), InvalidOptionValueError
+        );
+    }
+}
+
+TEST_CASE("with --trace", "[parseArguments]")
+{
+    const char *argv[] = {"execname", "file1.txt", "--trace", "trace.json"};
+    Arguments arguments = parseArguments(sizeof(argv) / sizeof(const char *), argv);
+    REQUIRE(arguments.files == std::vector<std::wstring>{L"file1.txt"});
+    REQUIRE(arguments.traceFile == L"trace.json");
+}
+
+TEST_CASE("with --batch and --jobs", "[parseArguments]")
+{
+    const char *argv[] = {"execname", "file1.txt", "--batch", "records.txt"};
+    Arguments arguments = parseArguments(sizeof(argv) / sizeof(const char *), argv);
+    REQUIRE(arguments.batchFile == L"records.txt");
+    REQUIRE(arguments.jobs == 0);
+
+    const char *argvJobs[] = {"execname", "--jobs", "8", "file1.txt", "--batch", "records.txt"};
+    arguments = parseArguments(sizeof(argvJobs) / sizeof(const char *), argvJobs);
+    REQUIRE(arguments.files == std::vector<std::wstring>{L"file1.txt"});
+    REQUIRE(arguments.batchFile == L"records.txt");
+    REQUIRE(arguments.jobs == 8);
+
+    for(const char *invalid: {"0", "-1", "x", "1025"})
+    {
+        const char *argvInvalid[] = {"execname", "file1.txt", "--batch", "records.txt", "--jobs", invalid};
+        REQUIRE_THROWS_AS(
+            parseArguments(sizeof(argvInvalid) / sizeof(const char *), argvInvalid), InvalidOptionValueError
+        );
+    }
+
+    const char *argvArgs[] = {"execname", "file1.txt", "--batch", "records.txt", "--args", "a"};
+    REQUIRE_THROWS_AS(parseArguments(sizeof(argvArgs) / sizeof(const char *), argvArgs), IncompatibleOptionsError);
+    const char *argvProfile[] = {"execname", "file1.txt", "--batch", "records.txt", "--profile"};
+    REQUIRE_THROWS_AS(
+        parseArguments(sizeof(argvProfile) / sizeof(const char *), argvProfile), IncompatibleOptionsError
+    );
+
+    const char *argvCooperative[] = {"execname", "file1.txt", "--batch", "records.txt", "--cooperative"};
+    arguments = parseArguments(sizeof(argvCooperative) / sizeof(const char *), argvCooperative);
+    REQUIRE(arguments.cooperative);
+    const char *argvNoBatch[] = {"execname", "file1.txt", "--cooperative"};
+    REQUIRE_THROWS_AS(
+        parseArguments(sizeof(argvNoBatch) / sizeof(const char *), argvNoBatch), IncompatibleOptionsError
+    );
+}
+
+TEST_CASE("with --serve", "[parseArguments]")
+{
+    const char *argv[] = {"execname", "--serve", "/tmp/inter.sock"};
+    Arguments arguments = parseArguments(sizeof(argv) / sizeof(const char *), argv);
+    REQUIRE(arguments.serveSocket == L"/tmp/inter.sock");
+    REQUIRE(arguments.files.empty());
+
+    const char *argvFiles[] = {"execname", "--serve", "/tmp/inter.sock", "file1.txt"};
+    REQUIRE_THROWS_AS(parseArguments(sizeof(argvFiles) / sizeof(const char *), argvFiles), IncompatibleOptionsError);
+    const char *argvArgs[] = {"execname", "--serve", "/tmp/inter.sock", "--args", "a"};
+    REQUIRE_THROWS_AS(parseArguments(sizeof(argvArgs) / sizeof(const char *), argvArgs), IncompatibleOptionsError);
+    const char *argvProfile[] = {"execname", "--serve", "/tmp/inter.sock", "--profile"};
+    REQUIRE_THROWS_AS(
+        parseArguments(sizeof(argvProfile) / sizeof(const char *), argvProfile), IncompatibleOptionsError
+    );
+    const char *argvNoValue[] = {"execname", "--serve"};
+    REQUIRE_THROWS_AS(
+        parseArguments(sizeof(argvNoValue) / sizeof(const char *), argvNoValue), MissingOptionValueError
+    );
+}
+
+TEST_CASE("with --repl", "[parseArguments]")
+{
+    const char *argv[] = {"execname", "--repl"};
+    Arguments arguments = parseArguments(sizeof(argv) / sizeof(const char *), argv);
+    REQUIRE(arguments.repl == true);
+    REQUIRE(arguments.files.empty());
+
+    const char *argvFiles[] = {"execname", "library.txt", "--repl", "--args", "a"};
+    arguments = parseArguments(sizeof(argvFiles) / sizeof(const char *), argvFiles);
+    REQUIRE(arguments.files == std::vector<std::wstring>{L"library.txt"});
+    REQUIRE(arguments.programArguments == std::vector<std::wstring>{L"a"});
+
+    const char *argvBatch[] = {"execname", "library.txt", "--repl", "--batch", "records.txt"};
+    REQUIRE_THROWS_AS(parseArguments(sizeof(argvBatch) / sizeof(const char *), argvBatch), IncompatibleOptionsError);
+    const char *argvProfile[] = {"execname", "--repl", "--profile"};
+    REQUIRE_THROWS_AS(
+        parseArguments(sizeof(argvProfile) / sizeof(const char *), argvProfile), IncompatibleOptionsError
+    );
+}
+
+TEST_CASE("with execution limits", "[parseArguments]")
+{
+    const char *argv[] = {"execname", "file1.txt"};
+    Arguments arguments = parseArguments(sizeof(argv) / sizeof(const char *), argv);
+    REQUIRE_FALSE(arguments.limits.maxInstructions);
+    REQUIRE_FALSE(arguments.limits.maxTime);
+    REQUIRE_FALSE(arguments.limits.maxHeapBytes);
+
+    const char *argvLimits[] = {"execname",   "--max-instructions", "5000000000", "--max-time", "1500",
+                                "--max-heap", "64",                 "file1.txt"};
+    arguments = parseArguments(sizeof(argvLimits) / sizeof(const char *), argvLimits);
+    REQUIRE(arguments.files == std::vector<std::wstring>{L"file1.txt"});
+    REQUIRE(arguments.limits.maxInstructions == 5000000000);
+    REQUIRE(arguments.limits.maxTime == std::chrono::milliseconds(1500));
+    REQUIRE(arguments.limits.maxHeapBytes == 64 << 20);
+
+    for(const char *option: {"--max-instructions", "--max-time", "--max-heap"})
+    {
+        for(const char *invalid: {"0", "-1", "x", "99999999999999999999"})
+        {
+            const char *argvInvalid[] = {"execname", "file1.txt", option, invalid};
+            REQUIRE_THROWS_AS(
+                parseArguments(sizeof(argvInvalid) / sizeof(const char *), argvInvalid), InvalidOptionValueError
+            );
+        }
+    }
+}
+
+TEST_CASE("with --report-pruned", "[parseArguments]")
+{
+    const char *argv[] = {"execname", "file1.txt", "--report-pruned"};
+    Arguments arguments = parseArguments(sizeof(argv) / sizeof(const char *), argv);
+    REQUIRE(arguments.reportPruned == true);
+    const char *argvNoReport[] = {"execname", "file1.txt"};
+    REQUIRE(parseArguments(sizeof(argvNoReport) / sizeof(const char *), argvNoReport).reportPruned == false);
+
+    const char *argvRepl[] = {"execname", "--repl", "--report-pruned"};
+    REQUIRE_THROWS_AS(parseArguments(sizeof(argvRepl) / sizeof(const char *), argvRepl), IncompatibleOptionsError);
+    const char *argvServe[] = {"execname", "--serve", "socket", "--report-pruned"};
+    REQUIRE_THROWS_AS(parseArguments(sizeof(argvServe) / sizeof(const char *), argvServe), IncompatibleOptionsError);
+}
@@ -0,0 +1,96 @@
+#include "batchExecution.hpp"
+
+#include "commentDiscarder.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "streamReader.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+
+namespace {
+CompiledProgram compile(const std::wstring &sourceCode)
+{
+    std::wstringstream sourceStream(sourceCode);
+    StreamReader reader(sourceStream, L"<test>");
+    Lexer lexer(reader);
+    CommentDiscarder commentDiscarder(lexer);
+    Parser parser(commentDiscarder);
+    return CompiledProgram(parser.parseProgram(), {L"<test>"}, [](const std::wstring &) -> Program {
+        throw std::runtime_error("No files should be included in these tests");
+    });
+}
+}
+
+TEST_CASE("batch records reading", "[BatchExecution]")
+{
+    std::wstringstream input(L"a b  c\n\n  single\t\nlast");
+    std::vector<std::vector<std::wstring>> records = readBatchRecords(input);
+    REQUIRE(records == std::vector<std::vector<std::wstring>>{{L"a", L"b", L"c"}, {}, {L"single"}, {L"last"}});
+
+    std::wstringstream empty(L"");
+    REQUIRE(readBatchRecords(empty).empty());
+}
+
+TEST_CASE("batch outputs in record order", "[BatchExecution]")
+{
+    // the earlier records take longer, so that they finish after the later ones
+    CompiledProgram program = compile(
+        L"func main() {\n"
+        L"    int n = int(argument(0));\n"
+        L"    int$ i = 0;\n"
+        L"    while(i < n * 1000) {\n"
+        L"        i = i + 1;\n"
+        L"    }\n"
+        L"    println(argument(0) ! \" \" ! no_arguments());\n"
+        L"}\n"
+    );
+    std::vector<std::vector<std::wstring>> records;
+    std::wstring expected;
+    for(int i = 20; i > 0; i--)
+    {
+        records.push_back({std::to_wstring(i), L"extra"});
+        expected += std::to_wstring(i) + L" 2\n";
+    }
+    for(auto run: {runBatch, runCooperativeBatch})
+    {
+        for(unsigned threads: {1, 4, 32})
+        {
+            std::wstringstream output;
+            std::stringstream errors;
+            REQUIRE(run(program, records, threads, output, errors, {}) == 0);
+            REQUIRE(output.str() == expected);
+            REQUIRE(errors.str().empty());
+        }
+    }
+}
+
+TEST_CASE("batch records with runtime errors", "[BatchExecution]")
+{
+    CompiledProgram program = compile(
+        L"func main() {\n"
+        L"    print(\"start \");\n"
+        L"    println(argument(0));\n"
+        L"}\n"
+    );
+    for(auto run: {runBatch, runCooperativeBatch})
+    {
+        std::wstringstream output;
+        std::stringstream errors;
+        REQUIRE(run(program, {{L"a"}, {}, {L"b"}, {}}, 3, output, errors, {}) == 2);
+        REQUIRE(output.str() == L"start a\nstart start b\nstart ");
+        REQUIRE(
+            errors.str() == "Batch record 2:\n"
+                            "The program was terminated following a runtime error:\n"
+                            "There is no program argument with index 0\n"
+                            "while executing file <test>\n"
+                            "at line 1, column 1.\n"
+                            "Batch record 4:\n"
+                            "The program was terminated following a runtime error:\n"
+                            "There is no program argument with index 0\n"
+                            "while executing file <test>\n"
+                            "at line 1, column 1.\n"
+        );
+    }
+}
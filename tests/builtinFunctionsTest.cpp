@@ -12,184 +12,315 @@ using enum Type::Builtin;
 TEST_CASE("noArguments", "[builtinFunctions]")
 {
     std::vector<std::wstring> arguments = {};
-    BuiltinFunction builtin = builtinNoArguments(arguments);
+    std::wstringstream input, output;
+    ExecutionEnvironment environment{arguments, input, output};
+    const BuiltinFunction &builtin = builtinNoArguments;
     std::vector<std::variant<Object, std::reference_wrapper<Object>>> args = {};
-    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args) == Object{{INT}, 0});
+    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{INT}, 0});
 
     arguments = {L"arg1", L"arg2"};
-    builtin = builtinNoArguments(arguments);
-    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args) == Object{{INT}, 2});
+    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{INT}, 2});
 }
 
 TEST_CASE("argument", "[builtinFunctions]")
 {
     std::vector<std::wstring> arguments = {L"arg1", L"arg2"};
-    BuiltinFunction builtin = builtinArgument(arguments);
+    std::wstringstream input, output;
+    ExecutionEnvironment environment{arguments, input, output};
+    const BuiltinFunction &builtin = builtinArgument;
     Object arg{{INT}, 0};
     std::vector<std::variant<Object, std::reference_wrapper<Object>>> args = {arg};
-    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args) == Object{{STR}, L"arg1"});
+    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{STR}, L"arg1"});
 
     arg.value = 1;
-    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args) == Object{{STR}, L"arg2"});
+    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{STR}, L"arg2"});
 
     arg.value = -1;
-    REQUIRE_THROWS_AS(builtin.second.body(Position{1, 1}, L"<test>", args), BuiltinFunctionArgumentError);
+    REQUIRE_THROWS_AS(builtin.second.body(Position{1, 1}, L"<test>", args, environment), BuiltinFunctionArgumentError);
 
     arg.value = 2;
-    REQUIRE_THROWS_AS(builtin.second.body(Position{1, 1}, L"<test>", args), BuiltinFunctionArgumentError);
+    REQUIRE_THROWS_AS(builtin.second.body(Position{1, 1}, L"<test>", args, environment), BuiltinFunctionArgumentError);
 }
 
 TEST_CASE("print", "[builtinFunctions]")
 {
-    std::wstringstream output;
-    BuiltinFunction builtin = builtinPrint(output);
+    std::vector<std::wstring> arguments;
+    std::wstringstream input, output;
+    ExecutionEnvironment environment{arguments, input, output};
+    const BuiltinFunction &builtin = builtinPrint;
     Object arg{{STR}, L"message"};
     std::vector<std::variant<Object, std::reference_wrapper<Object>>> args = {arg};
-    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args) == std::nullopt);
+    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args, environment) == std::nullopt);
     REQUIRE(output.str() == L"message");
 
     output.setstate(std::ios::badbit);
-    REQUIRE_THROWS_AS(builtin.second.body(Position{1, 1}, L"<test>", args), StandardOutputError);
+    REQUIRE_THROWS_AS(builtin.second.body(Position{1, 1}, L"<test>", args, environment), StandardOutputError);
 }
 
 TEST_CASE("println", "[builtinFunctions]")
 {
-    std::wstringstream output;
-    BuiltinFunction builtin = builtinPrintln(output);
+    std::vector<std::wstring> arguments;
+    std::wstringstream input, output;
+    ExecutionEnvironment environment{arguments, input, output};
+    const BuiltinFunction &builtin = builtinPrintln;
     Object arg{{STR}, L"message"};
     std::vector<std::variant<Object, std::reference_wrapper<Object>>> args = {arg};
-    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args) == std::nullopt);
+    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args, environment) == std::nullopt);
     REQUIRE(output.str() == L"message\n");
 
     output.setstate(std::ios::badbit);
-    REQUIRE_THROWS_AS(builtin.second.body(Position{1, 1}, L"<test>", args), StandardOutputError);
+    REQUIRE_THROWS_AS(builtin.second.body(Position{1, 1}, L"<test>", args, environment), StandardOutputError);
 }
 
 TEST_CASE("input()", "[builtinFunctions]")
 {
+    std::vector<std::wstring> arguments;
     std::wstringstream input(L"a line of data\nanother line\nend");
-    BuiltinFunction builtin = builtinInputLine(input);
+    std::wstringstream output;
+    ExecutionEnvironment environment{arguments, input, output};
+    const BuiltinFunction &builtin = builtinInputLine;
     std::vector<std::variant<Object, std::reference_wrapper<Object>>> args = {};
-    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args) == Object{{STR}, L"a line of data"});
-    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args) == Object{{STR}, L"another line"});
-    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args) == Object{{STR}, L"end"});
-    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args) == Object{{STR}, L""});
+    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{STR}, L"a line of data"});
+    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{STR}, L"another line"});
+    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{STR}, L"end"});
+    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{STR}, L""});
 
     input.setstate(std::ios::badbit);
-    REQUIRE_THROWS_AS(builtin.second.body(Position{1, 1}, L"<test>", args), StandardInputError);
+    REQUIRE_THROWS_AS(builtin.second.body(Position{1, 1}, L"<test>", args, environment), StandardInputError);
 }
 
 TEST_CASE("input(int)", "[builtinFunctions]")
 {
+    std::vector<std::wstring> arguments;
     std::wstringstream input(L"a line of data\nanother line\nend");
-    BuiltinFunction builtin = builtinInput(input);
+    std::wstringstream output;
+    ExecutionEnvironment environment{arguments, input, output};
+    const BuiltinFunction &builtin = builtinInput;
     Object arg{{INT}, 0};
     std::vector<std::variant<Object, std::reference_wrapper<Object>>> args = {arg};
-    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args) == Object{{STR}, L""});
+    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{STR}, L""});
 
     arg.value = 5;
-    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args) == Object{{STR}, L"a lin"});
+    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{STR}, L"a lin"});
 
     arg.value = 15;
-    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args) == Object{{STR}, L"e of data\nanoth"});
-    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args) == Object{{STR}, L"er line\nend"});
-    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args) == Object{{STR}, L""});
+    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{STR}, L"e of data\nanoth"});
+    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{STR}, L"er line\nend"});
+    REQUIRE(builtin.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{STR}, L""});
 
     arg.value = -1;
-    REQUIRE_THROWS_AS(builtin.second.body(Position{1, 1}, L"<test>", args), BuiltinFunctionArgumentError);
+    REQUIRE_THROWS_AS(builtin.second.body(Position{1, 1}, L"<test>", args, environment), BuiltinFunctionArgumentError);
 
     arg.value = 5;
     input.setstate(std::ios::badbit);
-    REQUIRE_THROWS_AS(builtin.second.body(Position{1, 1}, L"<test>", args), StandardInputError);
+    REQUIRE_THROWS_AS(builtin.second.body(Position{1, 1}, L"<test>", args, environment), StandardInputError);
 }
 
 TEST_CASE("len", "[builtinFunctions]")
 {
+    std::vector<std::wstring> arguments;
+    std::wstringstream input, output;
+    ExecutionEnvironment environment{arguments, input, output};
     Object arg{{STR}, L""};
     std::vector<std::variant<Object, std::reference_wrapper<Object>>> args = {arg};
-    REQUIRE(builtinLen.second.body(Position{1, 1}, L"<test>", args) == Object{{INT}, 0});
+    REQUIRE(builtinLen.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{INT}, 0});
 
     arg.value = L"value";
-    REQUIRE(builtinLen.second.body(Position{1, 1}, L"<test>", args) == Object{{INT}, 5});
+    REQUIRE(builtinLen.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{INT}, 5});
+}
+
+namespace {
+std::optional<Object> callWithStrings(
+    const BuiltinFunction &builtin, std::vector<Object> &arguments, ExecutionEnvironment &environment
+)
+{
+    std::vector<std::variant<Object, std::reference_wrapper<Object>>> args;
+    for(Object &argument: arguments)
+        args.push_back(std::ref(argument));
+    return builtin.second.body(Position{1, 1}, L"<test>", args, environment);
+}
+}
+
+TEST_CASE("substr", "[builtinFunctions]")
+{
+    std::vector<std::wstring> arguments;
+    std::wstringstream input, output;
+    ExecutionEnvironment environment{arguments, input, output};
+    std::vector<Object> args;
+    args.push_back(Object{{STR}, L"value"});
+    args.push_back(Object{{INT}, 1});
+    args.push_back(Object{{INT}, 3});
+    REQUIRE(callWithStrings(builtinSubstr, args, environment) == Object{{STR}, L"alu"});
+
+    args[2].value = 10;
+    REQUIRE(callWithStrings(builtinSubstr, args, environment) == Object{{STR}, L"alue"});
+
+    args[1].value = 5;
+    REQUIRE(callWithStrings(builtinSubstr, args, environment) == Object{{STR}, L""});
+
+    args[1].value = 6;
+    REQUIRE_THROWS_AS(callWithStrings(builtinSubstr, args, environment), BuiltinFunctionArgumentError);
+
+    args[1].value = -1;
+    REQUIRE_THROWS_AS(callWithStrings(builtinSubstr, args, environment), BuiltinFunctionArgumentError);
+
+    args[1].value = 0;
+    args[2].value = -1;
+    REQUIRE_THROWS_AS(callWithStrings(builtinSubstr, args, environment), BuiltinFunctionArgumentError);
+}
+
+TEST_CASE("find, starts_with", "[builtinFunctions]")
+{
+    std::vector<std::wstring> arguments;
+    std::wstringstream input, output;
+    ExecutionEnvironment environment{arguments, input, output};
+    std::vector<Object> args;
+    args.push_back(Object{{STR}, L"a, b, c"});
+    args.push_back(Object{{STR}, L", "});
+    REQUIRE(callWithStrings(builtinFind, args, environment) == Object{{INT}, 1});
+    REQUIRE(callWithStrings(builtinStartsWith, args, environment) == Object{{BOOL}, false});
+
+    args[1].value = L"a,";
+    REQUIRE(callWithStrings(builtinFind, args, environment) == Object{{INT}, 0});
+    REQUIRE(callWithStrings(builtinStartsWith, args, environment) == Object{{BOOL}, true});
+
+    args[1].value = L"d";
+    REQUIRE(callWithStrings(builtinFind, args, environment) == Object{{INT}, -1});
+
+    args[1].value = L"";
+    REQUIRE(callWithStrings(builtinFind, args, environment) == Object{{INT}, 0});
+    REQUIRE(callWithStrings(builtinStartsWith, args, environment) == Object{{BOOL}, true});
+}
+
+TEST_CASE("split", "[builtinFunctions]")
+{
+    std::vector<std::wstring> arguments;
+    std::wstringstream input, output;
+    ExecutionEnvironment environment{arguments, input, output};
+    std::vector<Object> args;
+    args.push_back(Object{{STR}, L"a, b,, c, "});
+    args.push_back(Object{{STR}, L", "});
+    Type arrayType{Type::Array({STR})};
+    std::vector<Object> parts;
+    for(const wchar_t *part: {L"a", L"b,", L"c", L""})
+        parts.push_back(Object{{STR}, part});
+    REQUIRE(callWithStrings(builtinSplit, args, environment) == Object{arrayType, std::move(parts)});
+
+    args[0].value = L"";
+    parts.clear();
+    parts.push_back(Object{{STR}, L""});
+    REQUIRE(callWithStrings(builtinSplit, args, environment) == Object{arrayType, std::move(parts)});
+
+    args[1].value = L"";
+    REQUIRE_THROWS_AS(callWithStrings(builtinSplit, args, environment), BuiltinFunctionArgumentError);
+}
+
+TEST_CASE("trim", "[builtinFunctions]")
+{
+    std::vector<std::wstring> arguments;
+    std::wstringstream input, output;
+    ExecutionEnvironment environment{arguments, input, output};
+    std::vector<Object> args;
+    args.push_back(Object{{STR}, L" \t value with spaces \n"});
+    REQUIRE(callWithStrings(builtinTrim, args, environment) == Object{{STR}, L"value with spaces"});
+
+    args[0].value = L"   ";
+    REQUIRE(callWithStrings(builtinTrim, args, environment) == Object{{STR}, L""});
+
+    args[0].value = L"value";
+    REQUIRE(callWithStrings(builtinTrim, args, environment) == Object{{STR}, L"value"});
 }
 
 TEST_CASE("abs(float)", "[builtinFunctions]")
 {
+    std::vector<std::wstring> arguments;
+    std::wstringstream input, output;
+    ExecutionEnvironment environment{arguments, input, output};
     Object arg{{FLOAT}, 3.4};
     std::vector<std::variant<Object, std::reference_wrapper<Object>>> args = {arg};
-    REQUIRE(builtinAbsFloat.second.body(Position{1, 1}, L"<test>", args) == Object{{FLOAT}, 3.4});
+    REQUIRE(builtinAbsFloat.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{FLOAT}, 3.4});
 
     arg.value = -3.4;
-    REQUIRE(builtinAbsFloat.second.body(Position{1, 1}, L"<test>", args) == Object{{FLOAT}, 3.4});
+    REQUIRE(builtinAbsFloat.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{FLOAT}, 3.4});
 
     arg.value = 0.0;
-    REQUIRE(builtinAbsFloat.second.body(Position{1, 1}, L"<test>", args) == Object{{FLOAT}, 0.0});
+    REQUIRE(builtinAbsFloat.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{FLOAT}, 0.0});
 }
 
 TEST_CASE("abs(int)", "[builtinFunctions]")
 {
+    std::vector<std::wstring> arguments;
+    std::wstringstream input, output;
+    ExecutionEnvironment environment{arguments, input, output};
     Object arg{{INT}, 5};
     std::vector<std::variant<Object, std::reference_wrapper<Object>>> args = {arg};
-    REQUIRE(builtinAbsInt.second.body(Position{1, 1}, L"<test>", args) == Object{{INT}, 5});
+    REQUIRE(builtinAbsInt.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{INT}, 5});
 
     arg.value = -5;
-    REQUIRE(builtinAbsInt.second.body(Position{1, 1}, L"<test>", args) == Object{{INT}, 5});
+    REQUIRE(builtinAbsInt.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{INT}, 5});
 
     arg.value = 0;
-    REQUIRE(builtinAbsInt.second.body(Position{1, 1}, L"<test>", args) == Object{{INT}, 0});
+    REQUIRE(builtinAbsInt.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{INT}, 0});
 
     arg.value = std::numeric_limits<int32_t>::max();
     REQUIRE(
-        builtinAbsInt.second.body(Position{1, 1}, L"<test>", args) == Object{{INT}, std::numeric_limits<int32_t>::max()}
+        builtinAbsInt.second.body(Position{1, 1}, L"<test>", args, environment) ==
+        Object{{INT}, std::numeric_limits<int32_t>::max()}
     );
 
     arg.value = std::numeric_limits<int32_t>::min() + 1;
     REQUIRE(
-        builtinAbsInt.second.body(Position{1, 1}, L"<test>", args) == Object{{INT}, std::numeric_limits<int32_t>::max()}
+        builtinAbsInt.second.body(Position{1, 1}, L"<test>", args, environment) ==
+        Object{{INT}, std::numeric_limits<int32_t>::max()}
     );
 
     arg.value = std::numeric_limits<int32_t>::min();
-    REQUIRE_THROWS_AS(builtinAbsInt.second.body(Position{1, 1}, L"<test>", args), IntegerRangeError);
+    REQUIRE_THROWS_AS(builtinAbsInt.second.body(Position{1, 1}, L"<test>", args, environment), IntegerRangeError);
 }
 
 TEST_CASE("max(float, float), min(float, float)", "[builtinFunctions]")
 {
+    std::vector<std::wstring> arguments;
+    std::wstringstream input, output;
+    ExecutionEnvironment environment{arguments, input, output};
     Object arg1{{FLOAT}, 3.4};
     Object arg2{{FLOAT}, 7.8};
     std::vector<std::variant<Object, std::reference_wrapper<Object>>> args = {arg1, arg2};
-    REQUIRE(builtinMaxFloat.second.body(Position{1, 1}, L"<test>", args) == Object{{FLOAT}, 7.8});
-    REQUIRE(builtinMinFloat.second.body(Position{1, 1}, L"<test>", args) == Object{{FLOAT}, 3.4});
+    REQUIRE(builtinMaxFloat.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{FLOAT}, 7.8});
+    REQUIRE(builtinMinFloat.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{FLOAT}, 3.4});
 
     arg1.value = -3.4;
-    REQUIRE(builtinMaxFloat.second.body(Position{1, 1}, L"<test>", args) == Object{{FLOAT}, 7.8});
-    REQUIRE(builtinMinFloat.second.body(Position{1, 1}, L"<test>", args) == Object{{FLOAT}, -3.4});
+    REQUIRE(builtinMaxFloat.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{FLOAT}, 7.8});
+    REQUIRE(builtinMinFloat.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{FLOAT}, -3.4});
 
     arg2.value = -20.0;
-    REQUIRE(builtinMaxFloat.second.body(Position{1, 1}, L"<test>", args) == Object{{FLOAT}, -3.4});
-    REQUIRE(builtinMinFloat.second.body(Position{1, 1}, L"<test>", args) == Object{{FLOAT}, -20.0});
+    REQUIRE(builtinMaxFloat.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{FLOAT}, -3.4});
+    REQUIRE(builtinMinFloat.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{FLOAT}, -20.0});
 }
 
 TEST_CASE("max(int, int), min(int, int)", "[builtinFunctions]")
 {
+    std::vector<std::wstring> arguments;
+    std::wstringstream input, output;
+    ExecutionEnvironment environment{arguments, input, output};
     Object arg1{{INT}, 3};
     Object arg2{{INT}, 7};
     std::vector<std::variant<Object, std::reference_wrapper<Object>>> args = {arg1, arg2};
-    REQUIRE(builtinMaxInt.second.body(Position{1, 1}, L"<test>", args) == Object{{INT}, 7});
-    REQUIRE(builtinMinInt.second.body(Position{1, 1}, L"<test>", args) == Object{{INT}, 3});
+    REQUIRE(builtinMaxInt.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{INT}, 7});
+    REQUIRE(builtinMinInt.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{INT}, 3});
 
     arg1.value = -3;
-    REQUIRE(builtinMaxInt.second.body(Position{1, 1}, L"<test>", args) == Object{{INT}, 7});
-    REQUIRE(builtinMinInt.second.body(Position{1, 1}, L"<test>", args) == Object{{INT}, -3});
+    REQUIRE(builtinMaxInt.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{INT}, 7});
+    REQUIRE(builtinMinInt.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{INT}, -3});
 
     arg2.value = -20;
-    REQUIRE(builtinMaxInt.second.body(Position{1, 1}, L"<test>", args) == Object{{INT}, -3});
-    REQUIRE(builtinMinInt.second.body(Position{1, 1}, L"<test>", args) == Object{{INT}, -20});
+    REQUIRE(builtinMaxInt.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{INT}, -3});
+    REQUIRE(builtinMinInt.second.body(Position{1, 1}, L"<test>", args, environment) == Object{{INT}, -20});
 }
 
 TEST_CASE("prepareBuiltinFunctions", "[builtinFunctions]")
 {
-    std::wstringstream iostream;
-    Program builtins = prepareBuiltinFunctions({2, 1}, {}, iostream, iostream);
+    Program builtins = prepareBuiltinFunctions({2, 1});
     REQUIRE(builtins.getPosition() == Position{2, 1});
     REQUIRE(builtins.includes.size() == 0);
     REQUIRE(builtins.variants.size() == 0);
@@ -198,7 +329,8 @@ TEST_CASE("prepareBuiltinFunctions", "[builtinFunctions]")
         {L"no_arguments", {}},    {L"argument", {{INT}}},       {L"print", {{STR}}},      {L"println", {{STR}}},
         {L"input", {}},           {L"input", {{INT}}},          {L"len", {{STR}}},        {L"abs", {{INT}}},
         {L"abs", {{FLOAT}}},      {L"max", {{FLOAT}, {FLOAT}}}, {L"max", {{INT}, {INT}}}, {L"min", {{FLOAT}, {FLOAT}}},
-        {L"min", {{INT}, {INT}}},
+        {L"min", {{INT}, {INT}}}, {L"substr", {{STR}, {INT}, {INT}}}, {L"find", {{STR}, {STR}}},
+        {L"starts_with", {{STR}, {STR}}}, {L"split", {{STR}, {STR}}}, {L"trim", {{STR}}},
     };
     REQUIRE(builtins.functions.size() == builtinIds.size());
     for(const FunctionIdentification &id: builtinIds)
@@ -0,0 +1,188 @@
+#include "compiledProgram.hpp"
+
+#include "commentDiscarder.hpp"
+#include "execution.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "runtimeExceptions.hpp"
+#include "semanticExceptions.hpp"
+#include "streamReader.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+namespace {
+Program parseSource(
+    const std::wstring &sourceCode, const std::wstring &sourceName, Parser::BodyMode bodyMode = Parser::BodyMode::PARSE
+)
+{
+    std::wstringstream sourceStream(sourceCode);
+    StreamReader reader(sourceStream, sourceName);
+    Lexer lexer(reader);
+    CommentDiscarder commentDiscarder(lexer);
+    Parser parser(commentDiscarder, bodyMode);
+    return parser.parseProgram();
+}
+
+Program parseNothing(const std::wstring &)
+{
+    throw std::runtime_error("No files should be included in these tests");
+}
+
+std::wstring execute(
+    const CompiledProgram &program, const std::vector<std::wstring> &arguments, const std::wstring &standardInput = L""
+)
+{
+    std::wstringstream input(standardInput), output;
+    Execution execution(program, arguments, input, output);
+    execution.run();
+    return output.str();
+}
+}
+
+TEST_CASE("compiled program executed many times", "[CompiledProgram]")
+{
+    CompiledProgram program(
+        parseSource(
+            L"func main() {\n"
+            L"    str$ joined = input();\n"
+            L"    int$ i = 0;\n"
+            L"    while(i < no_arguments()) {\n"
+            L"        joined = joined ! argument(i);\n"
+            L"        i = i + 1;\n"
+            L"    }\n"
+            L"    println(joined);\n"
+            L"}\n",
+            L"<test>"
+        ),
+        {L"<test>"}, parseNothing
+    );
+    REQUIRE(execute(program, {}) == L"\n");
+    REQUIRE(execute(program, {L"a", L"b"}, L"input:") == L"input:ab\n");
+    REQUIRE(execute(program, {L"c"}, L"x\ny") == L"xc\n");
+}
+
+TEST_CASE("execution state is not shared", "[CompiledProgram]")
+{
+    CompiledProgram program(
+        parseSource(
+            L"func count(int n) -> int {\n"
+            L"    if(n == 0) {\n"
+            L"        return 0;\n"
+            L"    }\n"
+            L"    return 1 + count(n - 1);\n"
+            L"}\n"
+            L"func main() {\n"
+            L"    println(str(count(int(argument(0)))));\n"
+            L"}\n",
+            L"<test>"
+        ),
+        {L"<test>"}, parseNothing
+    );
+    REQUIRE_THROWS_AS(execute(program, {L"1000"}), StackOverflowError);
+    REQUIRE(execute(program, {L"10"}) == L"10\n");
+    REQUIRE_THROWS_AS(execute(program, {}), BuiltinFunctionArgumentError);
+    REQUIRE(execute(program, {L"3"}) == L"3\n");
+}
+
+TEST_CASE("compiled program from source files", "[CompiledProgram]")
+{
+    std::vector<std::wstring> parsed;
+    auto parseFromFile = [&](const std::wstring &fileName) -> Program {
+        parsed.push_back(fileName);
+        if(fileName == L"main.txt")
+            return parseSource(L"include \"greeting.txt\";\nfunc main() {\n    greet(argument(0));\n}\n", fileName);
+        if(fileName == L"greeting.txt")
+            return parseSource(L"func greet(str name) {\n    println(\"Hello, \" ! name);\n}\n", fileName);
+        return parseSource(L"func unused() {}\n", fileName);
+    };
+    CompiledProgram program({L"main.txt", L"other.txt"}, parseFromFile);
+    REQUIRE(parsed == std::vector<std::wstring>{L"main.txt", L"other.txt", L"greeting.txt"});
+    REQUIRE(program.getSourceFiles() == std::vector<std::wstring>{L"main.txt", L"other.txt", L"greeting.txt"});
+    REQUIRE(program.getMain().first == FunctionIdentification(L"main", {}));
+    REQUIRE(execute(program, {L"world"}) == L"Hello, world\n");
+    REQUIRE(execute(program, {L"again"}) == L"Hello, again\n");
+    REQUIRE(parsed.size() == 3);
+}
+
+TEST_CASE("compilation errors", "[CompiledProgram]")
+{
+    REQUIRE_THROWS_AS(
+        CompiledProgram(parseSource(L"func f() {}\n", L"<test>"), {L"<test>"}, parseNothing), MainNotFoundError
+    );
+    REQUIRE_THROWS_AS(
+        CompiledProgram(parseSource(L"func main() -> int {\n    return 1;\n}\n", L"<test>"), {L"<test>"}, parseNothing),
+        MainReturnTypeError
+    );
+    REQUIRE_THROWS_AS(
+        CompiledProgram(parseSource(L"func main() {\n    f();\n}\n", L"<test>"), {L"<test>"}, parseNothing),
+        InvalidFunctionCallError
+    );
+}
+
+TEST_CASE("declarations unreachable from main are pruned", "[CompiledProgram]")
+{
+    std::wstring source = L"struct Point {int x; int y;}\n"
+                          L"struct Circle {Point center; float radius;}\n"
+                          L"variant Shape {Point point; Circle circle;}\n"
+                          L"struct Unused {int a;}\n"
+                          L"variant Other {int a; str b;}\n"
+                          L"func describe(Shape shape) -> str {\n"
+                          L"    return \"shape\";\n"
+                          L"}\n"
+                          L"func describe(int value) -> str {\n"
+                          L"    return str(value);\n"
+                          L"}\n"
+                          L"func helper(Unused value) -> int {\n"
+                          L"    return value.a;\n"
+                          L"}\n"
+                          L"func invalid() {\n"
+                          L"    int a = \"text\" ! helper({1});\n"
+                          L"    print(1 +);\n"
+                          L"}\n"
+                          L"func main() {\n"
+                          L"    Point p = {1, 2};\n"
+                          L"    println(describe(p.x));\n"
+                          L"}\n";
+    // the unreachable function with errors is neither parsed nor analyzed
+    CompiledProgram program(parseSource(source, L"<test>", Parser::BodyMode::SKIP), {L"<test>"}, parseNothing);
+    REQUIRE(execute(program, {}) == L"1\n");
+    const PrunedDeclarations &pruned = program.getPruned();
+    REQUIRE(pruned.structs == std::vector<std::wstring>{L"Unused"});
+    REQUIRE(pruned.variants == std::vector<std::wstring>{L"Other"});
+    for(const FunctionIdentification &id: pruned.functions)
+    {
+        REQUIRE(id.name != L"describe");
+        REQUIRE(id.name != L"println");
+        REQUIRE_FALSE(program.getProgram().functions.contains(id));
+    }
+    for(std::wstring name: {L"helper", L"invalid", L"input"})
+    {
+        REQUIRE(std::any_of(pruned.functions.begin(), pruned.functions.end(), [&](const FunctionIdentification &id) {
+            return id.name == name;
+        }));
+    }
+    REQUIRE(program.getProgram().functions.size() == 4);
+    REQUIRE(program.getProgram().structs.size() == 2);
+    REQUIRE(program.getProgram().variants.size() == 1);
+
+    std::wstringstream report;
+    pruned.printReport(report);
+    REQUIRE(report.str().starts_with(
+        std::format(L"Pruned {} functions, 1 structs and 1 variants unreachable from main\n", pruned.functions.size())
+    ));
+    REQUIRE(report.str().find(L"\nfunction helper(Unused)\n") != std::wstring::npos);
+    REQUIRE(report.str().find(L"\nfunction input\n") != std::wstring::npos);
+    REQUIRE(report.str().ends_with(L"struct Unused\nvariant Other\n"));
+
+    // names of the unreachable declarations still collide
+    REQUIRE_THROWS_AS(
+        CompiledProgram(
+            parseSource(L"struct helper {int a;}\nfunc helper() {}\nfunc main() {}\n", L"<test>"), {L"<test>"},
+            parseNothing
+        ),
+        NameCollisionError
+    );
+}
@@ -0,0 +1,158 @@
+#include "cooperativeScheduler.hpp"
+
+#include "commentDiscarder.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "runtimeExceptions.hpp"
+#include "streamReader.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <csignal>
+#include <sstream>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+const size_t TEST_STACK_SIZE = 512 * 1024;
+
+CompiledProgram compile(const std::wstring &sourceCode)
+{
+    std::wstringstream sourceStream(sourceCode);
+    StreamReader reader(sourceStream, L"<test>");
+    Lexer lexer(reader);
+    CommentDiscarder commentDiscarder(lexer);
+    Parser parser(commentDiscarder);
+    return CompiledProgram(parser.parseProgram(), {L"<test>"}, [](const std::wstring &) -> Program {
+        throw std::runtime_error("No files should be included in these tests");
+    });
+}
+
+const std::wstring lineNumberAdder = L"func main() {\n"
+                                     L"    int$ i = 1;\n"
+                                     L"    str$ line = input();\n"
+                                     L"    while(len(line) > 0) {\n"
+                                     L"        println(argument(0) ! i ! \" \" ! line);\n"
+                                     L"        line = input();\n"
+                                     L"        i = i + 1;\n"
+                                     L"    }\n"
+                                     L"}\n";
+}
+
+TEST_CASE("instance suspended until input is provided", "[CooperativeScheduler]")
+{
+    CompiledProgram program = compile(lineNumberAdder);
+    CooperativeScheduler scheduler(1, TEST_STACK_SIZE);
+    CooperativeScheduler::Instance &instance = scheduler.start(program, {L"#"});
+    instance.provideInput(L"first ");
+    instance.provideInput(L"line\nsecond");
+    instance.provideInput(L" line\n");
+    REQUIRE_FALSE(instance.isFinished());
+    instance.closeInput();
+    instance.wait();
+    REQUIRE(instance.isFinished());
+    REQUIRE(instance.takeOutput() == L"#1 first line\n#2 second line\n");
+    REQUIRE(instance.takeOutput() == L"");
+}
+
+TEST_CASE("thousands of instances multiplexed over few threads", "[CooperativeScheduler]")
+{
+    const unsigned INSTANCES = 2000;
+    CompiledProgram program = compile(lineNumberAdder);
+    CooperativeScheduler scheduler(2, TEST_STACK_SIZE);
+    std::vector<CooperativeScheduler::Instance *> instances;
+    for(unsigned i = 0; i < INSTANCES; i++)
+        instances.push_back(&scheduler.start(program, {std::to_wstring(i) + L":"}));
+    // every instance is waiting for input, so the input is provided to them in turns
+    for(unsigned line = 0; line < 3; line++)
+    {
+        for(unsigned i = 0; i < INSTANCES; i++)
+            instances[i]->provideInput(std::format(L"line {} of {}\n", line, i));
+    }
+    for(CooperativeScheduler::Instance *instance: instances)
+        instance->closeInput();
+    for(unsigned i = 0; i < INSTANCES; i++)
+    {
+        instances[i]->wait();
+        REQUIRE(
+            instances[i]->takeOutput() == std::format(
+                                              L"{0}:1 line 0 of {0}\n{0}:2 line 1 of {0}\n{0}:3 line 2 of {0}\n", i
+                                          )
+        );
+    }
+}
+
+TEST_CASE("runtime errors of instances", "[CooperativeScheduler]")
+{
+    CompiledProgram program = compile(lineNumberAdder);
+    CooperativeScheduler scheduler(2, TEST_STACK_SIZE);
+    CooperativeScheduler::Instance &failing = scheduler.start(program, {});
+    CooperativeScheduler::Instance &succeeding = scheduler.start(program, {L">"});
+    failing.provideInput(L"line\n");
+    succeeding.provideInput(L"line\n");
+    REQUIRE_THROWS_AS(failing.wait(), BuiltinFunctionArgumentError);
+    succeeding.closeInput();
+    succeeding.wait();
+    REQUIRE(succeeding.takeOutput() == L">1 line\n");
+}
+
+TEST_CASE("recursion limit reached within the default stack size", "[CooperativeScheduler]")
+{
+    CompiledProgram program = compile(
+        L"func depth(int n) -> int {\n"
+        L"    return 1 + depth(n + 1);\n"
+        L"}\n"
+        L"func main() {\n"
+        L"    println(input());\n"
+        L"    int result = depth(0);\n"
+        L"}\n"
+    );
+    CooperativeScheduler scheduler(2);
+    CooperativeScheduler::Instance &first = scheduler.start(program, {});
+    CooperativeScheduler::Instance &second = scheduler.start(program, {});
+    first.provideInput(L"first\n");
+    second.provideInput(L"second\n");
+    REQUIRE_THROWS_AS(first.wait(), StackOverflowError);
+    REQUIRE_THROWS_AS(second.wait(), StackOverflowError);
+    REQUIRE(first.takeOutput() == L"first\n");
+    REQUIRE(second.takeOutput() == L"second\n");
+}
+
+TEST_CASE("instances finished by the scheduler destructor", "[CooperativeScheduler]")
+{
+    CompiledProgram program = compile(lineNumberAdder);
+    CooperativeScheduler scheduler(3, TEST_STACK_SIZE);
+    for(unsigned i = 0; i < 10; i++)
+    {
+        CooperativeScheduler::Instance &instance = scheduler.start(program, {L""});
+        instance.provideInput(L"never closed\n");
+        REQUIRE_FALSE(instance.isFinished());
+    }
+    // the destructor closes the input of the waiting instances, so that they finish
+}
+
+TEST_CASE("fiber stacks overflowing into the guard page", "[CooperativeScheduler]")
+{
+    CooperativeScheduler::FiberStack stack(TEST_STACK_SIZE + 1);
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    REQUIRE(stack.getSize() >= TEST_STACK_SIZE + 1);
+    REQUIRE(stack.getSize() % pageSize == 0);
+    // the whole stack is writable
+    stack.getBottom()[0] = 1;
+    stack.getBottom()[stack.getSize() - 1] = 1;
+
+    // a write below the stack faults, which is checked in a child process
+    pid_t child = fork();
+    REQUIRE(child >= 0);
+    if(child == 0)
+    {
+        volatile char *belowStack = stack.getBottom() - 1;
+        *belowStack = 1;
+        _exit(0);
+    }
+    int status;
+    REQUIRE(waitpid(child, &status, 0) == child);
+    REQUIRE(WIFSIGNALED(status));
+    REQUIRE(WTERMSIG(status) == SIGSEGV);
+}
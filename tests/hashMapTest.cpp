@@ -0,0 +1,64 @@
+#include "hashMap.hpp"
+
+#include "object.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+using enum Type::Builtin;
+
+TEST_CASE("values are inserted, found and overwritten", "[HashMap]")
+{
+    HashMap map;
+    REQUIRE(map.size() == 0);
+    REQUIRE(map.find(1) == nullptr);
+    map.findOrInsert(1) = Object{{INT}, 10};
+    map.findOrInsert("1") = Object{{STR}, std::wstring(L"one")};
+    REQUIRE(map.size() == 2);
+    REQUIRE(*map.find(1) == Object{{INT}, 10});
+    REQUIRE(*map.find("1") == Object{{STR}, std::wstring(L"one")});
+    map.findOrInsert(1) = Object{{INT}, 11};
+    REQUIRE(map.size() == 2);
+    REQUIRE(*map.find(1) == Object{{INT}, 11});
+    REQUIRE(map.find(2) == nullptr);
+}
+
+TEST_CASE("entries stay reachable after growing and removals", "[HashMap]")
+{
+    HashMap map;
+    for(int32_t key = 0; key < 1000; key++)
+        map.findOrInsert(key) = Object{{INT}, key * 2};
+    REQUIRE(map.size() == 1000);
+    REQUIRE(map.getTableSize() >= 1000 * 4 / 3);
+    for(int32_t key = 0; key < 1000; key += 2)
+        REQUIRE(map.remove(key));
+    REQUIRE_FALSE(map.remove(0));
+    REQUIRE(map.size() == 500);
+    for(int32_t key = 0; key < 1000; key++)
+    {
+        if(key % 2 == 0)
+            REQUIRE(map.find(key) == nullptr);
+        else
+            REQUIRE(*map.find(key) == Object{{INT}, key * 2});
+    }
+    unsigned long long visited = 0;
+    map.forEach([&](const HashMap::Key &key, const Object &value) {
+        visited += 1;
+        REQUIRE(value == Object{{INT}, std::get<int32_t>(key) * 2});
+    });
+    REQUIRE(visited == 500);
+}
+
+TEST_CASE("maps are compared regardless of insertion order", "[HashMap]")
+{
+    HashMap first, second;
+    first.findOrInsert("a") = Object{{INT}, 1};
+    first.findOrInsert("b") = Object{{INT}, 2};
+    second.findOrInsert("b") = Object{{INT}, 2};
+    REQUIRE_FALSE(first == second);
+    second.findOrInsert("a") = Object{{INT}, 1};
+    REQUIRE(first == second);
+    HashMap copy(first);
+    copy.findOrInsert("a") = Object{{INT}, 3};
+    REQUIRE_FALSE(first == copy);
+    REQUIRE(*first.find("a") == Object{{INT}, 1});
+}
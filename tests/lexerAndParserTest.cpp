@@ -10,18 +10,34 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
 #include <algorithm>
+#include <functional>
 
 namespace {
-Program getTree(const std::wstring &source)
+Program getTree(const std::wstring &source, Parser::BodyMode bodyMode = Parser::BodyMode::PARSE)
 {
     std::wstringstream sourceStream(source);
     StreamReader reader(sourceStream, L"<test>");
     Lexer lexer(reader);
     CommentDiscarder commentDiscarder(lexer);
-    Parser parser(commentDiscarder);
+    Parser parser(commentDiscarder, bodyMode);
     return parser.parseProgram();
 }
 
+std::string getSyntaxError(const std::function<void()> &parse)
+{
+    std::string message;
+    try
+    {
+        parse();
+    }
+    catch(const SyntaxError &error)
+    {
+        message = error.what();
+    }
+    REQUIRE_FALSE(message.empty());
+    return message;
+}
+
 void checkLexingAndParsing(
     const std::wstring &source, const std::set<std::wstring> &expectedStructs,
     const std::set<std::wstring> &expectedVariants, const std::set<std::wstring> &expectedFunctions
@@ -262,6 +278,26 @@ TEST_CASE("priority tests", "[Lexer+Parser]")
                           L"    `-UnaryMinusExpression <line: 1, col: 27>\n"
                           L"     `-Literal <line: 1, col: 28> type=str value=-3\n"
     );
+    doPriorityTest(
+        L"a < b - c == not d or e", L"FunctionDeclaration <line: 1, col: 1> source=<test>\n"
+                                    L"`-Body:\n"
+                                    L" `-FunctionCallInstruction <line: 1, col: 15>\n"
+                                    L"  `-FunctionCall <line: 1, col: 15> functionName=print\n"
+                                    L"   `-OrExpression <line: 1, col: 21>\n"
+                                    L"    |-EqualExpression <line: 1, col: 21>\n"
+                                    L"    ||-LesserExpression <line: 1, col: 21>\n"
+                                    L"    |||-Variable <line: 1, col: 21> name=a\n"
+                                    L"    ||`-MinusExpression <line: 1, col: 25>\n"
+                                    L"    || |-Variable <line: 1, col: 25> name=b\n"
+                                    L"    || `-Variable <line: 1, col: 29> name=c\n"
+                                    L"    |`-NotExpression <line: 1, col: 34>\n"
+                                    L"    | `-Variable <line: 1, col: 38> name=d\n"
+                                    L"    `-Variable <line: 1, col: 43> name=e\n"
+    );
+    // a non-associative operator may not follow an operator of lower precedence applied after it
+    REQUIRE_THROWS_AS(getTree(L"func main() { print(x == a < b < c); }"), SyntaxError);
+    REQUIRE_THROWS_AS(getTree(L"func main() { print(a < b == c == d); }"), SyntaxError);
+    REQUIRE_THROWS_AS(getTree(L"func main() { print(a + b < c * d >= e); }"), SyntaxError);
 }
 
 TEST_CASE("factorial example", "[Lexer+Parser]")
@@ -342,3 +378,54 @@ TEST_CASE("typical errors", "[Lexer+Parser]")
              L"}\n";
     REQUIRE_THROWS_AS(getTree(source), SyntaxError); // no semicolon
 }
+
+TEST_CASE("skipped function bodies", "[Lexer+Parser]")
+{
+    std::wstring source = L"struct S {int a; int b;}\n"
+                          L"func f(int v) -> S {\n"
+                          L"    if(v > 0) {\n"
+                          L"        return {v, 1};\n"
+                          L"    }\n"
+                          L"    return {0, 0}; # }\n"
+                          L"}\n"
+                          L"func main() { print(\"}\"); }\n";
+    Program skipped = getTree(source, Parser::BodyMode::SKIP);
+    for(auto &[id, function]: skipped.functions)
+        REQUIRE_FALSE(dynamic_cast<FunctionDeclaration &>(*function).isBodyParsed());
+    std::set<std::wstring> expectedFunctions;
+    for(auto &function: getTree(source).functions)
+    {
+        std::wstringstream printed;
+        PrintingVisitor(printed).visit(function);
+        expectedFunctions.insert(printed.str());
+    }
+    checkNodeContainer(skipped.functions, expectedFunctions);
+    for(auto &[id, function]: skipped.functions)
+        REQUIRE(dynamic_cast<FunctionDeclaration &>(*function).isBodyParsed());
+
+    // errors inside the body are reported when it is parsed, the same as if it was parsed in place
+    source = L"func f() {\n"
+             L"    int a = 4\n"
+             L"    print(a);\n"
+             L"}\n"
+             L"func main() {}\n";
+    skipped = getTree(source, Parser::BodyMode::SKIP);
+    auto &function = dynamic_cast<FunctionDeclaration &>(*skipped.functions.at(FunctionIdentification(L"f", {})));
+    REQUIRE(getSyntaxError([&] { function.getBody(); }) == getSyntaxError([&] { getTree(source); }));
+    source = L"func f() {\n"
+             L"    return 1;\n"
+             L"}}\n";
+    REQUIRE(
+        getSyntaxError([&] { getTree(source, Parser::BodyMode::SKIP); }) == getSyntaxError([&] { getTree(source); })
+    );
+
+    // the end of the body is found when it is skipped
+    source = L"func f() {\n"
+             L"    if(true) {\n"
+             L"        print(\"message\");\n"
+             L"    }\n";
+    REQUIRE(
+        getSyntaxError([&] { getTree(source, Parser::BodyMode::SKIP); }) == getSyntaxError([&] { getTree(source); })
+    );
+    REQUIRE_THROWS_AS(getTree(L"func f() print(1);", Parser::BodyMode::SKIP), SyntaxError);
+}
@@ -28,8 +28,8 @@ Program getTree(const std::wstring &source)
              std::vector<VariableDeclaration>{VariableDeclaration{{0, 0}, {Type::Builtin::STR}, L"value", false}},
              std::nullopt,
              BuiltinFunctionDeclaration::Body(
-                 [](Position, const std::wstring &,
-                    const std::vector<std::variant<Object, std::reference_wrapper<Object>>> &) { return std::nullopt; }
+                 [](Position, const std::wstring &, std::vector<std::variant<Object, std::reference_wrapper<Object>>> &,
+                    ExecutionEnvironment &) { return std::nullopt; }
              )
          )}
     );
@@ -52,6 +52,25 @@ void checkProcessing(
                                      L" `-VariableDeclaration <line: 0, col: 0> type=str name=value mutable=false\n");
     checkNodeContainer(tree.functions, functionWithDummyBuiltins);
 }
+
+// Returns the counted loop recognized in the first while loop in the function from the source.
+std::optional<CountedLoop> getCountedLoop(const std::wstring &source, const FunctionIdentification &functionId)
+{
+    Program tree = getTree(source);
+    auto &function = dynamic_cast<FunctionDeclaration &>(*tree.functions.at(functionId));
+    for(auto &instruction: function.getBody())
+    {
+        if(auto loop = dynamic_cast<WhileStatement *>(instruction.get()))
+            return loop->countedLoop;
+    }
+    throw std::runtime_error("No while loop in the function");
+}
+
+// Returns the counted loop recognized in the first while loop in the main function with the given body.
+std::optional<CountedLoop> getCountedLoop(const std::wstring &mainBody, const std::wstring &otherDeclarations = L"")
+{
+    return getCountedLoop(otherDeclarations + wrapInMain(mainBody), FunctionIdentification(L"main", {}));
+}
 }
 
 TEST_CASE("variable declarations", "[Lexer+Parser+SemanticAnalyzer]")
@@ -762,3 +781,159 @@ TEST_CASE("variable visibility", "[Lexer+Parser+SemanticAnalyzer]")
              L"}\n";
     REQUIRE_THROWS(getTree(source));
 }
+
+TEST_CASE("counted loops", "[Lexer+Parser+SemanticAnalyzer]")
+{
+    auto loop = getCountedLoop(L"int$ i = 0;\n"
+                               L"while(i < 10) {\n"
+                               L"    print(i);\n"
+                               L"    i = i + 1;\n"
+                               L"}\n");
+    REQUIRE(loop);
+    REQUIRE(loop->counter == L"i");
+    REQUIRE(loop->bound == std::variant<int32_t, std::wstring>(10));
+    REQUIRE_FALSE(loop->isInclusive);
+    REQUIRE(loop->step == 1);
+
+    loop = getCountedLoop(L"int n = 10;\n"
+                          L"int$ i = 0;\n"
+                          L"while(i <= n) {\n"
+                          L"    i = i + 2;\n"
+                          L"}\n");
+    REQUIRE(loop);
+    REQUIRE(loop->bound == std::variant<int32_t, std::wstring>(L"n"));
+    REQUIRE(loop->isInclusive);
+    REQUIRE(loop->step == 2);
+
+    // the nested loop modifies the counter of the outer one only through its own variable
+    loop = getCountedLoop(L"int$ i = 0;\n"
+                          L"while(i < 10) {\n"
+                          L"    int$ j = 0;\n"
+                          L"    while(j < i) {\n"
+                          L"        j = j + 1;\n"
+                          L"    }\n"
+                          L"    i = i + 1;\n"
+                          L"}\n");
+    REQUIRE(loop);
+
+    // other modifications of the counter or the bound
+    REQUIRE_FALSE(getCountedLoop(L"int$ i = 0;\n"
+                                 L"while(i < 10) {\n"
+                                 L"    i = i * 2;\n"
+                                 L"    i = i + 1;\n"
+                                 L"}\n"));
+    REQUIRE_FALSE(getCountedLoop(L"int$ i = 0;\n"
+                                 L"int$ n = 10;\n"
+                                 L"while(i < n) {\n"
+                                 L"    n = n - 1;\n"
+                                 L"    i = i + 1;\n"
+                                 L"}\n"));
+    REQUIRE_FALSE(getCountedLoop(
+        L"int$ i = 0;\n"
+        L"while(i < 10) {\n"
+        L"    reset(i);\n"
+        L"    i = i + 1;\n"
+        L"}\n",
+        L"func reset(int$ value) {\n"
+        L"    value = 0;\n"
+        L"}\n"
+    ));
+    REQUIRE_FALSE(getCountedLoop(L"int$ i = 0;\n"
+                                 L"while(i < 10) {\n"
+                                 L"    if(i > 5) {\n"
+                                 L"        i = i + 2;\n"
+                                 L"    }\n"
+                                 L"    i = i + 1;\n"
+                                 L"}\n"));
+    // parameters may be modified through other parameters referring to the same variable
+    REQUIRE_FALSE(getCountedLoop(
+        L"func loop(int n) {\n"
+        L"    int$ i = 0;\n"
+        L"    while(i < n) {\n"
+        L"        i = i + 1;\n"
+        L"    }\n"
+        L"}\n",
+        FunctionIdentification(L"loop", {{Type::Builtin::INT}})
+    ));
+    REQUIRE_FALSE(getCountedLoop(
+        L"func loop(int$ i) {\n"
+        L"    while(i < 10) {\n"
+        L"        i = i + 1;\n"
+        L"    }\n"
+        L"}\n",
+        FunctionIdentification(L"loop", {{Type::Builtin::INT}})
+    ));
+    // loops of other forms
+    REQUIRE_FALSE(getCountedLoop(L"int$ i = 0;\n"
+                                 L"while(i > -10) {\n"
+                                 L"    i = i + 1;\n"
+                                 L"}\n"));
+    REQUIRE_FALSE(getCountedLoop(L"int$ i = 0;\n"
+                                 L"while(i < 10) {\n"
+                                 L"    i = i + -1;\n"
+                                 L"}\n"));
+    REQUIRE_FALSE(getCountedLoop(L"int$ i = 0;\n"
+                                 L"while(i < 10) {\n"
+                                 L"    i = 1 + i;\n"
+                                 L"}\n"));
+    REQUIRE_FALSE(getCountedLoop(L"int$ i = 0;\n"
+                                 L"while(i < 10.5) {\n"
+                                 L"    i = i + 1;\n"
+                                 L"}\n"));
+    REQUIRE_FALSE(getCountedLoop(L"float$ i = 0.0;\n"
+                                 L"while(i < 10.0) {\n"
+                                 L"    i = i + 1.0;\n"
+                                 L"}\n"));
+}
+
+TEST_CASE("arrays", "[Lexer+Parser+SemanticAnalyzer]")
+{
+    std::wstring source = L"func main() {\n"
+                          L"    [[float]]$ a = {{1, 2.5}, {}};\n"
+                          L"    append(a[1], 3);\n"
+                          L"    a[0][1] = a[1][0];\n"
+                          L"}\n";
+    checkProcessing(
+        source, {}, {},
+        {L"main: FunctionDeclaration <line: 1, col: 1> source=<test>\n"
+         L"`-Body:\n"
+         L" |-VariableDeclStatement <line: 2, col: 5>\n"
+         L" ||-VariableDeclaration <line: 2, col: 5> type=[[float]] name=a mutable=true\n"
+         L" |`-StructExpression <line: 2, col: 20> collectionType=[[float]]\n"
+         L" | |-StructExpression <line: 2, col: 21> collectionType=[float]\n"
+         L" | ||-CastExpression <line: 2, col: 22> targetType=float\n"
+         L" | ||`-Literal <line: 2, col: 22> type=int value=1\n"
+         L" | |`-Literal <line: 2, col: 25> type=float value=2.5\n"
+         L" | `-StructExpression <line: 2, col: 31> collectionType=[float]\n"
+         L" |-FunctionCallInstruction <line: 3, col: 5>\n"
+         L" |`-FunctionCall <line: 3, col: 5> functionName=append\n"
+         L" | |-SubscriptExpression <line: 3, col: 12>\n"
+         L" | ||-Variable <line: 3, col: 12> name=a\n"
+         L" | |`-Literal <line: 3, col: 14> type=int value=1\n"
+         L" | `-CastExpression <line: 3, col: 18> targetType=float\n"
+         L" |  `-Literal <line: 3, col: 18> type=int value=3\n"
+         L" `-AssignmentStatement <line: 4, col: 5>\n"
+         L"  |-Assignable <line: 4, col: 5>\n"
+         L"  ||-Assignable <line: 4, col: 5>\n"
+         L"  |||-Assignable <line: 4, col: 5> right=a\n"
+         L"  ||`-Literal <line: 4, col: 7> type=int value=0\n"
+         L"  |`-Literal <line: 4, col: 10> type=int value=1\n"
+         L"  `-SubscriptExpression <line: 4, col: 15>\n"
+         L"   |-SubscriptExpression <line: 4, col: 15>\n"
+         L"   ||-Variable <line: 4, col: 15> name=a\n"
+         L"   |`-Literal <line: 4, col: 17> type=int value=1\n"
+         L"   `-Literal <line: 4, col: 20> type=int value=0\n",
+         L"append([float], float): BuiltinFunctionDeclaration <line: 0, col: 0> source=<builtins>\n"
+         L"`-Parameters:\n"
+         L" |-VariableDeclaration <line: 0, col: 0> type=[float] name=array mutable=true\n"
+         L" `-VariableDeclaration <line: 0, col: 0> type=float name=element mutable=false\n"}
+    );
+
+    REQUIRE_THROWS(getTree(wrapInMain(L"[Unknown] a = {};")));
+    REQUIRE_THROWS(getTree(wrapInMain(L"[int] a = {};\nint b = a.field;")));
+    REQUIRE_THROWS(getTree(wrapInMain(L"int$ a = 1;\na[0] = 2;")));
+    REQUIRE_THROWS(getTree(wrapInMain(L"[int]$ a = {};\na[{1}] = 2;")));
+    REQUIRE_THROWS(getTree(wrapInMain(L"[int] a = {};\n[float] b = a;")));
+    // arrays can be empty, so a structure may contain an array of itself
+    REQUIRE_NOTHROW(getTree(L"struct Node {int value; [Node] children;}\n"));
+}
@@ -66,6 +66,7 @@ TEST_CASE("keywords tokens", "[Lexer]")
     checkToken(L"else", KW_ELSE);
     checkToken(L"while", KW_WHILE);
     checkToken(L"do", KW_DO);
+    checkToken(L"spawn", KW_SPAWN);
     checkToken(L"is", KW_IS);
     checkToken(L"or", KW_OR);
     checkToken(L"xor", KW_XOR);
@@ -75,6 +76,7 @@ TEST_CASE("keywords tokens", "[Lexer]")
     checkToken(L"float", KW_FLOAT);
     checkToken(L"bool", KW_BOOL);
     checkToken(L"str", KW_STR);
+    checkToken(L"task", KW_TASK);
 }
 
 TEST_CASE("bool literal tokens", "[Lexer]")
@@ -131,6 +133,23 @@ TEST_CASE("comments", "[Lexer]")
     checkTokenError<CommentTooLongError>(L"#A" + longString);
 }
 
+TEST_CASE("comments skipped", "[Lexer]")
+{
+    std::wstring longString(Lexer::MAX_COMMENT_SIZE, L'a');
+    std::wstringstream input(L"# first\n  #second\r\n\tfirst # third\n#" + longString + L"\n# ść\nsecond#");
+    StreamReader reader(input, L"<test>");
+    Lexer lexer(reader, Lexer::CommentMode::SKIP);
+    REQUIRE(lexer.getNextToken() == Token(IDENTIFIER, {3, 2}, L"first"));
+    REQUIRE(lexer.getNextToken() == Token(IDENTIFIER, {6, 1}, L"second"));
+    REQUIRE(lexer.getNextToken() == Token(EOT, {6, 8}));
+
+    std::wstringstream tooLong(L"a\n#A" + longString + L"\nb");
+    StreamReader tooLongReader(tooLong, L"<test>");
+    Lexer tooLongLexer(tooLongReader, Lexer::CommentMode::SKIP);
+    tooLongLexer.getNextToken();
+    REQUIRE_THROWS_AS(tooLongLexer.getNextToken(), CommentTooLongError);
+}
+
 TEST_CASE("strings", "[Lexer]")
 {
     checkToken(L"\"\"", STR_LITERAL, L"");
@@ -12,7 +12,7 @@
 namespace {
 std::wstring interpret(
     const std::wstring &sourceCode, const std::vector<std::wstring> &arguments = {},
-    const std::wstring &standardInput = L""
+    const std::wstring &standardInput = L"", ExecutionLimits limits = {}
 )
 {
     std::wstringstream sourceStream(sourceCode);
@@ -23,9 +23,11 @@ std::wstring interpret(
     Program program = parser.parseProgram();
     std::wstringstream inputStream(standardInput), outputStream;
     std::vector<std::wstring> sourceFiles = {L"<test>"};
-    Interpreter interpreter(sourceFiles, arguments, inputStream, outputStream, [](const std::wstring &) -> Program {
-        throw std::runtime_error("No files should be included in these tests");
-    });
+    Interpreter interpreter(
+        sourceFiles, arguments, inputStream, outputStream,
+        [](const std::wstring &) -> Program { throw std::runtime_error("No files should be included in these tests"); },
+        Interpreter::DEFAULT_MAX_STACK_SIZE, nullptr, nullptr, nullptr, limits
+    );
     interpreter.visit(program);
     return outputStream.str();
 }
@@ -162,6 +164,16 @@ TEST_CASE("variants", "[Lexer+Parser+Interpreter]")
                   L"    a = true;         print(a is bool);\n"
                   L"}") == L"2\nstring\ntrue\ntrue"
     );
+    REQUIRE(
+        interpret(L"struct Struct {str a; int b;}\n"
+                  L"variant Variant {Struct a; int b;}\n"
+                  L"func main() {\n"
+                  L"    Struct s = {\"text\", 1};\n"
+                  L"    Variant a = s;\n"
+                  L"    if(Struct first = a) {print(first.a);}\n"
+                  L"    if(Struct second = a) {print(second.a ! second.b);}\n"
+                  L"}") == L"texttext1"
+    );
     REQUIRE_THROWS_AS(
         interpret(L"variant Variant {int a; str b; bool c;}\n"
                   L"func main() {\n"
@@ -464,6 +476,395 @@ TEST_CASE("loops", "[Lexer+Parser+Interpreter]")
     REQUIRE_THROWS_AS(interpret(wrapInMain(L"break;\n")), InvalidBreakError);
 }
 
+TEST_CASE("counted loops", "[Lexer+Parser+Interpreter]")
+{
+    REQUIRE(
+        interpret(wrapInMain(L"int n = 5;\n"
+                             L"int$ i = 0;\n"
+                             L"while(i <= n) {\n"
+                             L"    int square = i * i;\n"
+                             L"    print(square ! \" \");\n"
+                             L"    i = i + 1;\n"
+                             L"}\n"
+                             L"print(i);\n")) == L"0 1 4 9 16 25 6"
+    );
+    REQUIRE(
+        interpret(wrapInMain(L"int$ i = 0;\n"
+                             L"int$ skipped = 0;\n"
+                             L"while(i < 20) {\n"
+                             L"    if(i == 7 and skipped < 3) {\n"
+                             L"        skipped = skipped + 1;\n"
+                             L"        continue;\n"
+                             L"    }\n"
+                             L"    if(i == 12) {\n"
+                             L"        break;\n"
+                             L"    }\n"
+                             L"    print(i ! \",\");\n"
+                             L"    i = i + 3;\n"
+                             L"}\n"
+                             L"print(i ! \" \" ! skipped);\n")) == L"0,3,6,9,12 0"
+    );
+    REQUIRE(
+        interpret(L"func find(int n) -> int {\n"
+                  L"    int$ i = 0;\n"
+                  L"    while(i < 100) {\n"
+                  L"        if(i * i >= n) {\n"
+                  L"            return i;\n"
+                  L"        }\n"
+                  L"        i = i + 1;\n"
+                  L"    }\n"
+                  L"    return -1;\n"
+                  L"}\n" +
+                  wrapInMain(L"print(find(50) ! \" \" ! find(100000));\n")) == L"8 -1"
+    );
+    REQUIRE(
+        interpret(wrapInMain(L"int$ i = 2147483640;\n"
+                             L"while(i < 2147483642) {\n"
+                             L"    i = i + 5;\n"
+                             L"}\n"
+                             L"print(i);\n")) == L"2147483645"
+    );
+    // a loop whose increment may overflow is executed as any other one
+    REQUIRE_THROWS_AS(
+        interpret(wrapInMain(L"int$ i = 2147483640;\n"
+                             L"while(i <= 2147483647) {\n"
+                             L"    i = i + 1;\n"
+                             L"}\n")),
+        IntegerRangeError
+    );
+    // the bound is modified through another parameter referring to the same variable
+    REQUIRE(
+        interpret(L"func bump(int$ value) {\n"
+                  L"    if(value < 300) {\n"
+                  L"        value = value + 100;\n"
+                  L"    }\n"
+                  L"}\n"
+                  L"func loop(int$ n, int$ m) {\n"
+                  L"    int$ i = 0;\n"
+                  L"    while(i < n) {\n"
+                  L"        bump(m);\n"
+                  L"        i = i + 1;\n"
+                  L"    }\n"
+                  L"    print(i);\n"
+                  L"}\n" +
+                  wrapInMain(L"int$ a = 5;\n"
+                             L"loop(a, a);\n")) == L"305"
+    );
+}
+
+TEST_CASE("arrays", "[Lexer+Parser+Interpreter]")
+{
+    REQUIRE(
+        interpret(wrapInMain(L"[int]$ a = {};\n"
+                             L"int$ i = 0;\n"
+                             L"while(i < 5) {\n"
+                             L"    append(a, i * i);\n"
+                             L"    i = i + 1;\n"
+                             L"}\n"
+                             L"a[1] = a[4] + a[3];\n"
+                             L"i = 0;\n"
+                             L"while(i < len(a)) {\n"
+                             L"    print(a[i] ! \" \");\n"
+                             L"    i = i + 1;\n"
+                             L"}\n")) == L"0 25 4 9 16 "
+    );
+    REQUIRE(
+        interpret(wrapInMain(L"[float] a = {1, 2.5};\n"
+                             L"[[str]]$ grid = {{\"a\"}, {}};\n"
+                             L"append(grid[1], \"b\");\n"
+                             L"append(grid, grid[0]);\n"
+                             L"grid[0][0] = \"c\";\n"
+                             L"print(a[0] + a[1] ! grid[0][0] ! grid[1][0] ! grid[2][0] ! len(grid));\n")) == L"3.5cba3"
+    );
+    REQUIRE(
+        interpret(L"struct Node {int value; [Node] children;}\n"
+                  L"func sum(Node node) -> int {\n"
+                  L"    int$ result = node.value;\n"
+                  L"    int$ i = 0;\n"
+                  L"    while(i < len(node.children)) {\n"
+                  L"        result = result + sum(node.children[i]);\n"
+                  L"        i = i + 1;\n"
+                  L"    }\n"
+                  L"    return result;\n"
+                  L"}\n"
+                  L"func main() {\n"
+                  L"    Node$ tree = {1, {{2, {}}, {3, {{4, {}}}}}};\n"
+                  L"    append(tree.children, {5, {}});\n"
+                  L"    tree.children[0].value = 10;\n"
+                  L"    print(sum(tree));\n"
+                  L"}\n") == L"23"
+    );
+    // the elements read from an array are passed by value, so appending to the array does not invalidate them
+    REQUIRE(
+        interpret(L"func append_twice([int]$ a, int value) {\n"
+                  L"    int$ i = 0;\n"
+                  L"    while(i < 100) {\n"
+                  L"        append(a, value);\n"
+                  L"        i = i + 1;\n"
+                  L"    }\n"
+                  L"}\n"
+                  L"func main() {\n"
+                  L"    [int]$ a = {7};\n"
+                  L"    append_twice(a, a[0]);\n"
+                  L"    a[0] = len(a) + a[100];\n"
+                  L"    print(a[0]);\n"
+                  L"}\n") == L"108"
+    );
+    REQUIRE_THROWS_AS(
+        interpret(L"func f([int]$ a, int$ element) {}\n" + wrapInMain(L"[int]$ a = {1};\nf(a, a[0]);")),
+        AliasedArgumentsError
+    );
+    // an element of a parameter is passed as a copy, assigned back after the call, as the parameter may refer to the
+    // same array as another argument
+    std::wstring appendingFunction = L"func f([int]$ a, int$ element) {\n"
+                                     L"    int$ i = 0;\n"
+                                     L"    while(i < 1000) {\n"
+                                     L"        append(a, i);\n"
+                                     L"        i = i + 1;\n"
+                                     L"    }\n"
+                                     L"    element = 777;\n"
+                                     L"}\n"
+                                     L"func g([int]$ x, [int]$ y) {\n"
+                                     L"    f(x, y[0]);\n"
+                                     L"}\n";
+    REQUIRE(
+        interpret(appendingFunction + wrapInMain(L"[int]$ a = {1};\n"
+                                                 L"g(a, a);\n"
+                                                 L"print(a[0] ! \" \" ! len(a));\n")) == L"777 1001"
+    );
+    REQUIRE_THROWS_AS(
+        interpret(L"func f([int]$ a, int$ element) {\n"
+                  L"    a = {};\n"
+                  L"    element = 1;\n"
+                  L"}\n"
+                  L"func g([int]$ x, [int]$ y) {\n"
+                  L"    f(x, y[0]);\n"
+                  L"}\n" +
+                  wrapInMain(L"[int]$ a = {1};\ng(a, a);")),
+        OperatorArgumentError
+    );
+    // so is a field passed together with its structure
+    REQUIRE(
+        interpret(L"struct S {int a; int b;}\n"
+                  L"func f(S$ s, int$ field) {\n"
+                  L"    s = {5, 6};\n"
+                  L"    field = 7;\n"
+                  L"}\n" +
+                  wrapInMain(L"S$ s = {1, 2};\n"
+                             L"f(s, s.a);\n"
+                             L"print(s.a ! s.b);\n")) == L"76"
+    );
+    // an existing array is implicitly converted to a variant which has it as an alternative and initializes a field
+    REQUIRE(
+        interpret(L"variant V {[int] a; str b;}\n"
+                  L"struct S {[int] xs; V v;}\n"
+                  L"func size(V v) -> int {\n"
+                  L"    if([int] a = v) {\n"
+                  L"        return len(a);\n"
+                  L"    }\n"
+                  L"    return -1;\n"
+                  L"}\n" +
+                  wrapInMain(L"[int] a = {1, 2, 3};\n"
+                             L"V v = a;\n"
+                             L"S s = {a, v};\n"
+                             L"print(size(v) ! size(a) ! size(\"x\") ! len(s.xs) ! size(s.v));\n")) == L"33-133"
+    );
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"[int] a = {1, 2};\nint b = a[2];")), OperatorArgumentError);
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"[int]$ a = {1, 2};\na[-1] = 3;")), OperatorArgumentError);
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"[int] a = {1, 2};\na[0] = 3;")), ImmutableError);
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"[int]$ a = {1, 2};\nappend(a, {1});")), InvalidFunctionCallError);
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"[int] a = {1, {2}};")), InvalidCastError);
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"[int] a = {1};\n[float] b = a;")), InvalidCastError);
+}
+
+TEST_CASE("string builtins", "[Lexer+Parser+Interpreter]")
+{
+    REQUIRE(
+        interpret(wrapInMain(L"[str] fields = split(\"  name = value ; other=1 \", \";\");\n"
+                             L"int$ i = 0;\n"
+                             L"while(i < len(fields)) {\n"
+                             L"    str field = trim(fields[i]);\n"
+                             L"    int separator = find(field, \"=\");\n"
+                             L"    str key = trim(substr(field, 0, separator));\n"
+                             L"    str value = trim(substr(field, separator + 1, len(field)));\n"
+                             L"    print(\"[\" ! key ! \"|\" ! value ! \"]\");\n"
+                             L"    i = i + 1;\n"
+                             L"}\n"
+                             L"print(starts_with(fields[1], \" other\") ! find(fields[0], \"missing\"));\n")) ==
+        L"[name|value][other|1]true-1"
+    );
+    REQUIRE(
+        interpret(wrapInMain(L"str s = \"zażółć\";\n"
+                             L"print(len(s) ! s[3] ! substr(s, 2, 3) ! find(s, \"ł\") ! (s ! \"€\")[6]);\n")) ==
+        L"6óżół4€"
+    );
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"str a = substr(\"abc\", 4, 1);")), BuiltinFunctionArgumentError);
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"[str] a = split(\"abc\", \"\");")), BuiltinFunctionArgumentError);
+}
+
+TEST_CASE("dictionaries", "[Lexer+Parser+Interpreter]")
+{
+    REQUIRE(
+        interpret(wrapInMain(L"[str -> int]$ counts = {};\n"
+                             L"[str] words = {\"a\", \"b\", \"a\", \"c\", \"a\", \"b\"};\n"
+                             L"int$ i = 0;\n"
+                             L"while(i < len(words)) {\n"
+                             L"    if(contains(counts, words[i])) {\n"
+                             L"        counts[words[i]] = counts[words[i]] + 1;\n"
+                             L"    }\n"
+                             L"    else {\n"
+                             L"        counts[words[i]] = 1;\n"
+                             L"    }\n"
+                             L"    i = i + 1;\n"
+                             L"}\n"
+                             L"bool removed = remove(counts, \"c\");\n"
+                             L"print(counts[\"a\"] ! counts[\"b\"] ! len(counts) ! removed);\n"
+                             L"print(contains(counts, \"c\"));\n")) == L"322truefalse"
+    );
+    REQUIRE(
+        interpret(wrapInMain(L"[int -> [int]]$ groups = {{1, {10}}, {2, {}}};\n"
+                             L"append(groups[2], 20);\n"
+                             L"groups[1][0] = 11;\n"
+                             L"[int] keys = keys(groups);\n"
+                             L"print(groups[1][0] + groups[2][0] ! len(keys));\n"
+                             L"print(groups == {{2, {20}}, {1, {11}}});\n")) == L"312true"
+    );
+    // removals shift the following entries back, so the lookups of the remaining keys have to stay valid
+    REQUIRE(
+        interpret(wrapInMain(L"[int -> int]$ squares = {};\n"
+                             L"int$ i = 0;\n"
+                             L"while(i < 1000) {\n"
+                             L"    squares[i] = i * i;\n"
+                             L"    i = i + 1;\n"
+                             L"}\n"
+                             L"i = 0;\n"
+                             L"while(i < 1000) {\n"
+                             L"    bool removed = remove(squares, i);\n"
+                             L"    i = i + 3;\n"
+                             L"}\n"
+                             L"int$ sum = 0;\n"
+                             L"i = 0;\n"
+                             L"while(i < 1000) {\n"
+                             L"    if(contains(squares, i)) {\n"
+                             L"        sum = sum + squares[i];\n"
+                             L"    }\n"
+                             L"    i = i + 1;\n"
+                             L"}\n"
+                             L"print(len(squares) ! \" \" ! sum);\n")) == L"666 221555889"
+    );
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"[int -> int] a = {{1, 2}};\nint b = a[2];")), OperatorArgumentError);
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"[int -> [int]]$ a = {};\na[1][0] = 2;")), OperatorArgumentError);
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"[int -> int] a = {{1, 2}};\na[1] = 3;")), ImmutableError);
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"[float -> int] a = {};")), UnknownVariableTypeError);
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"[int -> int] a = {{1, 2, 3}};")), InvalidCastError);
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"[int -> int] a = {1};")), InvalidCastError);
+    REQUIRE_THROWS_AS(
+        interpret(
+            L"func f([int -> int]$ a, int$ value) {}\n" + wrapInMain(L"[int -> int]$ a = {{1, 2}};\nf(a, a[1]);")
+        ),
+        AliasedArgumentsError
+    );
+    // a value of a parameter is assigned back after the call, even if the table has grown or the key was removed
+    REQUIRE(
+        interpret(L"func f([str -> int]$ d, int$ value) {\n"
+                  L"    int$ i = 0;\n"
+                  L"    while(i < 100) {\n"
+                  L"        d[i ! \"\"] = i;\n"
+                  L"        i = i + 1;\n"
+                  L"    }\n"
+                  L"    value = 777;\n"
+                  L"}\n"
+                  L"func g([str -> int]$ x, [str -> int]$ y) {\n"
+                  L"    f(x, y[\"key\"]);\n"
+                  L"}\n" +
+                  wrapInMain(L"[str -> int]$ d = {{\"key\", 1}};\n"
+                             L"g(d, d);\n"
+                             L"print(d[\"key\"] ! \" \" ! len(d));\n")) == L"777 101"
+    );
+    REQUIRE(
+        interpret(L"func f([str -> int]$ d, int$ value) {\n"
+                  L"    remove(d, \"key\");\n"
+                  L"    value = 5;\n"
+                  L"}\n"
+                  L"func g([str -> int]$ x, [str -> int]$ y) {\n"
+                  L"    f(x, y[\"key\"]);\n"
+                  L"}\n" +
+                  wrapInMain(L"[str -> int]$ d = {{\"key\", 1}};\n"
+                             L"g(d, d);\n"
+                             L"print(d[\"key\"]);\n")) == L"5"
+    );
+    REQUIRE(
+        interpret(L"variant V {[str -> int] counts; int count;}\n"
+                  L"func total(V v) -> int {\n"
+                  L"    if([str -> int] counts = v) {\n"
+                  L"        return counts[\"a\"] + counts[\"b\"];\n"
+                  L"    }\n"
+                  L"    return 0;\n"
+                  L"}\n" +
+                  wrapInMain(L"[str -> int] d = {{\"a\", 1}, {\"b\", 2}};\n"
+                             L"V v = d;\n"
+                             L"print(total(v) ! total(d));\n")) == L"33"
+    );
+}
+
+TEST_CASE("execution limits", "[Lexer+Parser+Interpreter]")
+{
+    ExecutionLimits instructionLimit = {1000, std::nullopt, std::nullopt};
+    std::wstring counting = wrapInMain(L"int$ a = 0;\n"
+                                       L"while(a < 100) {\n"
+                                       L"    a = a + 1;\n"
+                                       L"}\n"
+                                       L"print(a);\n");
+    REQUIRE(interpret(counting, {}, L"", instructionLimit) == L"100");
+    REQUIRE_THROWS_AS(
+        interpret(counting, {}, L"", {150, std::nullopt, std::nullopt}), ExecutionLimitError
+    );
+    // iterations of loops are counted even when their bodies are empty
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"while(true) {}\n"), {}, L"", instructionLimit), ExecutionLimitError);
+    REQUIRE_THROWS_AS(
+        interpret(wrapInMain(L"do {} while(true)\n"), {}, L"", instructionLimit), ExecutionLimitError
+    );
+    std::wstring countingTask = L"func count(int n) -> int {\n"
+                                L"    int$ a = 0;\n"
+                                L"    while(a < n) {\n"
+                                L"        a = a + 1;\n"
+                                L"    }\n"
+                                L"    return a;\n"
+                                L"}\n";
+    REQUIRE(
+        interpret(countingTask + wrapInMain(L"print(join(spawn count(100)));\n"), {}, L"", instructionLimit) == L"100"
+    );
+    // the spawned tasks share the budget of the execution, so together they exceed the limit
+    REQUIRE_THROWS_AS(
+        interpret(
+            countingTask + wrapInMain(L"[task<int>]$ tasks = {};\n"
+                                      L"while(len(tasks) < 8) {\n"
+                                      L"    append(tasks, spawn count(100));\n"
+                                      L"}\n"),
+            {}, L"", instructionLimit
+        ),
+        ExecutionLimitError
+    );
+
+    ExecutionLimits timeLimit = {std::nullopt, std::chrono::milliseconds(20), std::nullopt};
+    REQUIRE(interpret(counting, {}, L"", timeLimit) == L"100");
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"while(true) {}\n"), {}, L"", timeLimit), ExecutionLimitError);
+
+    ExecutionLimits heapLimit = {std::nullopt, std::nullopt, 1 << 20};
+    REQUIRE(interpret(wrapInMain(L"print(len(\"ab\" @ 1000));\n"), {}, L"", heapLimit) == L"2000");
+    REQUIRE_THROWS_AS(
+        interpret(
+            wrapInMain(L"str$ a = \"a\";\n"
+                       L"while(true) {\n"
+                       L"    a = a ! a;\n"
+                       L"}\n"),
+            {}, L"", heapLimit
+        ),
+        ExecutionLimitError
+    );
+    REQUIRE_THROWS_AS(interpret(wrapInMain(L"str a = \"ab\" @ 1000000;\n"), {}, L"", heapLimit), ExecutionLimitError);
+}
+
 TEST_CASE("functions", "[Lexer+Parser+Interpreter]")
 {
     REQUIRE_THROWS_AS(interpret(L"func funkcja(int a, str b) {return true;}"), InvalidReturnError);
@@ -508,6 +909,20 @@ TEST_CASE("functions", "[Lexer+Parser+Interpreter]")
                   L"    int b = factorial(4); println(b);\n"
                   L"}\n") == L"6\n24\n"
     );
+    REQUIRE(
+        interpret(L"func identity(int n) -> int {\n"
+                  L"    return n;\n"
+                  L"}\n"
+                  L"func local(int n) -> int {\n"
+                  L"    int$ result = n;\n"
+                  L"    result = result * 2;\n"
+                  L"    return result;\n"
+                  L"}\n"
+                  L"\n"
+                  L"func main() {\n"
+                  L"    println(identity(1) + local(2) + identity(3));\n"
+                  L"}\n") == L"8\n"
+    );
     REQUIRE_THROWS_AS(
         interpret(L"func factorial(int n) -> int {\n"
                   L"    return n * factorial(n - 1);\n"
@@ -569,6 +984,99 @@ TEST_CASE("variable visibility", "[Lexer+Parser+Interpreter]")
     );
 }
 
+TEST_CASE("spawned tasks", "[Lexer+Parser+Interpreter]")
+{
+    std::wstring fibonacci = L"func fib(int n) -> int {\n"
+                             L"    if(n < 2) {\n"
+                             L"        return n;\n"
+                             L"    }\n"
+                             L"    return fib(n - 1) + fib(n - 2);\n"
+                             L"}\n";
+    REQUIRE(
+        interpret(fibonacci + wrapInMain(L"[task<int>]$ tasks = {};\n"
+                                         L"int$ i = 0;\n"
+                                         L"while(i < 10) {\n"
+                                         L"    append(tasks, spawn fib(i + 10));\n"
+                                         L"    i = i + 1;\n"
+                                         L"}\n"
+                                         L"i = 0;\n"
+                                         L"while(i < len(tasks)) {\n"
+                                         L"    print(join(tasks[i]) ! \" \");\n"
+                                         L"    i = i + 1;\n"
+                                         L"}\n")) == L"55 89 144 233 377 610 987 1597 2584 4181 "
+    );
+    // the output of a task is written when it is joined, tasks which are not joined are joined when main ends
+    REQUIRE(
+        interpret(L"func label(str text) -> str {\n"
+                  L"    print(\"<\" ! text ! \">\");\n"
+                  L"    return text;\n"
+                  L"}\n" +
+                  wrapInMain(L"task<str> first = spawn label(\"first\");\n"
+                             L"task<str> second = spawn label(\"second\");\n"
+                             L"print(\"main \");\n"
+                             L"str result = join(first) ! join(first);\n"
+                             L"print(result);\n")) == L"main <first>firstfirst<second>"
+    );
+    REQUIRE(
+        interpret(fibonacci + L"func nested(int n) -> int {\n"
+                              L"    task<int> left = spawn fib(n - 1);\n"
+                              L"    task<int> right = spawn fib(n - 2);\n"
+                              L"    return join(left) + join(right);\n"
+                              L"}\n" +
+                  wrapInMain(L"print(join(spawn nested(20)));")) == L"6765"
+    );
+    REQUIRE_THROWS_AS(
+        interpret(L"func divide(int a) -> float {\n"
+                  L"    return 1 / a;\n"
+                  L"}\n" +
+                  wrapInMain(L"task<float> result = spawn divide(0);\n"
+                             L"float value = join(result);\n")),
+        ZeroDivisionError
+    );
+    REQUIRE_THROWS_AS(
+        interpret(L"func divide(int a) -> float {\n"
+                  L"    return 1 / a;\n"
+                  L"}\n" +
+                  wrapInMain(L"task<float> result = spawn divide(0);")),
+        ZeroDivisionError
+    );
+    // the tasks which were not joined are cancelled when the execution fails
+    REQUIRE_THROWS_AS(
+        interpret(L"func loop() -> int {\n"
+                  L"    while(true) {}\n"
+                  L"    return 0;\n"
+                  L"}\n"
+                  L"func divide(int a) -> float {\n"
+                  L"    return 1 / a;\n"
+                  L"}\n" +
+                  wrapInMain(L"task<int> endless = spawn loop();\n"
+                             L"float value = divide(0);\n")),
+        ZeroDivisionError
+    );
+    // the spawned calls count towards the stack of the spawning call, in which they may run
+    REQUIRE_THROWS_AS(
+        interpret(L"func deep(int n) -> int {\n"
+                  L"    return join(spawn deep(n + 1));\n"
+                  L"}\n" +
+                  wrapInMain(L"print(join(spawn deep(0)));")),
+        StackOverflowError
+    );
+    REQUIRE_THROWS_AS(
+        interpret(L"func f(int$ a) -> int { return a; }\n" + wrapInMain(L"int$ a = 2;\ntask<int> t = spawn f(a);")),
+        InvalidSpawnError
+    );
+    REQUIRE_THROWS_AS(
+        interpret(L"struct S { int a; }\n" + wrapInMain(L"task<S> t = spawn S(2);")), InvalidSpawnError
+    );
+    REQUIRE_THROWS_AS(interpret(L"func f() {}\n" + wrapInMain(L"task<int> t = spawn f();")), InvalidFunctionCallError);
+    REQUIRE_THROWS_AS(
+        interpret(L"func f() -> int { return 1; }\n" + wrapInMain(L"task<str> t = spawn f();")), InvalidCastError
+    );
+    REQUIRE_THROWS_AS(
+        interpret(L"func f() -> int { return 1; }\n" + wrapInMain(L"int a = join(f());")), InvalidFunctionCallError
+    );
+}
+
 TEST_CASE("builtin functions examples", "[Lexer+Parser+Interpreter]")
 {
     std::wstring argumentsExample = L"func main() {\n"
@@ -657,6 +657,133 @@ TEST_CASE("AssignmentStatement errors", "[Parser]")
     checkParseError<SyntaxError>(tokens); // missing semicolon
 }
 
+TEST_CASE("array types and assignments to array elements", "[Parser]")
+{
+    std::vector tokens = wrapInFunction({
+        Token(LSQUAREBRACE, {3, 1}),
+        Token(LSQUAREBRACE, {3, 2}),
+        Token(KW_INT, {3, 3}),
+        Token(RSQUAREBRACE, {3, 6}),
+        Token(RSQUAREBRACE, {3, 7}),
+        Token(DOLLAR_SIGN, {3, 9}),
+        Token(IDENTIFIER, {3, 10}, L"grid"),
+        Token(OP_ASSIGN, {3, 15}),
+        Token(LBRACE, {3, 17}),
+        Token(RBRACE, {3, 18}),
+        Token(SEMICOLON, {3, 19}),
+        Token(IDENTIFIER, {4, 1}, L"grid"),
+        Token(LSQUAREBRACE, {4, 5}),
+        Token(INT_LITERAL, {4, 6}, 0),
+        Token(RSQUAREBRACE, {4, 7}),
+        Token(OP_DOT, {4, 8}),
+        Token(IDENTIFIER, {4, 9}, L"field"),
+        Token(LSQUAREBRACE, {4, 14}),
+        Token(IDENTIFIER, {4, 15}, L"i"),
+        Token(RSQUAREBRACE, {4, 16}),
+        Token(OP_ASSIGN, {4, 18}),
+        Token(INT_LITERAL, {4, 20}, 2),
+        Token(SEMICOLON, {4, 21}),
+    });
+    checkParsing(
+        tokens, L"Program containing:\n"
+                L"Functions:\n"
+                L"`-a_function: FunctionDeclaration <line: 1, col: 1> source=<test>\n"
+                L" `-Body:\n"
+                L"  |-VariableDeclStatement <line: 3, col: 1>\n"
+                L"  ||-VariableDeclaration <line: 3, col: 1> type=[[int]] name=grid mutable=true\n"
+                L"  |`-StructExpression <line: 3, col: 17>\n"
+                L"  `-AssignmentStatement <line: 4, col: 1>\n"
+                L"   |-Assignable <line: 4, col: 1>\n"
+                L"   ||-Assignable <line: 4, col: 1> right=field\n"
+                L"   ||`-Assignable <line: 4, col: 1>\n"
+                L"   || |-Assignable <line: 4, col: 1> right=grid\n"
+                L"   || `-Literal <line: 4, col: 6> type=int value=0\n"
+                L"   |`-Variable <line: 4, col: 15> name=i\n"
+                L"   `-Literal <line: 4, col: 20> type=int value=2\n"
+    );
+}
+
+TEST_CASE("array types and assignments to array elements errors", "[Parser]")
+{
+    std::vector tokens = wrapInFunction({
+        Token(LSQUAREBRACE, {3, 1}),
+        Token(KW_INT, {3, 2}),
+        Token(IDENTIFIER, {3, 10}, L"array"),
+        Token(OP_ASSIGN, {3, 15}),
+        Token(LBRACE, {3, 17}),
+        Token(RBRACE, {3, 18}),
+        Token(SEMICOLON, {3, 19}),
+    });
+    checkParseError<SyntaxError>(tokens); // missing ]
+    tokens = wrapInFunction({
+        Token(LSQUAREBRACE, {3, 1}),
+        Token(RSQUAREBRACE, {3, 2}),
+        Token(IDENTIFIER, {3, 10}, L"array"),
+        Token(OP_ASSIGN, {3, 15}),
+        Token(LBRACE, {3, 17}),
+        Token(RBRACE, {3, 18}),
+        Token(SEMICOLON, {3, 19}),
+    });
+    checkParseError<SyntaxError>(tokens); // missing element type
+    tokens = wrapInFunction({
+        Token(IDENTIFIER, {4, 1}, L"array"),
+        Token(LSQUAREBRACE, {4, 5}),
+        Token(RSQUAREBRACE, {4, 7}),
+        Token(OP_ASSIGN, {4, 18}),
+        Token(INT_LITERAL, {4, 20}, 2),
+        Token(SEMICOLON, {4, 21}),
+    });
+    checkParseError<SyntaxError>(tokens); // missing index
+    tokens = wrapInFunction({
+        Token(IDENTIFIER, {4, 1}, L"array"),
+        Token(LSQUAREBRACE, {4, 5}),
+        Token(INT_LITERAL, {4, 6}, 0),
+        Token(OP_ASSIGN, {4, 18}),
+        Token(INT_LITERAL, {4, 20}, 2),
+        Token(SEMICOLON, {4, 21}),
+    });
+    checkParseError<SyntaxError>(tokens); // missing ] after index
+}
+
+TEST_CASE("dictionary types", "[Parser]")
+{
+    std::vector tokens = wrapInFunction({
+        Token(LSQUAREBRACE, {3, 1}),
+        Token(KW_STR, {3, 2}),
+        Token(ARROW, {3, 6}),
+        Token(LSQUAREBRACE, {3, 9}),
+        Token(KW_INT, {3, 10}),
+        Token(RSQUAREBRACE, {3, 13}),
+        Token(RSQUAREBRACE, {3, 14}),
+        Token(IDENTIFIER, {3, 16}, L"groups"),
+        Token(OP_ASSIGN, {3, 23}),
+        Token(LBRACE, {3, 25}),
+        Token(RBRACE, {3, 26}),
+        Token(SEMICOLON, {3, 27}),
+    });
+    checkParsing(
+        tokens, L"Program containing:\n"
+                L"Functions:\n"
+                L"`-a_function: FunctionDeclaration <line: 1, col: 1> source=<test>\n"
+                L" `-Body:\n"
+                L"  `-VariableDeclStatement <line: 3, col: 1>\n"
+                L"   |-VariableDeclaration <line: 3, col: 1> type=[str -> [int]] name=groups mutable=false\n"
+                L"   `-StructExpression <line: 3, col: 25>\n"
+    );
+    tokens = wrapInFunction({
+        Token(LSQUAREBRACE, {3, 1}),
+        Token(KW_STR, {3, 2}),
+        Token(ARROW, {3, 6}),
+        Token(RSQUAREBRACE, {3, 9}),
+        Token(IDENTIFIER, {3, 16}, L"groups"),
+        Token(OP_ASSIGN, {3, 23}),
+        Token(LBRACE, {3, 25}),
+        Token(RBRACE, {3, 26}),
+        Token(SEMICOLON, {3, 27}),
+    });
+    checkParseError<SyntaxError>(tokens); // missing value type
+}
+
 TEST_CASE("FunctionCall as an Instruction", "[Parser]")
 {
     std::vector tokens = wrapInFunction({
@@ -1480,11 +1607,6 @@ TEST_CASE("StructExpression", "[Parser]")
 TEST_CASE("StructExpression errors", "[Parser]")
 {
     std::vector tokens = wrapExpression({
-        Token(LBRACE, {4, 1}),
-        Token(RBRACE, {4, 3}),
-    });
-    checkParseError<SyntaxError>(tokens); // there needs to be at least 1 parameter
-    tokens = wrapExpression({
         Token(LBRACE, {5, 1}),
         Token(IDENTIFIER, {5, 2}, L"a"),
         Token(IDENTIFIER, {5, 4}, L"b"),
@@ -1668,3 +1790,58 @@ TEST_CASE("Literal", "[Parser]")
                 L"    `-Literal <line: 4, col: 17> type=bool value=false\n"
     );
 }
+
+TEST_CASE("REPL entry", "[Parser]")
+{
+    std::vector tokens = {
+        Token(KW_STRUCT, {1, 1}),
+        Token(IDENTIFIER, {1, 8}, L"S"),
+        Token(LBRACE, {1, 10}),
+        Token(KW_INT, {1, 12}),
+        Token(IDENTIFIER, {1, 16}, L"a"),
+        Token(SEMICOLON, {1, 17}),
+        Token(RBRACE, {1, 19}),
+        Token(IDENTIFIER, {2, 1}, L"print"),
+        Token(LPAREN, {2, 6}),
+        Token(STR_LITERAL, {2, 7}, L"a"),
+        Token(RPAREN, {2, 10}),
+        Token(SEMICOLON, {2, 11}),
+        Token(KW_FUNC, {3, 1}),
+        Token(IDENTIFIER, {3, 6}, L"f"),
+        Token(LPAREN, {3, 7}),
+        Token(RPAREN, {3, 8}),
+        Token(LBRACE, {3, 10}),
+        Token(RBRACE, {3, 11}),
+        Token(KW_BREAK, {4, 1}),
+        Token(SEMICOLON, {4, 6}),
+        Token(EOT, {4, 7}),
+    };
+    FakeLexer lexer(tokens);
+    Parser parser(lexer);
+    ReplEntry entry = parser.parseReplEntry();
+    std::wstringstream output;
+    PrintingVisitor printer(output);
+    entry.declarations.accept(printer);
+    for(auto &instruction: entry.instructions)
+        instruction->accept(printer);
+    REQUIRE(
+        output.str() == L"Program containing:\n"
+                        L"Structs:\n"
+                        L"`-S: StructDeclaration <line: 1, col: 1> source=<test>\n"
+                        L" `-Field <line: 1, col: 12> type=int name=a\n"
+                        L"Functions:\n"
+                        L"`-f: FunctionDeclaration <line: 3, col: 1> source=<test>\n"
+                        L"FunctionCallInstruction <line: 2, col: 1>\n"
+                        L"`-FunctionCall <line: 2, col: 1> functionName=print\n"
+                        L" `-Literal <line: 2, col: 7> type=str value=a\n"
+                        L"BreakStatement <line: 4, col: 1>\n"
+    );
+
+    std::vector invalid = {
+        Token(RBRACE, {1, 1}),
+        Token(EOT, {1, 2}),
+    };
+    FakeLexer invalidLexer(invalid);
+    Parser invalidParser(invalidLexer);
+    REQUIRE_THROWS_AS(invalidParser.parseReplEntry(), SyntaxError);
+}
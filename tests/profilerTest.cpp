@@ -0,0 +1,110 @@
+#include "profiler.hpp"
+
+#include "commentDiscarder.hpp"
+#include "interpreter.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "streamReader.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+
+using enum Type::Builtin;
+
+namespace {
+void interpretProfiled(const std::wstring &sourceCode, Profiler &profiler)
+{
+    std::wstringstream sourceStream(sourceCode);
+    StreamReader reader(sourceStream, L"<test>");
+    Lexer lexer(reader);
+    CommentDiscarder commentDiscarder(lexer);
+    Parser parser(commentDiscarder);
+    Program program = parser.parseProgram();
+    std::wstringstream inputStream, outputStream;
+    std::vector<std::wstring> sourceFiles = {L"<test>"};
+    Interpreter interpreter(
+        sourceFiles, {}, inputStream, outputStream,
+        [](const std::wstring &) -> Program { throw std::runtime_error("No files should be included in these tests"); },
+        Interpreter::DEFAULT_MAX_STACK_SIZE, &profiler
+    );
+    interpreter.visit(program);
+}
+
+const Profiler::FunctionProfile &findProfile(
+    const std::vector<Profiler::FunctionProfile> &profiles, const FunctionIdentification &id
+)
+{
+    auto found = std::find_if(profiles.begin(), profiles.end(), [&](const Profiler::FunctionProfile &profile) {
+        return profile.id == id;
+    });
+    REQUIRE(found != profiles.end());
+    return *found;
+}
+}
+
+TEST_CASE("profiling of user and builtin functions", "[Profiler]")
+{
+    Profiler profiler;
+    interpretProfiled(
+        L"func factorial(int n) -> int {\n"
+        L"    if(n <= 1) { return 1; }\n"
+        L"    return n * factorial(n - 1);\n"
+        L"}\n"
+        L"func main() {\n"
+        L"    println(factorial(5));\n"
+        L"    println(factorial(2));\n"
+        L"}\n",
+        profiler
+    );
+    std::vector<Profiler::FunctionProfile> profiles = profiler.getProfiles();
+    REQUIRE(profiles.size() == 3);
+    REQUIRE(std::is_sorted(profiles.begin(), profiles.end(), [](const auto &first, const auto &second) {
+        return first.exclusiveTime > second.exclusiveTime;
+    }));
+
+    const Profiler::FunctionProfile &main = findProfile(profiles, {L"main", {}});
+    const Profiler::FunctionProfile &factorial = findProfile(profiles, {L"factorial", {{INT}}});
+    const Profiler::FunctionProfile &println = findProfile(profiles, {L"println", {{STR}}});
+    REQUIRE(main.calls == 1);
+    REQUIRE(factorial.calls == 7);
+    REQUIRE(println.calls == 2);
+    for(const Profiler::FunctionProfile &profile: profiles)
+        REQUIRE(profile.inclusiveTime >= profile.exclusiveTime);
+    REQUIRE(main.inclusiveTime >= factorial.inclusiveTime + println.inclusiveTime);
+    REQUIRE(main.inclusiveTime == main.exclusiveTime + factorial.exclusiveTime + println.exclusiveTime);
+}
+
+TEST_CASE("profile is consistent after an exception", "[Profiler]")
+{
+    Profiler profiler;
+    REQUIRE_THROWS(interpretProfiled(
+        L"func f(int n) -> int { return 10 // n; }\n"
+        L"func main() { int a = f(1) + f(0); }\n",
+        profiler
+    ));
+    std::vector<Profiler::FunctionProfile> profiles = profiler.getProfiles();
+    REQUIRE(findProfile(profiles, {L"f", {{INT}}}).calls == 2);
+    REQUIRE(findProfile(profiles, {L"main", {}}).calls == 1);
+}
+
+TEST_CASE("profile report and JSON output", "[Profiler]")
+{
+    Profiler profiler;
+    FunctionIdentification id(L"f\"", {{INT}, {STR}});
+    profiler.enterFunction(id);
+    profiler.enterFunction(id);
+    profiler.exitFunction();
+    profiler.exitFunction();
+
+    std::wstringstream json;
+    profiler.writeJson(json);
+    std::wstring expectedStart = L"[\n  {\"function\": \"f\\\"(int, str)\", \"calls\": 2, \"inclusive_ns\": ";
+    REQUIRE(json.str().substr(0, expectedStart.size()) == expectedStart);
+    REQUIRE(json.str().ends_with(L"}\n]\n"));
+
+    std::wstringstream report;
+    profiler.printReport(report);
+    REQUIRE(report.str().starts_with(L"     calls   inclusive [ms]   exclusive [ms]  function\n         2 "));
+    REQUIRE(report.str().ends_with(L"  f\"(int, str)\n"));
+}
@@ -0,0 +1,164 @@
+#include "programServer.hpp"
+
+#include "appExceptions.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+#include <unistd.h>
+
+namespace {
+// Creates a directory for the source files of a test and removes it on destruction.
+class TemporaryDirectory
+{
+public:
+    TemporaryDirectory():
+        path(
+            std::filesystem::temp_directory_path() /
+            std::format(
+                "interProgramServerTest{}_{}", getpid(), std::chrono::steady_clock::now().time_since_epoch().count()
+            )
+        )
+    {
+        std::filesystem::create_directories(path);
+    }
+
+    ~TemporaryDirectory()
+    {
+        std::filesystem::remove_all(path);
+    }
+
+    // Writes the file with a modification time different from the previous one, whatever the filesystem's resolution.
+    void write(const std::string &fileName, const std::string &contents)
+    {
+        std::filesystem::path filePath = path / fileName;
+        std::optional<std::filesystem::file_time_type> previous;
+        if(std::filesystem::exists(filePath))
+            previous = std::filesystem::last_write_time(filePath);
+        std::ofstream(filePath) << contents;
+        if(previous)
+            std::filesystem::last_write_time(filePath, *previous + std::chrono::seconds(1));
+    }
+
+    std::filesystem::path path;
+};
+
+const std::string MAIN_FILE =
+    "include \"greeting\";\n"
+    "func main() {\n"
+    "    println(greeting() ! \" \" ! argument(0));\n"
+    "}\n";
+
+std::string greetingFile(const std::string &greeting)
+{
+    return "func greeting() -> str {\n    return \"" + greeting + "\";\n}\n";
+}
+}
+
+TEST_CASE("compiled programs are reused until their files change", "[ProgramCache]")
+{
+    TemporaryDirectory directory;
+    directory.write("main", MAIN_FILE);
+    directory.write("greeting", greetingFile("Hello"));
+    ProgramCache cache;
+
+    std::shared_ptr<const CompiledProgram> first = cache.get(directory.path, {L"main"});
+    REQUIRE(cache.getCompilations() == 1);
+    REQUIRE(cache.get(directory.path, {L"main"}) == first);
+    REQUIRE(cache.getCompilations() == 1);
+
+    // a file touched without changing its contents does not make the program compile again
+    directory.write("main", MAIN_FILE);
+    REQUIRE(cache.get(directory.path, {L"main"}) == first);
+    REQUIRE(cache.getCompilations() == 1);
+
+    // neither do the included files
+    directory.write("greeting", greetingFile("Hi"));
+    std::shared_ptr<const CompiledProgram> second = cache.get(directory.path, {L"main"});
+    REQUIRE(second != first);
+    REQUIRE(cache.getCompilations() == 2);
+    REQUIRE(cache.get(directory.path, {L"main"}) == second);
+    REQUIRE(cache.getCompilations() == 2);
+
+    std::filesystem::remove(directory.path / "greeting");
+    REQUIRE_THROWS_AS(cache.get(directory.path, {L"main"}), FileError);
+}
+
+TEST_CASE("programs executed by the server", "[ProgramServer]")
+{
+    TemporaryDirectory directory;
+    directory.write("main", MAIN_FILE);
+    directory.write("greeting", greetingFile("Hello"));
+    directory.write("echo", "func main() {\n    println(input());\n}\n");
+    directory.write("invalid", "func main() {\n    int a = \"a\";\n}\n");
+    std::string socketPath = (directory.path / "socket").string();
+    ProgramServer server(socketPath);
+    std::jthread serverThread([&] { server.run(); });
+    // stops the server before its thread is joined, also when a requirement fails
+    std::unique_ptr<ProgramServer, void (*)(ProgramServer *)> stopServer(&server, [](ProgramServer *server) {
+        server->stop();
+    });
+
+    std::stringstream output, errors;
+    REQUIRE(runOnServer(socketPath, directory.path, {L"main"}, {L"world"}, "", output, errors) == 0);
+    REQUIRE(runOnServer(socketPath, directory.path, {L"main"}, {L"again"}, "", output, errors) == 0);
+    REQUIRE(output.str() == "Hello world\nHello again\n");
+    REQUIRE(errors.str().empty());
+    REQUIRE(server.getCache().getCompilations() == 1);
+
+    output.str("");
+    REQUIRE(runOnServer(socketPath, directory.path, {L"echo"}, {}, "line of input\n", output, errors) == 0);
+    REQUIRE(output.str() == "line of input\n");
+
+    output.str("");
+    REQUIRE(runOnServer(socketPath, directory.path, {L"main"}, {}, "", output, errors) == 1);
+    REQUIRE(errors.str().starts_with("The program was terminated following a runtime error:\n"));
+
+    errors.str("");
+    REQUIRE(runOnServer(socketPath, directory.path, {L"invalid"}, {}, "", output, errors) == 1);
+    REQUIRE_FALSE(errors.str().empty());
+
+    errors.str("");
+    REQUIRE(runOnServer(socketPath, directory.path, {L"missing"}, {}, "", output, errors) == 1);
+    REQUIRE(
+        errors.str() == "The interpreter's command line interface encountered an error:\nFailed to open file missing\n"
+    );
+}
+
+TEST_CASE("the server does not remove files other than sockets", "[ProgramServer]")
+{
+    TemporaryDirectory directory;
+    directory.write("main", MAIN_FILE);
+    std::string socketPath = (directory.path / "main").string();
+    REQUIRE_THROWS_AS(ProgramServer(socketPath), SocketError);
+    REQUIRE(std::filesystem::is_regular_file(socketPath));
+}
+
+TEST_CASE("the server stops while a client is connected but silent", "[ProgramServer]")
+{
+    TemporaryDirectory directory;
+    directory.write("main", MAIN_FILE);
+    directory.write("greeting", greetingFile("Hello"));
+    std::string socketPath = (directory.path / "socket").string();
+    std::optional<Socket> silent;
+    {
+        ProgramServer server(socketPath);
+        std::jthread serverThread([&] { server.run(); });
+        std::unique_ptr<ProgramServer, void (*)(ProgramServer *)> stopServer(&server, [](ProgramServer *server) {
+            server->stop();
+        });
+        silent.emplace(Socket::connectTo(socketPath));
+        sendFrame(*silent, FrameType::WORKING_DIRECTORY, directory.path.string());
+        // the connections are accepted in order, so the silent one is being handled once this request is answered
+        std::stringstream output, errors;
+        REQUIRE(runOnServer(socketPath, directory.path, {L"main"}, {L"world"}, "", output, errors) == 0);
+    }
+    // the server has shut the connection down instead of waiting for the rest of the request
+    REQUIRE_FALSE(receiveFrame(*silent));
+}
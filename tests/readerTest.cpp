@@ -92,3 +92,29 @@ TEST_CASE("error in input stream", "[StreamReader]")
     stream.setstate(std::ios::badbit);
     REQUIRE_THROWS_AS(reader.next(), ReaderInputError);
 }
+
+TEST_CASE("skipping lines", "[StreamReader]")
+{
+    std::wstringstream stream;
+    // long enough for the line to cross the boundaries of the read blocks
+    std::wstring longLine(10000, L'x');
+    stream.str(L"abc ść\r\n" + longLine + L"\n\nlast");
+    StreamReader reader(stream, L"<test>");
+    reader.next();
+    REQUIRE(reader.skipLine() == 5);
+    checkChar(reader, L'\n', {1, 7});
+    REQUIRE(reader.skipLine() == 0);
+    nextAndCheck(reader, L'x', {2, 1});
+    REQUIRE(reader.skipLine() == longLine.size());
+    checkChar(reader, L'\n', {2, 10001});
+    nextAndCheck(reader, L'\n', {3, 1});
+    nextAndCheck(reader, L'l', {4, 1});
+    REQUIRE(reader.skipLine() == 4);
+    checkChar(reader, IReader::EOT, {4, 5});
+    REQUIRE(reader.skipLine() == 0);
+
+    std::wstringstream controlStream;
+    controlStream.str(L"ab\3\n");
+    StreamReader controlReader(controlStream, L"<test>");
+    REQUIRE_THROWS_AS(controlReader.skipLine(), ControlCharError);
+}
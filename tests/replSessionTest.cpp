@@ -0,0 +1,156 @@
+#include "replSession.hpp"
+
+#include "commentDiscarder.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "repl.hpp"
+#include "runtimeExceptions.hpp"
+#include "semanticExceptions.hpp"
+#include "streamReader.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+
+namespace {
+ReplEntry parseEntry(const std::wstring &text)
+{
+    std::wstringstream sourceStream(text);
+    StreamReader reader(sourceStream, L"<repl>");
+    Lexer lexer(reader);
+    CommentDiscarder commentDiscarder(lexer);
+    Parser parser(commentDiscarder);
+    return parser.parseReplEntry();
+}
+
+Program parseProgram(const std::wstring &sourceCode)
+{
+    std::wstringstream sourceStream(sourceCode);
+    StreamReader reader(sourceStream, L"<test>");
+    Lexer lexer(reader);
+    CommentDiscarder commentDiscarder(lexer);
+    Parser parser(commentDiscarder);
+    return parser.parseProgram();
+}
+
+class TestSession
+{
+public:
+    explicit TestSession(const std::wstring &prelude = L""):
+        session(
+            parseProgram(prelude), {L"<test>"},
+            [](const std::wstring &) -> Program {
+                throw std::runtime_error("No files should be included in these tests");
+            },
+            {}, input, output
+        )
+    {}
+
+    void enter(const std::wstring &text)
+    {
+        session.enter(parseEntry(text), L"<repl>");
+    }
+
+    unsigned getAnalyzedFunctions() const
+    {
+        return session.getAnalysis().getAnalyzedFunctions();
+    }
+
+    std::wstringstream input, output;
+    ReplSession session;
+};
+}
+
+TEST_CASE("declarations and variables persist between entries", "[ReplSession]")
+{
+    TestSession session;
+    session.enter(L"int$ x = 2;");
+    session.enter(L"func twice(int n) -> int {\n    return 2 * n;\n}");
+    session.enter(L"x = twice(x);\nprintln(str(x));");
+    session.enter(L"struct Point {\n    int x;\n    int y;\n}\nPoint p = {x, 3};\nprintln(str(p.x + p.y));");
+    REQUIRE(session.output.str() == L"4\n7\n");
+}
+
+TEST_CASE("only new declarations and callers of overloaded names are analyzed", "[ReplSession]")
+{
+    TestSession session(
+        L"func show(float f) -> str {\n"
+        L"    return \"float\";\n"
+        L"}\n"
+        L"func caller() -> str {\n"
+        L"    return show(1);\n"
+        L"}\n"
+        L"func other() -> int {\n"
+        L"    return 1;\n"
+        L"}\n"
+    );
+    unsigned analyzed = session.getAnalyzedFunctions();
+    session.enter(L"println(caller());");
+    REQUIRE(session.getAnalyzedFunctions() == analyzed);
+
+    session.enter(L"func unrelated() {}");
+    REQUIRE(session.getAnalyzedFunctions() == analyzed + 1);
+
+    // the call in caller resolves to the new overload, as if the whole program had been analyzed again
+    session.enter(L"func show(int i) -> str {\n    return \"int\";\n}");
+    REQUIRE(session.getAnalyzedFunctions() == analyzed + 3);
+    session.enter(L"println(caller());");
+    REQUIRE(session.output.str() == L"float\nint\n");
+}
+
+TEST_CASE("entries with semantic errors have no effect", "[ReplSession]")
+{
+    TestSession session(
+        L"func ambiguous(int a, float b) {\n"
+        L"    println(\"int, float\");\n"
+        L"}\n"
+        L"func caller() {\n"
+        L"    ambiguous(1, 1);\n"
+        L"}\n"
+    );
+    REQUIRE_THROWS_AS(session.enter(L"func ambiguous(float a, int b) {}"), AmbiguousFunctionCallError);
+    session.enter(L"caller();");
+
+    REQUIRE_THROWS_AS(session.enter(L"func f() {\n    int a = missing;\n}"), UnknownVariableError);
+    session.enter(L"func f() {}");
+    REQUIRE_THROWS_AS(session.enter(L"func f() {}"), DuplicateFunctionError);
+
+    REQUIRE_THROWS_AS(session.enter(L"func g() {}\nint w = 1;\nw = 2;"), ImmutableError);
+    session.enter(L"int w = 3;\nfunc g() {}");
+    REQUIRE(session.output.str() == L"int, float\n");
+}
+
+TEST_CASE("variables declared before a runtime error are forgotten", "[ReplSession]")
+{
+    TestSession session;
+    session.enter(L"int$ kept = 1;");
+    REQUIRE_THROWS_AS(session.enter(L"int y = 1;\nkept = 2;\nint z = y // 0;"), ZeroDivisionError);
+    session.enter(L"int y = 5;\nprintln(str(y + kept));");
+    REQUIRE(session.output.str() == L"7\n");
+}
+
+TEST_CASE("entries spanning many lines", "[Repl]")
+{
+    REQUIRE(isEntryComplete(L""));
+    REQUIRE(isEntryComplete(L"int a = 1;\n"));
+    REQUIRE_FALSE(isEntryComplete(L"func f() -> int\n"));
+    REQUIRE_FALSE(isEntryComplete(L"func f() -> int {\n    return 1;\n"));
+    REQUIRE(isEntryComplete(L"func f() -> int {\n    return 1;\n}\n"));
+    REQUIRE_FALSE(isEntryComplete(L"println(\"a\" !\n"));
+    REQUIRE(isEntryComplete(L"println(\"unterminated);\n"));
+}
+
+TEST_CASE("REPL reading entries", "[Repl]")
+{
+    std::wstringstream input(L"func f(int a) -> int {\n    return a + 1;\n}\nprintln(str(f(1)));\nprintln(unknown);\n");
+    std::wstringstream output;
+    std::stringstream errors;
+    ReplSession session(
+        Program({1, 1}), {},
+        [](const std::wstring &) -> Program { throw std::runtime_error("No files should be included in these tests"); },
+        {}, input, output
+    );
+    runRepl(session, input, output, errors);
+    REQUIRE(output.str() == L">>> ... ... >>> 2\n>>> >>> \n");
+    REQUIRE(errors.str().starts_with("Error: Unknown variable: unknown\n"));
+}
@@ -0,0 +1,98 @@
+#include "samplingProfiler.hpp"
+
+#include "commentDiscarder.hpp"
+#include "interpreter.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "streamReader.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <thread>
+
+using enum Type::Builtin;
+
+namespace {
+void interpretSampled(const std::wstring &sourceCode, SamplingProfiler &sampler)
+{
+    std::wstringstream sourceStream(sourceCode);
+    StreamReader reader(sourceStream, L"<test>");
+    Lexer lexer(reader);
+    CommentDiscarder commentDiscarder(lexer);
+    Parser parser(commentDiscarder);
+    Program program = parser.parseProgram();
+    std::wstringstream inputStream, outputStream;
+    std::vector<std::wstring> sourceFiles = {L"<test>"};
+    Interpreter interpreter(
+        sourceFiles, {}, inputStream, outputStream,
+        [](const std::wstring &) -> Program { throw std::runtime_error("No files should be included in these tests"); },
+        Interpreter::DEFAULT_MAX_STACK_SIZE, nullptr, &sampler
+    );
+    interpreter.visit(program);
+}
+
+std::vector<std::wstring> getLines(const std::wstring &text)
+{
+    std::vector<std::wstring> lines;
+    std::wstringstream stream(text);
+    std::wstring line;
+    while(std::getline(stream, line))
+        lines.push_back(line);
+    return lines;
+}
+}
+
+TEST_CASE("folded stacks of sampled functions", "[SamplingProfiler]")
+{
+    SamplingProfiler sampler(10000);
+    FunctionDeclaration outer({1, 1}, L"<outer>", {}, {}, {});
+    FunctionDeclaration inner({1, 1}, L"<inner>", {}, {}, {});
+    FunctionIdentification outerId(L"outer", {});
+    FunctionIdentification innerId(L"inner", {{INT}});
+    sampler.enterFunction(outerId, outer, {1, 1});
+    sampler.enterFunction(innerId, inner, {3, 5});
+    std::wstringstream folded;
+    auto end = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while(folded.str().empty() && std::chrono::steady_clock::now() < end)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        sampler.takePendingSamples();
+        sampler.writeFoldedStacks(folded);
+    }
+    sampler.exitFunction();
+    sampler.exitFunction();
+
+    std::vector<std::wstring> lines = getLines(folded.str());
+    REQUIRE(lines.size() == 1);
+    REQUIRE(lines[0].starts_with(L"outer;inner(int) (<outer>:3:5) "));
+    REQUIRE(std::stoul(lines[0].substr(lines[0].rfind(L' ') + 1)) > 0);
+}
+
+TEST_CASE("sampling of an interpreted program", "[SamplingProfiler]")
+{
+    SamplingProfiler sampler(100000);
+    interpretSampled(
+        L"func square(int n) -> int {\n"
+        L"    return n * n;\n"
+        L"}\n"
+        L"func main() {\n"
+        L"    int$ i = 0;\n"
+        L"    while(i < 20000) {\n"
+        L"        int squared = square(i);\n"
+        L"        i = i + 1;\n"
+        L"    }\n"
+        L"}\n",
+        sampler
+    );
+    std::wstringstream folded;
+    sampler.writeFoldedStacks(folded);
+    std::vector<std::wstring> lines = getLines(folded.str());
+    REQUIRE_FALSE(lines.empty());
+    for(const std::wstring &line: lines)
+    {
+        bool knownStack = line.starts_with(L"main ") || line.starts_with(L"main;square(int) (<test>:7:23) ");
+        REQUIRE(knownStack);
+        REQUIRE(std::stoul(line.substr(line.rfind(L' ') + 1)) > 0);
+    }
+}
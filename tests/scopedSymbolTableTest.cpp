@@ -0,0 +1,45 @@
+#include "scopedSymbolTable.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("names are resolved in the innermost scope declaring them", "[ScopedSymbolTable]")
+{
+    ScopedSymbolTable<int> table;
+    table.reset({{L"a", 1}, {L"b", 2}});
+    table.enterScope();
+    table.declare(L"a", 3);
+    table.declare(L"c", 4);
+    table.enterScope();
+    table.declare(L"a", 5);
+    REQUIRE(*table.find(L"a") == 5);
+    REQUIRE(*table.find(L"b") == 2);
+    REQUIRE(*table.find(L"c") == 4);
+    REQUIRE(table.find(L"d") == nullptr);
+
+    table.exitScope();
+    REQUIRE(*table.find(L"a") == 3);
+    REQUIRE(*table.find(L"c") == 4);
+
+    table.exitScope();
+    REQUIRE(*table.find(L"a") == 1);
+    REQUIRE(table.find(L"c") == nullptr);
+}
+
+TEST_CASE("declarations in the outermost scope are kept", "[ScopedSymbolTable]")
+{
+    ScopedSymbolTable<int> table;
+    table.reset();
+    table.declare(L"a", 1);
+    table.enterScope();
+    table.declare(L"b", 2);
+    table.exitScope();
+    table.declare(L"a", 3);
+    REQUIRE(table.getVisible() == std::unordered_map<std::wstring, int>{{L"a", 3}});
+
+    // reset discards the scopes that were not exited
+    table.enterScope();
+    table.declare(L"b", 4);
+    table.reset({{L"c", 5}});
+    table.declare(L"d", 6);
+    REQUIRE(table.getVisible() == std::unordered_map<std::wstring, int>{{L"c", 5}, {L"d", 6}});
+}
@@ -0,0 +1,106 @@
+#include "stringKernels.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+namespace {
+const StringKernels &scalar = StringKernels::get(StringKernels::Level::SCALAR);
+
+// Sizes around the vector widths check the handling of the remainders of blocks.
+std::string generateText(size_t size)
+{
+    const std::string alphabet = "ab ść ඞ读\n";
+    std::string text;
+    while(text.size() < size)
+        text += alphabet;
+    return text.substr(0, size);
+}
+}
+
+TEST_CASE("levels", "[StringKernels]")
+{
+    std::vector<StringKernels::Level> levels = StringKernels::getSupportedLevels();
+    REQUIRE(levels.front() == StringKernels::Level::SCALAR);
+    REQUIRE(StringKernels::get().level == levels.back());
+    for(StringKernels::Level level: levels)
+        REQUIRE(StringKernels::get(level).level == level);
+}
+
+TEST_CASE("finding non printable ASCII", "[StringKernels]")
+{
+    for(StringKernels::Level level: StringKernels::getSupportedLevels())
+    {
+        const StringKernels &kernels = StringKernels::get(level);
+        for(size_t size = 0; size < 70; size++)
+        {
+            std::wstring text(size, L'a');
+            REQUIRE(kernels.findNonPrintableAscii(text.data(), size) == size);
+            for(wchar_t unusual: {L'\x1F', L'\x7F', L'\n', L'ś', static_cast<wchar_t>(-1)})
+            {
+                for(size_t position = 0; position < size; position++)
+                {
+                    text[position] = unusual;
+                    REQUIRE(kernels.findNonPrintableAscii(text.data(), size) == position);
+                    REQUIRE(scalar.findNonPrintableAscii(text.data(), size) == position);
+                    text[position] = L'~';
+                    REQUIRE(kernels.findNonPrintableAscii(text.data(), size) == size);
+                    text[position] = L'a';
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("counting code points", "[StringKernels]")
+{
+    std::string text = "ab ść ඞ读";
+    REQUIRE(scalar.countCodePoints(text.data(), text.size()) == 8);
+    for(StringKernels::Level level: StringKernels::getSupportedLevels())
+    {
+        for(size_t size = 0; size < 200; size++)
+        {
+            std::string text = generateText(size);
+            REQUIRE(
+                StringKernels::get(level).countCodePoints(text.data(), size) ==
+                scalar.countCodePoints(text.data(), size)
+            );
+        }
+    }
+}
+
+TEST_CASE("finding mismatches", "[StringKernels]")
+{
+    for(StringKernels::Level level: StringKernels::getSupportedLevels())
+    {
+        const StringKernels &kernels = StringKernels::get(level);
+        for(size_t size = 0; size < 70; size++)
+        {
+            std::string first = generateText(size);
+            std::string second = first;
+            REQUIRE(kernels.findMismatch(first.data(), second.data(), size) == size);
+            for(size_t position = 0; position < size; position++)
+            {
+                second[position] = '#';
+                REQUIRE(kernels.findMismatch(first.data(), second.data(), size) == position);
+                second[position] = first[position];
+            }
+        }
+    }
+}
+
+TEST_CASE("filling with repeated pattern", "[StringKernels]")
+{
+    for(size_t times = 0; times < 20; times++)
+    {
+        std::string expected;
+        for(size_t i = 0; i < times; i++)
+            expected += "abć";
+        std::string result(expected.size(), '\0');
+        fillRepeated(result.data(), "abć", times);
+        REQUIRE(result == expected);
+    }
+    std::string result(3, '\0');
+    fillRepeated(result.data(), "", 5);
+    REQUIRE(result == std::string(3, '\0'));
+}
@@ -0,0 +1,67 @@
+#include "tokenBatch.hpp"
+
+#include "commentDiscarder.hpp"
+#include "fakeLexer.hpp"
+#include "lexer.hpp"
+#include "streamReader.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+
+using enum TokenType;
+
+TEST_CASE("tokens are converted to and from batches", "[TokenBatch]")
+{
+    std::array tokens = {
+        Token(IDENTIFIER, {1, 1}, L"iden"), Token(STR_LITERAL, {1, 6}, L"text"), Token(INT_LITERAL, {1, 13}, 42),
+        Token(FLOAT_LITERAL, {1, 16}, 2.5), Token(COMMENT, {1, 20}, L" comment"), Token(EOT, {2, 1}),
+    };
+    FakeLexer lexer(tokens);
+    TokenBatch batch;
+    lexer.readTokens(batch);
+    REQUIRE(batch.size() == tokens.size());
+    REQUIRE(batch.isComplete());
+    BatchedToken identifier = batch[0];
+    for(unsigned i = 0; i < tokens.size(); i++)
+    {
+        REQUIRE(batch[i].toToken() == tokens[i]);
+        REQUIRE(batch[i].getValue() == tokens[i].getValue());
+    }
+    REQUIRE(batch[1].getText() == L"text");
+    REQUIRE(std::format(L"{}", batch[0]) == L"iden");
+
+    // texts of the removed tokens are kept
+    batch.clearTokens();
+    batch.append(IDENTIFIER, {3, 1}, std::wstring(L"other"));
+    REQUIRE(identifier.getText() == L"iden");
+    REQUIRE(batch[0].getText() == L"other");
+    REQUIRE_FALSE(batch.isComplete());
+
+    // copies appended to another batch do not refer to the source batch
+    TokenBatch copies;
+    copies.append(identifier);
+    copies.append(batch[0]);
+    batch.clear();
+    REQUIRE(copies[0].toToken() == tokens[0]);
+    REQUIRE(copies[1].getText() == L"other");
+}
+
+TEST_CASE("batches end when full or after EOT", "[TokenBatch]")
+{
+    std::wstringstream source;
+    for(unsigned i = 0; i < TokenBatch::CAPACITY; i++)
+        source << L"a" << i << L" # comment\n";
+    StreamReader reader(source, L"<test>");
+    Lexer lexer(reader);
+    CommentDiscarder commentDiscarder(lexer);
+    TokenBatch batch;
+    commentDiscarder.readTokens(batch);
+    REQUIRE(batch.size() == TokenBatch::CAPACITY);
+    for(unsigned i = 0; i < batch.size(); i++)
+        REQUIRE(batch[i].toToken() == Token(IDENTIFIER, {i + 1, 1}, std::format(L"a{}", i)));
+    batch.clear();
+    commentDiscarder.readTokens(batch);
+    REQUIRE(batch.size() == 1);
+    REQUIRE(batch[0].toToken() == Token(EOT, {TokenBatch::CAPACITY + 1, 1}));
+}
@@ -0,0 +1,22 @@
+#include "tokenBuffer.hpp"
+
+#include "fakeLexer.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+using enum TokenType;
+
+TEST_CASE("tokens are read ahead and returned in order", "[TokenBuffer]")
+{
+    std::array tokens = {
+        Token(KW_INT, {1, 1}), Token(IDENTIFIER, {1, 5}, L"iden"), Token(SEMICOLON, {1, 9}), Token(EOT, {2, 1}),
+        Token(IDENTIFIER, {3, 1}, L"after"),
+    };
+    FakeLexer lexer(tokens);
+    TokenBuffer buffer(lexer);
+    REQUIRE(lexer.getNextToken() == tokens[4]);
+    REQUIRE(buffer.getSourceName() == L"<test>");
+    for(unsigned i = 0; i < 4; i++)
+        REQUIRE(buffer.getNextToken() == tokens[i]);
+    REQUIRE(buffer.getNextToken() == tokens[3]);
+    REQUIRE(buffer.getNextToken() == tokens[3]);
+}
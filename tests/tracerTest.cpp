@@ -0,0 +1,99 @@
+#include "tracer.hpp"
+
+#include "commentDiscarder.hpp"
+#include "interpreter.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "streamReader.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+Program parseFromString(const std::wstring &sourceCode, const std::wstring &sourceName)
+{
+    std::wstringstream sourceStream(sourceCode);
+    StreamReader reader(sourceStream, sourceName);
+    Lexer lexer(reader);
+    CommentDiscarder commentDiscarder(lexer);
+    Parser parser(commentDiscarder);
+    return parser.parseProgram();
+}
+
+void checkEvent(const Tracer::Event &event, const std::wstring &name, std::optional<std::wstring> file)
+{
+    REQUIRE(event.name == name);
+    REQUIRE(event.file == file);
+}
+
+bool contains(const Tracer::Event &outer, const Tracer::Event &inner)
+{
+    return outer.start <= inner.start && inner.start + inner.duration <= outer.start + outer.duration;
+}
+}
+
+TEST_CASE("nested spans", "[Tracer]")
+{
+    Tracer tracer;
+    {
+        Tracer::Span outer(&tracer, L"outer");
+        Tracer::Span inner(&tracer, L"inner", L"file.txt");
+    }
+    Tracer::Span(nullptr, L"ignored");
+
+    const std::vector<Tracer::Event> &events = tracer.getEvents();
+    REQUIRE(events.size() == 2);
+    checkEvent(events[0], L"outer", std::nullopt);
+    checkEvent(events[1], L"inner", L"file.txt");
+    REQUIRE(contains(events[0], events[1]));
+}
+
+TEST_CASE("Chrome trace event output", "[Tracer]")
+{
+    Tracer tracer;
+    {
+        Tracer::Span span(&tracer, L"read");
+    }
+    {
+        Tracer::Span span(&tracer, L"parse", L"dir\\\"file\".txt");
+    }
+    std::wstringstream json;
+    tracer.writeJson(json);
+    std::wstring output = json.str();
+    REQUIRE(output.starts_with(
+        L"{\"traceEvents\": [\n  {\"name\": \"read\", \"cat\": \"pipeline\", \"ph\": \"X\", \"ts\": "
+    ));
+    REQUIRE(output.find(L"\"pid\": 1, \"tid\": 1},\n  {\"name\": \"parse\"") != std::wstring::npos);
+    REQUIRE(output.ends_with(
+        L"\"pid\": 1, \"tid\": 1, \"args\": {\"file\": \"dir\\\\\\\"file\\\".txt\"}}\n], \"displayTimeUnit\": \"ms\"}\n"
+    ));
+}
+
+TEST_CASE("phases of the interpreter", "[Tracer]")
+{
+    Tracer tracer;
+    Program program = parseFromString(
+        L"include \"included.txt\";\n"
+        L"func main() {\n"
+        L"    f();\n"
+        L"}\n",
+        L"<test>"
+    );
+    std::wstringstream inputStream, outputStream;
+    std::vector<std::wstring> sourceFiles = {L"<test>"};
+    Interpreter interpreter(
+        sourceFiles, {}, inputStream, outputStream,
+        [](const std::wstring &fileName) { return parseFromString(L"func f() {}", fileName); },
+        Interpreter::DEFAULT_MAX_STACK_SIZE, nullptr, nullptr, &tracer
+    );
+    interpreter.visit(program);
+
+    const std::vector<Tracer::Event> &events = tracer.getEvents();
+    REQUIRE(events.size() == 4);
+    checkEvent(events[0], L"includes", std::nullopt);
+    checkEvent(events[1], L"include", L"included.txt");
+    checkEvent(events[2], L"semantic analysis", std::nullopt);
+    checkEvent(events[3], L"execution", std::nullopt);
+    REQUIRE(contains(events[0], events[1]));
+    REQUIRE(events[2].start >= events[0].start + events[0].duration);
+    REQUIRE(events[3].start >= events[2].start + events[2].duration);
+}
@@ -0,0 +1,68 @@
+#include "utf8String.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+
+TEST_CASE("strings are encoded and decoded", "[Utf8String]")
+{
+    Utf8String ascii(L"ascii text");
+    REQUIRE(ascii.isAscii());
+    REQUIRE(ascii.size() == 10);
+    REQUIRE(ascii.getBytes() == "ascii text");
+    REQUIRE(ascii.toWstring() == L"ascii text");
+
+    Utf8String mixed(L"zażółć €\U0001F600");
+    REQUIRE_FALSE(mixed.isAscii());
+    REQUIRE(mixed.size() == 9);
+    REQUIRE(mixed.getBytes() == "za\xC5\xBC\xC3\xB3\xC5\x82\xC4\x87 \xE2\x82\xAC\xF0\x9F\x98\x80");
+    REQUIRE(mixed.toWstring() == L"zażółć €\U0001F600");
+    REQUIRE(Utf8String::fromUtf8(mixed.getBytes()) == mixed);
+    REQUIRE(Utf8String::fromUtf8(mixed.getBytes()).size() == 9);
+
+    std::wstringstream out;
+    out << mixed << ascii;
+    REQUIRE(out.str() == L"zażółć €\U0001F600ascii text");
+}
+
+TEST_CASE("code points are indexed", "[Utf8String]")
+{
+    std::wstring wide;
+    for(unsigned i = 0; i < 300; i++)
+        wide += i % 3 == 0 ? L'ą' : static_cast<wchar_t>(L'a' + i % 26);
+    Utf8String string(wide);
+    REQUIRE(string.size() == 300);
+    for(size_t i = 0; i < 300; i++)
+        REQUIRE(string.at(i).toWstring() == std::wstring(1, wide[i]));
+    REQUIRE(string.substr(60, 70).toWstring() == wide.substr(60, 70));
+    REQUIRE(string.substr(290, 70).toWstring() == wide.substr(290));
+    REQUIRE(string.substr(300, 1).size() == 0);
+    REQUIRE(string.find(Utf8String(wide.substr(200, 5))) == wide.find(wide.substr(200, 5)));
+    REQUIRE(string.find(Utf8String(L"#")) == Utf8String::npos);
+    REQUIRE(string.startsWith(Utf8String(L"ąb")));
+    REQUIRE(string.getHeapSize() > string.getBytes().size());
+
+    string += Utf8String(L"€");
+    REQUIRE(string.size() == 301);
+    REQUIRE(string.at(300).toWstring() == L"€");
+}
+
+TEST_CASE("strings are split, trimmed, repeated and compared", "[Utf8String]")
+{
+    std::vector<Utf8String> parts = Utf8String(L"ą, b,, ć, ").split(Utf8String(L", "));
+    REQUIRE(parts == std::vector<Utf8String>{L"ą", L"b,", L"ć", L""});
+    REQUIRE(parts[2].size() == 1);
+    REQUIRE(Utf8String(L"").split(Utf8String(L",")) == std::vector<Utf8String>{L""});
+
+    REQUIRE(Utf8String(L" \t żółw \n").trim() == Utf8String(L"żółw"));
+    REQUIRE(Utf8String(L"   ").trim() == Utf8String(L""));
+
+    Utf8String repeated = Utf8String(L"ab€").repeat(3);
+    REQUIRE(repeated == Utf8String(L"ab€ab€ab€"));
+    REQUIRE(repeated.size() == 9);
+    REQUIRE((Utf8String(L"ą") + Utf8String(L"b")).size() == 2);
+
+    REQUIRE(Utf8String(L"a") < Utf8String(L"b"));
+    REQUIRE(Utf8String(L"z") < Utf8String(L"ą"));
+    REQUIRE(Utf8String(L"￿") < Utf8String(L"\U00010000"));
+}
@@ -0,0 +1,118 @@
+#include "workStealingPool.hpp"
+
+#include "spawnedTask.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+using enum Type::Builtin;
+
+TEST_CASE("all submitted jobs are run", "[WorkStealingPool]")
+{
+    std::atomic<int> sum = 0;
+    {
+        WorkStealingPool pool(4);
+        REQUIRE(pool.getThreads() == 4);
+        for(int i = 1; i <= 1000; i++)
+            pool.submit([&sum, i]() { sum += i; });
+    }
+    REQUIRE(sum == 500500);
+}
+
+TEST_CASE("jobs waiting for nested jobs do not block the pool", "[WorkStealingPool]")
+{
+    // every worker waits for its nested jobs, which can only finish if the waiting threads run them
+    WorkStealingPool pool(2);
+    std::atomic<int> finishedOuter = 0;
+    for(int i = 0; i < 8; i++)
+    {
+        pool.submit([&pool, &finishedOuter]() {
+            std::atomic<int> finishedInner = 0;
+            for(int j = 0; j < 8; j++)
+                pool.submit([&finishedInner]() { finishedInner++; });
+            while(finishedInner < 8)
+            {
+                if(!pool.runPendingJob())
+                    std::this_thread::yield();
+            }
+            finishedOuter++;
+        });
+    }
+    while(finishedOuter < 8)
+    {
+        if(!pool.runPendingJob())
+            std::this_thread::yield();
+    }
+    REQUIRE(finishedOuter == 8);
+}
+
+TEST_CASE("SpawnedTask results and output", "[WorkStealingPool]")
+{
+    WorkStealingPool pool(2);
+    auto task = SpawnedTask::spawn(pool, [](std::wostream &output, const std::shared_ptr<SpawnedTask> &) {
+        output << L"computing";
+        return Object{{INT}, int32_t(42)};
+    });
+    std::wstringstream output;
+    REQUIRE(std::get<int32_t>(task->join(output).value) == 42);
+    REQUIRE(task->isJoined());
+    REQUIRE(std::get<int32_t>(task->join(output).value) == 42);
+    REQUIRE(output.str() == L"computing");
+
+    auto failing = SpawnedTask::spawn(pool, [](std::wostream &output, const std::shared_ptr<SpawnedTask> &) -> Object {
+        output << L"failing";
+        throw std::runtime_error("failed");
+    });
+    failing->wait();
+    REQUIRE_FALSE(failing->isJoined());
+    REQUIRE_THROWS_AS(failing->join(output), std::runtime_error);
+    REQUIRE_THROWS_AS(failing->join(output), std::runtime_error);
+    REQUIRE(output.str() == L"computingfailing");
+}
+
+TEST_CASE("SpawnedTask is run by the waiting thread", "[WorkStealingPool]")
+{
+    WorkStealingPool pool(1);
+    std::atomic<bool> released = false;
+    pool.submit([&]() {
+        while(!released)
+            std::this_thread::yield();
+    });
+    std::thread::id waitingThread = std::this_thread::get_id();
+    auto task = SpawnedTask::spawn(pool, [&](std::wostream &, const std::shared_ptr<SpawnedTask> &) {
+        return Object{{BOOL}, std::this_thread::get_id() == waitingThread};
+    });
+    std::wstringstream output;
+    REQUIRE(std::get<bool>(task->join(output).value));
+    released = true;
+}
+
+TEST_CASE("SpawnedTask cancellation", "[WorkStealingPool]")
+{
+    WorkStealingPool pool(2);
+    auto waitForCancellation = [](std::wostream &, const std::shared_ptr<SpawnedTask> &task) {
+        while(!task->isCancelled())
+            std::this_thread::yield();
+        return Object{{INT}, int32_t(1)};
+    };
+    std::shared_ptr<SpawnedTask> nested;
+    std::atomic<bool> nestedSpawned = false;
+    auto task = SpawnedTask::spawn(pool, [&](std::wostream &output, const std::shared_ptr<SpawnedTask> &task) {
+        nested = SpawnedTask::spawn(pool, waitForCancellation, task);
+        nestedSpawned = true;
+        return waitForCancellation(output, task);
+    });
+    while(!nestedSpawned)
+        std::this_thread::yield();
+    REQUIRE_FALSE(nested->isCancelled());
+    // cancelling a task also cancels the tasks it spawned
+    task->cancel();
+    std::wstringstream output;
+    REQUIRE(std::get<int32_t>(task->join(output).value) == 1);
+    REQUIRE(nested->isCancelled());
+    REQUIRE(std::get<int32_t>(nested->join(output).value) == 1);
+}